@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <filesystem>
 
 #include <components/log/log.hpp>
@@ -15,17 +16,36 @@ namespace configuration {
         std::filesystem::path path {std::filesystem::current_path() / "wal"};
         bool on {true};
         bool sync_to_disk {true};
+        bool group_commit {false};
+        std::chrono::microseconds group_commit_window {0};
+        std::size_t group_commit_max_bytes {1 << 20};
+        std::size_t max_segment_size {64 << 20};
+        bool archive_segments {false};
+        std::size_t index_interval {128};
+        std::size_t replay_chunk_bytes {4 << 20};
     };
 
     struct config_disk final {
         std::filesystem::path path {std::filesystem::current_path() / "disk"};
         bool on {true};
+        bool rocksdb_wal {true};
+        std::size_t agents {1};
+        std::size_t load_threads {0};
+    };
+
+    // 0 threads means detected from the hardware concurrency
+    struct config_scheduler final {
+        std::size_t dispatcher_threads {1};
+        std::size_t query_threads {0};
+        std::size_t storage_threads {0};
+        std::size_t max_throughput {1000};
     };
 
     struct config final {
         config_log log;
         config_wal wal;
         config_disk disk;
+        config_scheduler scheduler;
 
         static config default_config() {
             return config();
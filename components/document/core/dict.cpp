@@ -11,7 +11,7 @@ namespace document::impl {
 
         struct key_hash {
             size_t operator()(const dict_t::key_t& key) const {
-                return std::hash<std::string_view>{}(key.string());
+                return key.hash();
             }
         };
 
@@ -129,10 +129,12 @@ namespace document::impl {
     using namespace internal;
 
     dict_t::key_t::key_t(std::string_view raw_str)
-        : raw_str_({raw_str.data(), raw_str.size()}) {}
+        : raw_str_({raw_str.data(), raw_str.size()})
+        , hash_(std::hash<std::string_view>{}(raw_str)) {}
 
     dict_t::key_t::key_t(const std::string& raw_str)
-        : raw_str_(raw_str) {}
+        : raw_str_(raw_str)
+        , hash_(std::hash<std::string_view>{}(raw_str_)) {}
 
     dict_t::key_t::~key_t() = default;
 
@@ -140,6 +142,10 @@ namespace document::impl {
         return {raw_str_.data(), raw_str_.size()};
     }
 
+    std::size_t dict_t::key_t::hash() const noexcept {
+        return hash_;
+    }
+
     int dict_t::key_t::compare(const key_t& k) const noexcept {
         return raw_str_.compare(k.raw_str_);
     }
@@ -223,7 +229,7 @@ namespace document::impl {
         return heap_dict(this)->empty();
     }
 
-    const value_t* dict_t::get(key_t& key) const noexcept {
+    const value_t* dict_t::get(const key_t& key) const noexcept {
         return heap_dict(this)->get(key);
     }
 
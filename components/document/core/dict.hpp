@@ -15,10 +15,13 @@ namespace document::impl {
             explicit key_t(const std::string&);
             ~key_t();
             std::string_view string() const noexcept;
+            std::size_t hash() const noexcept;
             int compare(const key_t& k) const noexcept;
 
         private:
             std::string const raw_str_;
+            // computed once, a key built ahead of the lookups is not hashed again by them
+            std::size_t const hash_;
         };
 
         class iterator {
@@ -51,7 +54,7 @@ namespace document::impl {
         uint32_t count() const noexcept PURE;
         bool empty() const noexcept PURE;
 
-        const value_t* get(key_t& key) const noexcept;
+        const value_t* get(const key_t& key) const noexcept;
         const value_t* get(std::string_view key) const noexcept PURE;
 
         bool is_equals(const dict_t* NONNULL) const noexcept PURE;
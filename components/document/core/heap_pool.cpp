@@ -0,0 +1,115 @@
+#include "heap_pool.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <new>
+
+namespace document::impl {
+
+    namespace {
+
+        thread_local heap_pool_t* current_pool = nullptr;
+
+        constexpr std::size_t block_alignment = 16;
+        constexpr std::size_t pooled_offset = 8;
+
+        static_assert(__STDCPP_DEFAULT_NEW_ALIGNMENT__ >= block_alignment, "the global heap must hand out 16-byte aligned blocks");
+
+    } // namespace
+
+    struct heap_pool_t::page_t {
+        // values drawn from the page and not released yet, and one more while the pool draws from it
+        std::atomic<std::size_t> count{1};
+    };
+
+    static_assert(sizeof(std::atomic<std::size_t>) <= pooled_offset, "the page header must fit ahead of its first value");
+
+    namespace {
+
+        void free_page(void* page) noexcept {
+            ::operator delete(page, std::align_val_t(heap_pool_t::page_size));
+        }
+
+    } // namespace
+
+    heap_pool_t::ptr heap_pool_t::make() {
+        return std::make_unique<heap_pool_t>();
+    }
+
+    heap_pool_t* heap_pool_t::local() noexcept {
+        thread_local heap_pool_t pool;
+        return &pool;
+    }
+
+    heap_pool_t::~heap_pool_t() {
+        retire_();
+    }
+
+    void* heap_pool_t::allocate(std::size_t size) {
+        if (size > max_size) {
+            return nullptr;
+        }
+        auto step = (size + block_alignment - 1) & ~(block_alignment - 1);
+        if (std::size_t(end_ - next_) < step) {
+            retire_();
+            auto* memory = static_cast<char*>(::operator new(page_size, std::align_val_t(page_size)));
+            page_ = new (memory) page_t();
+            next_ = memory + pooled_offset;
+            end_ = memory + page_size;
+            ++page_count_;
+        }
+        auto* p = next_;
+        next_ += step;
+        page_->count.fetch_add(1, std::memory_order_relaxed);
+        ++allocation_count_;
+        return p;
+    }
+
+    bool heap_pool_t::is_pooled(const void* p) noexcept {
+        return (reinterpret_cast<std::uintptr_t>(p) & (block_alignment - 1)) == pooled_offset;
+    }
+
+    void heap_pool_t::deallocate(void* p) noexcept {
+        assert(is_pooled(p));
+        auto* page = reinterpret_cast<page_t*>(reinterpret_cast<std::uintptr_t>(p) & ~(page_size - 1));
+        if (page->count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            page->~page_t();
+            free_page(page);
+        }
+    }
+
+    std::size_t heap_pool_t::allocation_count() const noexcept {
+        return allocation_count_;
+    }
+
+    std::size_t heap_pool_t::page_count() const noexcept {
+        return page_count_;
+    }
+
+    void heap_pool_t::retire_() noexcept {
+        if (!page_) {
+            return;
+        }
+        if (page_->count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            page_->~page_t();
+            free_page(page_);
+        }
+        page_ = nullptr;
+        next_ = nullptr;
+        end_ = nullptr;
+    }
+
+    heap_allocation_scope_t::heap_allocation_scope_t(heap_pool_t* pool) noexcept
+        : previous_(current_pool) {
+        current_pool = pool;
+    }
+
+    heap_allocation_scope_t::~heap_allocation_scope_t() {
+        current_pool = previous_;
+    }
+
+    heap_pool_t* heap_allocation_scope_t::current() noexcept {
+        return current_pool;
+    }
+
+} // namespace document::impl
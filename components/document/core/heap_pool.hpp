@@ -0,0 +1,72 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+namespace document::impl {
+
+    // arena the heap values of documents are drawn from while a heap_allocation_scope_t is open on it.
+    // Its owner draws values one after another from pages aligned to page_size, with no lock; a value finds
+    // its page from its own address, so it carries no prefix and may be released on any thread. A page counts
+    // its live values atomically and goes back to the global heap in one piece when the last of them is
+    // released, whether or not the pool is still alive; the pool only gives up the page it draws from
+    class heap_pool_t final {
+    public:
+        static constexpr std::size_t page_size = 64 * 1024;
+        static constexpr std::size_t max_size = page_size / 16;
+
+        using ptr = std::unique_ptr<heap_pool_t>;
+        static ptr make();
+
+        // pool of the calling thread, for the documents decoded on it
+        static heap_pool_t* local() noexcept;
+
+        heap_pool_t() = default;
+        ~heap_pool_t();
+
+        heap_pool_t(const heap_pool_t&) = delete;
+        heap_pool_t& operator=(const heap_pool_t&) = delete;
+
+        // nullptr for a value over max_size, which is left to the global heap
+        void* allocate(std::size_t size);
+
+        // the global heap hands out 16-byte aligned blocks and the pool blocks 8 bytes past that,
+        // which tells the two apart
+        static bool is_pooled(const void* p) noexcept;
+        static void deallocate(void* p) noexcept;
+
+        std::size_t allocation_count() const noexcept;
+        std::size_t page_count() const noexcept;
+
+    private:
+        struct page_t;
+
+        void retire_() noexcept;
+
+        page_t* page_{nullptr};
+        char* next_{nullptr};
+        char* end_{nullptr};
+        std::size_t allocation_count_{0};
+        std::size_t page_count_{0};
+    };
+
+    using heap_pool_ptr = heap_pool_t::ptr;
+
+    // heap values created on this thread while the scope is alive come from the pool, nullptr is the global heap;
+    // scopes nest and the previous pool is back when the scope ends
+    class heap_allocation_scope_t final {
+    public:
+        explicit heap_allocation_scope_t(heap_pool_t* pool) noexcept;
+        ~heap_allocation_scope_t();
+
+        heap_allocation_scope_t(const heap_allocation_scope_t&) = delete;
+        heap_allocation_scope_t& operator=(const heap_allocation_scope_t&) = delete;
+
+        static heap_pool_t* current() noexcept;
+
+    private:
+        heap_pool_t* previous_;
+    };
+
+} // namespace document::impl
@@ -4,6 +4,7 @@
 
 #include <components/document/core/array.hpp>
 #include <components/document/core/dict.hpp>
+#include <components/document/field_path.hpp>
 
 using ::document::impl::value_type;
 
@@ -180,19 +181,12 @@ namespace components::document {
     }
 
     document_view_t::const_value_ptr document_view_t::get_value(std::string_view key) const {
-        auto dot_pos = key.find('.');
-        if (dot_pos != std::string::npos) {
-            auto key_parent = key.substr(0, dot_pos);
-            if (is_exists(key_parent)) {
-                auto doc_parent = make_document(get(key_parent)).detach(); //todo: memory leak
-                if (doc_parent) {
-                    return document_view_t(doc_parent).get_value(key.substr(dot_pos + 1, key.size() - dot_pos));
-                } else {
-                    return nullptr;
-                }
-            }
+        // a key of one segment in a dict is a single probe, only a path needs resolving
+        const auto* root = get_value();
+        if (root && root->type() == value_type::dict && key.find('.') == std::string_view::npos) {
+            return root->as_dict()->get(key);
         }
-        return get(key);
+        return field_path_t(key).get(root);
     }
 
     document_view_t::const_value_ptr document_view_t::get_value(uint32_t index) const {
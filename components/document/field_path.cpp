@@ -0,0 +1,74 @@
+#include "field_path.hpp"
+
+#include <charconv>
+
+#include <components/document/core/array.hpp>
+#include <components/document/document_view.hpp>
+
+using ::document::impl::value_type;
+
+namespace components::document {
+
+    namespace {
+
+        std::optional<uint32_t> parse_index(std::string_view segment) {
+            uint32_t index = 0;
+            auto end = segment.data() + segment.size();
+            auto result = std::from_chars(segment.data(), end, index);
+            if (segment.empty() || result.ec != std::errc() || result.ptr != end) {
+                return std::nullopt;
+            }
+            return index;
+        }
+
+    } // namespace
+
+    field_path_t::field_path_t(std::string_view path)
+        : path_(path) {
+        std::string_view rest(path_);
+        while (true) {
+            auto dot_pos = rest.find('.');
+            auto segment = rest.substr(0, dot_pos);
+            segments_.push_back({::document::impl::dict_t::key_t(segment), ::document::impl::dict_t::key_t(rest), parse_index(segment)});
+            if (dot_pos == std::string_view::npos) {
+                break;
+            }
+            rest.remove_prefix(dot_pos + 1);
+        }
+    }
+
+    const std::string& field_path_t::path() const noexcept {
+        return path_;
+    }
+
+    field_path_t::const_value_ptr field_path_t::get(const document_ptr& document) const {
+        if (!document) {
+            return nullptr;
+        }
+        return get(document_view_t(document).get_value());
+    }
+
+    field_path_t::const_value_ptr field_path_t::get(const_value_ptr root) const {
+        auto value = root;
+        for (auto it = segments_.begin(); it != segments_.end() && value; ++it) {
+            switch (value->type()) {
+                case value_type::dict: {
+                    const auto* dict = value->as_dict();
+                    value = dict->get(it->key);
+                    if (!value && std::next(it) != segments_.end()) {
+                        // a key holding dots is found whole, as document_view_t::get_value finds it
+                        return dict->get(it->rest);
+                    }
+                    break;
+                }
+                case value_type::array:
+                    value = it->index ? value->as_array()->get(*it->index) : nullptr;
+                    break;
+                default:
+                    return nullptr;
+            }
+        }
+        return value;
+    }
+
+} // namespace components::document
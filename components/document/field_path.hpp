@@ -0,0 +1,38 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <components/document/core/dict.hpp>
+#include <components/document/document.hpp>
+
+namespace components::document {
+
+    // a dotted field path resolved once: its segments are split and their dict keys built up front,
+    // and a numeric segment carries the array index it stands for, so reading the field
+    // of a document is a few probes of its dicts and arrays with no strings made on the way
+    class field_path_t final {
+    public:
+        using const_value_ptr = const ::document::impl::value_t*;
+
+        explicit field_path_t(std::string_view path);
+
+        const std::string& path() const noexcept;
+
+        const_value_ptr get(const document_ptr& document) const;
+        const_value_ptr get(const_value_ptr root) const;
+
+    private:
+        struct segment_t {
+            ::document::impl::dict_t::key_t key;
+            // the rest of the path from this segment on, looked up as one key when the segment is not there
+            ::document::impl::dict_t::key_t rest;
+            std::optional<uint32_t> index;
+        };
+
+        std::string path_;
+        std::vector<segment_t> segments_;
+    };
+
+} // namespace components::document
@@ -5,6 +5,7 @@
 
 #include <components/document/core/array.hpp>
 #include <components/document/core/dict.hpp>
+#include <components/document/core/heap_pool.hpp>
 #include <components/document/support/better_assert.hpp>
 #include <components/document/support/exception.hpp>
 #include <components/document/support/varint.hpp>
@@ -12,6 +13,31 @@
 
 namespace document::impl::internal {
 
+    namespace {
+
+        // a heap value drawn from a pool is told apart from one of the global heap by its address,
+        // so it must not need more than the 8-byte alignment the pool gives it
+        static_assert(alignof(heap_value_t) <= 8, "heap value must fit the alignment of a pool block");
+
+        void* allocate_(size_t size) {
+            if (auto* pool = heap_allocation_scope_t::current()) {
+                if (auto* p = pool->allocate(size)) {
+                    return p;
+                }
+            }
+            return ::operator new(size);
+        }
+
+        void deallocate_(void* ptr) {
+            if (heap_pool_t::is_pooled(ptr)) {
+                heap_pool_t::deallocate(ptr);
+                return;
+            }
+            ::operator delete(ptr);
+        }
+
+    } // namespace
+
     void* heap_value_t::operator new(size_t size, size_t extra_size) {
 #ifdef __GNUC__
 #pragma GCC diagnostic push
@@ -21,7 +47,7 @@ namespace document::impl::internal {
 #ifdef __GNUC__
 #pragma GCC diagnostic pop
 #endif
-        return ::operator new(size + extra_size);
+        return allocate_(size + extra_size);
     }
 
     heap_value_t::heap_value_t(tags tag, int tiny) {
@@ -177,15 +203,15 @@ namespace document::impl::internal {
     }
 
     void *heap_value_t::operator new(size_t size) {
-        return ::operator new(size);
+        return allocate_(size);
     }
 
     void heap_value_t::operator delete(void *ptr) {
-        ::operator delete(ptr);
+        deallocate_(ptr);
     }
 
     void heap_value_t::operator delete(void *ptr, size_t) {
-        ::operator delete(ptr);
+        deallocate_(ptr);
     }
 
 
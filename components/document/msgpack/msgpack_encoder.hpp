@@ -4,6 +4,7 @@
 #include <components/document/document_view.hpp>
 #include <components/document/core/array.hpp>
 #include <components/document/core/dict.hpp>
+#include <components/document/core/heap_pool.hpp>
 #include <msgpack.hpp>
 
 using ::document::impl::array_t;
@@ -53,6 +54,9 @@ namespace msgpack {
                     if (o.type != msgpack::type::MAP) {
                         throw msgpack::type_error();
                     }
+                    // decoded documents come from the pool in scope, or else from the pool of this thread
+                    auto* pool = ::document::impl::heap_allocation_scope_t::current();
+                    ::document::impl::heap_allocation_scope_t scope(pool ? pool : ::document::impl::heap_pool_t::local());
                     v = components::document::make_document(to_structure_(o)->as_dict());
                     return o;
                 }
@@ -0,0 +1,39 @@
+#include "packed_documents.hpp"
+#include "msgpack_encoder.hpp"
+
+namespace components::document {
+
+    packed_documents_t::packed_documents_t(const std::pmr::vector<document_ptr>& documents) {
+        entries_.reserve(documents.size());
+        for (const auto& document : documents) {
+            msgpack::pack(buffer_, document);
+            entries_.push_back({get_document_id(document), buffer_.size()});
+        }
+    }
+
+    std::size_t packed_documents_t::size() const noexcept {
+        return entries_.size();
+    }
+
+    bool packed_documents_t::empty() const noexcept {
+        return entries_.empty();
+    }
+
+    const document_id_t& packed_documents_t::id(std::size_t index) const {
+        return entries_.at(index).id;
+    }
+
+    std::string_view packed_documents_t::document(std::size_t index) const {
+        auto begin = index == 0 ? std::size_t(0) : entries_.at(index - 1).end;
+        return {buffer_.data() + begin, entries_.at(index).end - begin};
+    }
+
+    std::string_view packed_documents_t::documents() const noexcept {
+        return {buffer_.data(), buffer_.size()};
+    }
+
+    packed_documents_ptr pack_documents(const std::pmr::vector<document_ptr>& documents) {
+        return std::make_shared<const packed_documents_t>(documents);
+    }
+
+} // namespace components::document
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <memory>
+#include <memory_resource>
+#include <string_view>
+#include <vector>
+#include <components/document/document.hpp>
+#include <components/document/document_id.hpp>
+#include <msgpack.hpp>
+
+namespace components::document {
+
+    // documents msgpack-encoded once on the thread of the collection that owns them:
+    // the wal and the disk write these bytes and never read the documents the collection updates in place
+    class packed_documents_t final {
+    public:
+        explicit packed_documents_t(const std::pmr::vector<document_ptr>& documents);
+
+        std::size_t size() const noexcept;
+        bool empty() const noexcept;
+        const document_id_t& id(std::size_t index) const;
+        std::string_view document(std::size_t index) const;
+        // the encodings of all the documents one after another, the elements of a msgpack array
+        std::string_view documents() const noexcept;
+
+    private:
+        struct entry_t {
+            document_id_t id;
+            std::size_t end;
+        };
+
+        msgpack::sbuffer buffer_;
+        std::vector<entry_t> entries_;
+    };
+
+    using packed_documents_ptr = std::shared_ptr<const packed_documents_t>;
+
+    packed_documents_ptr pack_documents(const std::pmr::vector<document_ptr>& documents);
+
+} // namespace components::document
@@ -0,0 +1,46 @@
+#include <catch2/catch.hpp>
+#include <components/document/core/dict.hpp>
+#include <components/document/document_view.hpp>
+#include <components/document/field_path.hpp>
+#include <components/tests/generaty.hpp>
+
+using components::document::document_view_t;
+using components::document::field_path_t;
+using ::document::impl::value_type;
+
+TEST_CASE("field_path::get") {
+    auto doc = gen_doc(1);
+
+    REQUIRE(field_path_t("count").get(doc)->as_unsigned() == 1);
+    REQUIRE(field_path_t("countStr").get(doc)->as_string() == "1");
+    REQUIRE(field_path_t("countArray").get(doc)->type() == value_type::array);
+    REQUIRE(field_path_t("countArray.1").get(doc)->as_unsigned() == 2);
+    REQUIRE(field_path_t("countDict.even").get(doc)->as_bool() == false);
+    REQUIRE(field_path_t("nestedArray.2.3").get(doc)->as_unsigned() == 6);
+    REQUIRE(field_path_t("dictArray.4.number").get(doc)->as_unsigned() == 5);
+    REQUIRE(field_path_t("mixedDict.3.three").get(doc)->as_bool() == true);
+
+    REQUIRE(field_path_t("other").get(doc) == nullptr);
+    REQUIRE(field_path_t("countArray.10").get(doc) == nullptr);
+    REQUIRE(field_path_t("countArray.first").get(doc) == nullptr);
+    REQUIRE(field_path_t("countDict.other").get(doc) == nullptr);
+    REQUIRE(field_path_t("count.other").get(doc) == nullptr);
+    REQUIRE(field_path_t("count").get(components::document::document_ptr()) == nullptr);
+}
+
+TEST_CASE("field_path::reuse") {
+    field_path_t path("countDict.even");
+    for (int i = 1; i <= 10; ++i) {
+        auto doc = gen_doc(i);
+        REQUIRE(path.get(doc)->as_bool() == (i % 2 == 0));
+        REQUIRE(path.get(doc) == document_view_t(doc).get_value("countDict.even"));
+    }
+}
+
+TEST_CASE("field_path::dotted_key") {
+    auto dict = ::document::impl::dict_t::new_dict();
+    dict->set("a.b", 10);
+    auto doc = components::document::make_document(dict);
+    REQUIRE(field_path_t("a.b").get(doc)->as_int() == 10);
+    REQUIRE(field_path_t("a.c").get(doc) == nullptr);
+}
@@ -0,0 +1,98 @@
+#include <catch2/catch.hpp>
+#include <components/document/core/heap_pool.hpp>
+#include <components/document/document_view.hpp>
+#include <components/document/msgpack/msgpack_encoder.hpp>
+#include <components/tests/generaty.hpp>
+
+using ::document::impl::heap_allocation_scope_t;
+using ::document::impl::heap_pool_t;
+
+TEST_CASE("heap_pool::scope") {
+    auto pool = heap_pool_t::make();
+    REQUIRE(heap_allocation_scope_t::current() == nullptr);
+    {
+        heap_allocation_scope_t scope(pool.get());
+        REQUIRE(heap_allocation_scope_t::current() == pool.get());
+        {
+            heap_allocation_scope_t global(nullptr);
+            REQUIRE(heap_allocation_scope_t::current() == nullptr);
+        }
+        REQUIRE(heap_allocation_scope_t::current() == pool.get());
+    }
+    REQUIRE(heap_allocation_scope_t::current() == nullptr);
+}
+
+TEST_CASE("heap_pool::documents") {
+    auto pool = heap_pool_t::make();
+    std::vector<components::document::document_ptr> documents;
+    {
+        heap_allocation_scope_t scope(pool.get());
+        for (int i = 1; i <= 100; ++i) {
+            documents.push_back(gen_doc(i));
+        }
+    }
+    REQUIRE(pool->allocation_count() > 0);
+    REQUIRE(pool->page_count() > 0);
+    auto count = pool->allocation_count();
+
+    auto doc = gen_doc(101);
+    REQUIRE(pool->allocation_count() == count);
+
+    for (int i = 1; i <= 100; ++i) {
+        components::document::document_view_t view(documents.at(std::size_t(i - 1)));
+        REQUIRE(view.get_value("count")->as_int() == i);
+        REQUIRE(view.get_string("countStr") == std::to_string(i));
+        REQUIRE(view.get_value("countArray.4")->as_int() == i + 4);
+    }
+    documents.clear();
+}
+
+TEST_CASE("heap_pool::values_outlive_pool") {
+    auto pool = heap_pool_t::make();
+    components::document::document_ptr doc;
+    {
+        heap_allocation_scope_t scope(pool.get());
+        doc = gen_doc(1);
+    }
+    pool.reset();
+    components::document::document_view_t view(doc);
+    REQUIRE(view.get_value("count")->as_int() == 1);
+    REQUIRE(view.get_value("countDict.odd")->as_bool());
+    doc = nullptr;
+}
+
+TEST_CASE("heap_pool::global_heap") {
+    auto pool = heap_pool_t::make();
+    components::document::document_ptr pooled;
+    components::document::document_ptr global;
+    {
+        heap_allocation_scope_t scope(pool.get());
+        pooled = gen_doc(1);
+        {
+            heap_allocation_scope_t scope_global(nullptr);
+            global = gen_doc(2);
+        }
+    }
+    auto* block = pool->allocate(1);
+    REQUIRE(heap_pool_t::is_pooled(block));
+    heap_pool_t::deallocate(block);
+    REQUIRE(pool->allocate(heap_pool_t::max_size + 1) == nullptr);
+    components::document::document_view_t view_pooled(pooled);
+    components::document::document_view_t view_global(global);
+    REQUIRE(view_pooled.get_value("count")->as_int() == 1);
+    REQUIRE(view_global.get_value("count")->as_int() == 2);
+    pooled = nullptr;
+    global = nullptr;
+}
+
+TEST_CASE("heap_pool::decode") {
+    auto doc = gen_doc(1);
+    msgpack::sbuffer buffer;
+    msgpack::pack(buffer, doc);
+    auto count = heap_pool_t::local()->allocation_count();
+    msgpack::unpacked msg;
+    msgpack::unpack(msg, buffer.data(), buffer.size());
+    auto decoded = msg.get().as<components::document::document_ptr>();
+    REQUIRE(heap_pool_t::local()->allocation_count() > count);
+    REQUIRE(components::document::document_view_t(decoded).get_value("count")->as_int() == 1);
+}
@@ -0,0 +1,139 @@
+#include "composite_field_index.hpp"
+
+#include <algorithm>
+
+namespace components::index {
+
+    bool composite_field_index_t::comparator_t::operator()(const composite_value_t& lhs, const composite_value_t& rhs) const {
+        auto size = std::min(lhs.size(), rhs.size());
+        for (std::size_t i = 0; i < size; ++i) {
+            if (lhs[i] < rhs[i]) {
+                return true;
+            }
+            if (rhs[i] < lhs[i]) {
+                return false;
+            }
+        }
+        return false;
+    }
+
+    composite_field_index_t::composite_field_index_t(std::pmr::memory_resource* resource, std::string name, const keys_base_storage_t& keys)
+        : index_t(resource, ql::index_type::composite, std::move(name), keys)
+        , storage_(resource) {}
+
+    composite_field_index_t::~composite_field_index_t() = default;
+
+    index_t::iterator::reference composite_field_index_t::impl_t::value_ref() const {
+        return iterator_->second;
+    }
+
+    index_t::iterator_t::iterator_impl_t* composite_field_index_t::impl_t::next() {
+        iterator_++;
+        return this;
+    }
+
+    index_t::iterator_t::iterator_impl_t* composite_field_index_t::impl_t::prev() {
+        iterator_--;
+        return this;
+    }
+
+    bool composite_field_index_t::impl_t::equals(const iterator_impl_t* other) const {
+        return iterator_ == dynamic_cast<const impl_t *>(other)->iterator_;
+    }
+
+    bool composite_field_index_t::impl_t::not_equals(const iterator_impl_t* other) const {
+        return iterator_ != dynamic_cast<const impl_t *>(other)->iterator_;
+    }
+
+    index_t::iterator::iterator_impl_t *composite_field_index_t::impl_t::copy() const {
+        return new impl_t(*this);
+    }
+
+    composite_field_index_t::impl_t::impl_t(const_iterator iterator)
+        : iterator_(iterator) {
+    }
+
+    auto composite_field_index_t::insert_impl(value_t key, index_value_t value) -> void {
+        insert_impl(make_key(key), std::move(value));
+    }
+
+    auto composite_field_index_t::insert_impl(document::document_ptr doc) -> void {
+        auto id = document::get_document_id(doc);
+        composite_value_t values(resource());
+        for (const auto& path : key_paths()) {
+            values.emplace_back(path.get(doc));
+        }
+        insert_impl(values, {id, std::move(doc)});
+    }
+
+    auto composite_field_index_t::remove_impl(value_t key) -> void {
+        remove_impl(make_key(key));
+    }
+
+    index_t::range composite_field_index_t::find_impl(const value_t& value) const {
+        return find_impl(make_key(value));
+    }
+
+    index_t::range composite_field_index_t::lower_bound_impl(const value_t& value) const {
+        return lower_bound_impl(make_key(value));
+    }
+
+    index_t::range composite_field_index_t::upper_bound_impl(const value_t& value) const {
+        return upper_bound_impl(make_key(value));
+    }
+
+    auto composite_field_index_t::insert_impl(const composite_value_t& values, index_value_t value) -> void {
+        storage_.insert({values, std::move(value)});
+    }
+
+    auto composite_field_index_t::remove_impl(const composite_value_t& values) -> void {
+        auto it = storage_.find(values);
+        if (it != storage_.end()) {
+            storage_.erase(it);
+        }
+    }
+
+    auto composite_field_index_t::remove_impl(const composite_value_t& values, const document::document_id_t& id) -> void {
+        auto range = storage_.equal_range(values);
+        auto it = std::find_if(range.first, range.second, [&id](const storage_t::value_type& entry) {
+            return entry.second.id == id;
+        });
+        if (it != range.second) {
+            storage_.erase(it);
+        }
+    }
+
+    index_t::range composite_field_index_t::find_impl(const composite_value_t& values) const {
+        auto range = storage_.equal_range(values);
+        return std::make_pair(iterator(new impl_t(range.first)), iterator(new impl_t(range.second)));
+    }
+
+    index_t::range composite_field_index_t::lower_bound_impl(const composite_value_t& values) const {
+        auto it = storage_.lower_bound(values);
+        return std::make_pair(cbegin(), index_t::iterator(new impl_t(it)));
+    }
+
+    index_t::range composite_field_index_t::upper_bound_impl(const composite_value_t& values) const {
+        auto it = storage_.upper_bound(values);
+        return std::make_pair(index_t::iterator(new impl_t(it)), cend());
+    }
+
+    index_t::iterator composite_field_index_t::cbegin_impl() const {
+        return index_t::iterator(new impl_t(storage_.cbegin()));
+    }
+
+    index_t::iterator composite_field_index_t::cend_impl() const {
+        return index_t::iterator(new impl_t(storage_.cend()));
+    }
+
+    void composite_field_index_t::clean_memory_to_new_elements_impl(std::size_t) {
+        storage_.clear(); //todo: cache
+    }
+
+    composite_value_t composite_field_index_t::make_key(value_t value) const {
+        composite_value_t values(resource());
+        values.emplace_back(value);
+        return values;
+    }
+
+} // namespace components::index
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <memory>
+
+#include <core/btree/btree.hpp>
+
+#include "forward.hpp"
+#include "index.hpp"
+
+namespace components::index {
+
+    class composite_field_index_t final : public index_t {
+    public:
+        // lexicographic comparison over the common prefix of two keys:
+        // a shorter key is equivalent to all the keys it prefixes, so a lookup
+        // by the leading fields of the index yields one contiguous range
+        struct comparator_t {
+            bool operator()(const composite_value_t& lhs, const composite_value_t& rhs) const;
+        };
+
+        using storage_t = core::pmr::btree::multi_btree_t<composite_value_t, index_value_t, comparator_t>;
+        using const_iterator = storage_t::const_iterator;
+
+        composite_field_index_t(std::pmr::memory_resource*, std::string name, const keys_base_storage_t&);
+        ~composite_field_index_t() override;
+
+    private:
+        class impl_t final : public index_t::iterator::iterator_impl_t {
+        public:
+            explicit impl_t(const_iterator iterator);
+            index_t::iterator::reference value_ref() const final;
+            iterator_impl_t* next() final;
+            iterator_impl_t* prev() final;
+            bool equals(const iterator_impl_t* other) const final;
+            bool not_equals(const iterator_impl_t* other) const final;
+            iterator_impl_t *copy() const final;
+
+        private:
+            const_iterator iterator_;
+        };
+
+        auto insert_impl(value_t key, index_value_t value) -> void final;
+        auto insert_impl(document::document_ptr doc) -> void final;
+        auto remove_impl(value_t key) -> void final;
+        range find_impl(const value_t& value) const final;
+        range lower_bound_impl(const value_t& value) const final;
+        range upper_bound_impl(const value_t& value) const final;
+        auto insert_impl(const composite_value_t& values, index_value_t value) -> void final;
+        auto remove_impl(const composite_value_t& values) -> void final;
+        auto remove_impl(const composite_value_t& values, const document::document_id_t& id) -> void final;
+        range find_impl(const composite_value_t& values) const final;
+        range lower_bound_impl(const composite_value_t& values) const final;
+        range upper_bound_impl(const composite_value_t& values) const final;
+        iterator cbegin_impl() const final;
+        iterator cend_impl() const final;
+
+        void clean_memory_to_new_elements_impl(std::size_t count) final;
+
+        composite_value_t make_key(value_t value) const;
+
+    private:
+        storage_t storage_;
+    };
+
+} // namespace components::index
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <memory_resource>
+#include <string>
+#include <vector>
+#include <components/document/document_id.hpp>
+#include <components/document/wrapper_value.hpp>
+#include <components/ql/index.hpp>
+#include "key_encoding.hpp"
+
+namespace services::index {
+
+    enum class delta_type : uint8_t {
+        insert,
+        remove
+    };
+
+    // one change of a disk index; the changes a statement makes to an index
+    // reach its agent as one batch and are written at once
+    struct delta_t {
+        delta_type type;
+        std::string key;
+        components::document::document_id_t id;
+    };
+
+    using batch_t = std::pmr::vector<delta_t>;
+
+    // the key is encoded on the thread of the collection, the agent writes the bytes
+    // and never reads the document the collection may already be changing
+    inline delta_t make_delta(delta_type type, const std::pmr::vector<document::wrapper_value_t>& key,
+                              const components::document::document_id_t& id, components::ql::index_compare compare_type) {
+        return delta_t{type, encode_key(key, compare_type), id};
+    }
+
+} // namespace services::index
@@ -0,0 +1,149 @@
+#include "key_encoding.hpp"
+#include <cstring>
+#include <limits>
+
+namespace services::index {
+
+    using components::ql::index_compare;
+
+    enum class key_tag : char {
+        null = least_key_byte,
+        boolean = 0x20,
+        integer = 0x30,
+        big_unsigned = 0x31,
+        floating = 0x40,
+        string = 0x50,
+        data = 0x60,
+        other = 0x70
+    };
+
+    void append_tag(std::string& out, key_tag tag) {
+        out.push_back(static_cast<char>(tag));
+    }
+
+    void append_big_endian(std::string& out, uint64_t value) {
+        for (int shift = 56; shift >= 0; shift -= 8) {
+            out.push_back(static_cast<char>((value >> shift) & 0xFF));
+        }
+    }
+
+    void append_int(std::string& out, int64_t value) {
+        append_tag(out, key_tag::integer);
+        append_big_endian(out, static_cast<uint64_t>(value) ^ (uint64_t(1) << 63));
+    }
+
+    void append_unsigned(std::string& out, uint64_t value) {
+        if (value > static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
+            append_tag(out, key_tag::big_unsigned);
+            append_big_endian(out, value);
+        } else {
+            append_int(out, static_cast<int64_t>(value));
+        }
+    }
+
+    void append_double(std::string& out, double value) {
+        if (value == 0.0) {
+            value = 0.0; // -0.0 == 0.0
+        }
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        bits = (bits & (uint64_t(1) << 63)) ? ~bits : bits | (uint64_t(1) << 63);
+        append_tag(out, key_tag::floating);
+        append_big_endian(out, bits);
+    }
+
+    // 0x00 is escaped as 0x00 0xff and the bytes are terminated by 0x00 0x01,
+    // so a string never prefixes a longer one and the next value of a compound key starts after it
+    void append_bytes(std::string& out, key_tag tag, std::string_view bytes) {
+        append_tag(out, tag);
+        for (auto c : bytes) {
+            out.push_back(c);
+            if (c == '\0') {
+                out.push_back('\xff');
+            }
+        }
+        out.push_back('\0');
+        out.push_back('\x01');
+    }
+
+    bool is_numeric_compare(index_compare compare_type) {
+        return compare_type != index_compare::str && compare_type != index_compare::bool8;
+    }
+
+    void append_value(std::string& out, const document::wrapper_value_t& value, index_compare compare_type) {
+        using document::impl::value_type;
+        if (!value || value->type() == value_type::null || value->type() == value_type::undefined) {
+            append_tag(out, key_tag::null);
+            return;
+        }
+        auto type = value->type();
+        if (type == value_type::number && is_numeric_compare(compare_type)) {
+            switch (compare_type) {
+                case index_compare::uint8:
+                case index_compare::uint16:
+                case index_compare::uint32:
+                case index_compare::uint64:
+                    append_unsigned(out, value->as_unsigned());
+                    return;
+                case index_compare::float32:
+                case index_compare::float64:
+                    append_double(out, value->as_double());
+                    return;
+                default:
+                    append_int(out, value->as_int());
+                    return;
+            }
+        }
+        switch (type) {
+            case value_type::boolean:
+                append_tag(out, key_tag::boolean);
+                out.push_back(value->as_bool() ? '\x01' : '\0');
+                return;
+            case value_type::number:
+                if (value->is_double()) {
+                    append_double(out, value->as_double());
+                } else if (value->is_unsigned()) {
+                    append_unsigned(out, value->as_unsigned());
+                } else if (value->is_int()) {
+                    append_int(out, value->as_int());
+                } else {
+                    append_double(out, value->as_double());
+                }
+                return;
+            case value_type::string:
+                append_bytes(out, key_tag::string, value->as_string());
+                return;
+            case value_type::data:
+                append_bytes(out, key_tag::data, value->as_data());
+                return;
+            default:
+                append_tag(out, key_tag::other);
+                return;
+        }
+    }
+
+    std::string encode_key(const document::wrapper_value_t& value, index_compare compare_type) {
+        std::string key;
+        append_value(key, value, compare_type);
+        return key;
+    }
+
+    std::string encode_key(const std::pmr::vector<document::wrapper_value_t>& key, index_compare compare_type) {
+        std::string result;
+        for (const auto& value : key) {
+            append_value(result, value, compare_type);
+        }
+        return result;
+    }
+
+    std::string prefix_successor(std::string key) {
+        while (!key.empty() && static_cast<unsigned char>(key.back()) == 0xFF) {
+            key.pop_back();
+        }
+        if (!key.empty()) {
+            key.back() = static_cast<char>(static_cast<unsigned char>(key.back()) + 1);
+        }
+        return key;
+    }
+
+} // namespace services::index
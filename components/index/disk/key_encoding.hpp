@@ -0,0 +1,23 @@
+#pragma once
+
+#include <memory_resource>
+#include <string>
+#include <vector>
+#include <components/document/wrapper_value.hpp>
+#include <components/ql/index.hpp>
+
+namespace services::index {
+
+    // keys of disk indexes are stored in an order-preserving binary encoding: the bytewise order of encoded
+    // values is the order of the values and a compound key is the concatenation of its encoded values.
+    // The collection encodes the keys of its changes, so the agents never read the documents
+    std::string encode_key(const document::wrapper_value_t& value, components::ql::index_compare compare_type);
+    std::string encode_key(const std::pmr::vector<document::wrapper_value_t>& key, components::ql::index_compare compare_type);
+
+    // the smallest key greater than all the keys prefixed by key, empty if there is none
+    std::string prefix_successor(std::string key);
+
+    // every encoded key starts with a byte of at least this value, the keys below are left for metadata
+    constexpr char least_key_byte = 0x10;
+
+} // namespace services::index
@@ -8,8 +8,7 @@ namespace services::index {
         create,
         drop,
 
-        insert,
-        remove,
+        batch,
         find,
 
         success,
@@ -17,6 +17,7 @@ namespace components::index {
     using components::ql::keys_base_storage_t;
     using id_index = uint32_t;
     using value_t = ::document::wrapper_value_t;
+    using composite_value_t = std::pmr::vector<value_t>;
     using query_t = expressions::compare_expression_ptr;
     using result_set_t = cursor::sub_cursor_t;
 
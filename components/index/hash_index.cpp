@@ -1 +1,265 @@
 #include "hash_index.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+
+namespace components::index {
+
+    namespace {
+
+        constexpr std::size_t min_capacity = 16;
+
+        std::size_t hash_combine(std::size_t seed, std::size_t value) {
+            return seed ^ (value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2));
+        }
+
+        // keys equal by value_t::is_equal share the type tag, so the tag is mixed into the hash
+        std::size_t hash_value(const value_t& value) {
+            using ::document::impl::value_type;
+            if (!value) {
+                return 0;
+            }
+            auto seed = std::hash<int>{}(static_cast<int>(value->tag()));
+            switch (value->type()) {
+                case value_type::boolean:
+                    return hash_combine(seed, std::hash<bool>{}(value->as_bool()));
+                case value_type::number:
+                    if (value->is_int()) {
+                        return hash_combine(seed, std::hash<int64_t>{}(value->as_int()));
+                    }
+                    return hash_combine(seed, std::hash<double>{}(value->as_double()));
+                case value_type::string:
+                    return hash_combine(seed, std::hash<std::string_view>{}(value->as_string()));
+                case value_type::data:
+                    return hash_combine(seed, std::hash<std::string_view>{}(value->as_data()));
+                default:
+                    return seed;
+            }
+        }
+
+    } // namespace
+
+    hash_index_t::slot_t::slot_t(std::pmr::memory_resource* resource)
+        : values(resource) {}
+
+    hash_index_t::hash_index_t(std::pmr::memory_resource* resource, std::string name, const keys_base_storage_t& keys)
+        : index_t(resource, ql::index_type::hashed, std::move(name), keys)
+        , slots_(resource) {}
+
+    hash_index_t::~hash_index_t() = default;
+
+    hash_index_t::impl_t::impl_t(const storage_t* slots, std::size_t slot, std::size_t position)
+        : slots_(slots)
+        , slot_(slot)
+        , position_(position) {
+    }
+
+    index_t::iterator::reference hash_index_t::impl_t::value_ref() const {
+        return (*slots_)[slot_].values[position_];
+    }
+
+    index_t::iterator_t::iterator_impl_t* hash_index_t::impl_t::next() {
+        if (++position_ == (*slots_)[slot_].values.size()) {
+            slot_ = next_occupied(*slots_, slot_ + 1);
+            position_ = 0;
+        }
+        return this;
+    }
+
+    index_t::iterator_t::iterator_impl_t* hash_index_t::impl_t::prev() {
+        if (position_ > 0) {
+            --position_;
+        } else {
+            slot_ = prev_occupied(*slots_, slot_);
+            position_ = (*slots_)[slot_].values.size() - 1;
+        }
+        return this;
+    }
+
+    bool hash_index_t::impl_t::equals(const iterator_impl_t* other) const {
+        const auto* rhs = dynamic_cast<const impl_t*>(other);
+        return slot_ == rhs->slot_ && position_ == rhs->position_;
+    }
+
+    bool hash_index_t::impl_t::not_equals(const iterator_impl_t* other) const {
+        return !equals(other);
+    }
+
+    index_t::iterator::iterator_impl_t* hash_index_t::impl_t::copy() const {
+        return new impl_t(*this);
+    }
+
+    auto hash_index_t::insert_impl(value_t key, index_value_t value) -> void {
+        if ((size_ + 1) * 2 > slots_.size()) {
+            rehash(std::max(min_capacity, slots_.size() * 2));
+        }
+        auto hash = hash_value(key);
+        auto slot = find_slot(hash, key);
+        auto& target = slots_[slot];
+        if (!target.key) {
+            target.hash = hash;
+            target.key = key;
+            ++size_;
+        }
+        target.values.push_back(std::move(value));
+    }
+
+    auto hash_index_t::insert_impl(document::document_ptr doc) -> void {
+        auto id = document::get_document_id(doc);
+        insert_impl(index::value_t{key_paths().front().get(doc)}, {id, std::move(doc)});
+    }
+
+    auto hash_index_t::remove_impl(value_t key) -> void {
+        if (slots_.empty()) {
+            return;
+        }
+        auto slot = find_slot(hash_value(key), key);
+        auto& target = slots_[slot];
+        if (!target.key) {
+            return;
+        }
+        target.values.erase(target.values.begin());
+        if (target.values.empty()) {
+            erase_slot(slot);
+        }
+    }
+
+    auto hash_index_t::remove_impl(const composite_value_t& values, const document::document_id_t& id) -> void {
+        assert(!values.empty());
+        if (slots_.empty()) {
+            return;
+        }
+        const auto& key = values.front();
+        auto slot = find_slot(hash_value(key), key);
+        auto& target = slots_[slot];
+        if (!target.key) {
+            return;
+        }
+        auto it = std::find_if(target.values.begin(), target.values.end(), [&id](const index_value_t& value) {
+            return value.id == id;
+        });
+        if (it == target.values.end()) {
+            return;
+        }
+        target.values.erase(it);
+        if (target.values.empty()) {
+            erase_slot(slot);
+        }
+    }
+
+    index_t::range hash_index_t::find_impl(const value_t& value) const {
+        if (slots_.empty()) {
+            return std::make_pair(cend(), cend());
+        }
+        auto slot = find_slot(hash_value(value), value);
+        if (!slots_[slot].key) {
+            return std::make_pair(cend(), cend());
+        }
+        return std::make_pair(make_iterator(slot), make_iterator(next_occupied(slots_, slot + 1)));
+    }
+
+    index_t::range hash_index_t::lower_bound_impl(const value_t& value) const {
+        auto range = find_impl(value);
+        return std::make_pair(cbegin(), range.first);
+    }
+
+    index_t::range hash_index_t::upper_bound_impl(const value_t& value) const {
+        auto range = find_impl(value);
+        if (range.first == range.second) {
+            return std::make_pair(cend(), cend());
+        }
+        return std::make_pair(range.second, cend());
+    }
+
+    index_t::iterator hash_index_t::cbegin_impl() const {
+        return make_iterator(next_occupied(slots_, 0));
+    }
+
+    index_t::iterator hash_index_t::cend_impl() const {
+        return make_iterator(slots_.size());
+    }
+
+    void hash_index_t::clean_memory_to_new_elements_impl(std::size_t) {
+        for (auto& slot : slots_) {
+            slot.key = value_t{nullptr};
+            slot.values.clear();
+        }
+        size_ = 0;
+    }
+
+    std::size_t hash_index_t::next_occupied(const storage_t& slots, std::size_t slot) {
+        while (slot < slots.size() && !slots[slot].key) {
+            ++slot;
+        }
+        return slot;
+    }
+
+    std::size_t hash_index_t::prev_occupied(const storage_t& slots, std::size_t slot) {
+        do {
+            --slot;
+        } while (!slots[slot].key);
+        return slot;
+    }
+
+    // the slot holding key, or the empty slot ending its probe sequence
+    std::size_t hash_index_t::find_slot(std::size_t hash, const value_t& key) const {
+        auto mask = slots_.size() - 1;
+        auto slot = hash & mask;
+        while (slots_[slot].key && !(slots_[slot].hash == hash && slots_[slot].key == key)) {
+            slot = (slot + 1) & mask;
+        }
+        return slot;
+    }
+
+    // backward shift deletion: the slots of the probe sequence that follows are moved
+    // into the hole whenever it lies between their ideal slot and their current one
+    void hash_index_t::erase_slot(std::size_t slot) {
+        auto mask = slots_.size() - 1;
+        auto hole = slot;
+        auto current = slot;
+        while (true) {
+            current = (current + 1) & mask;
+            if (!slots_[current].key) {
+                break;
+            }
+            auto ideal = slots_[current].hash & mask;
+            bool is_movable = hole <= current
+                                  ? (ideal <= hole || ideal > current)
+                                  : (ideal <= hole && ideal > current);
+            if (is_movable) {
+                std::swap(slots_[hole], slots_[current]);
+                hole = current;
+            }
+        }
+        slots_[hole].key = value_t{nullptr};
+        slots_[hole].values.clear();
+        --size_;
+    }
+
+    void hash_index_t::rehash(std::size_t capacity) {
+        storage_t slots(resource());
+        slots.reserve(capacity);
+        for (std::size_t i = 0; i < capacity; ++i) {
+            slots.emplace_back(resource());
+        }
+        std::swap(slots_, slots);
+        auto mask = capacity - 1;
+        for (auto& slot : slots) {
+            if (slot.key) {
+                auto target = slot.hash & mask;
+                while (slots_[target].key) {
+                    target = (target + 1) & mask;
+                }
+                slots_[target].hash = slot.hash;
+                slots_[target].key = slot.key;
+                slots_[target].values = std::move(slot.values);
+            }
+        }
+    }
+
+    index_t::iterator hash_index_t::make_iterator(std::size_t slot) const {
+        return index_t::iterator(new impl_t(&slots_, slot, 0));
+    }
+
+} // namespace components::index
@@ -1,5 +1,71 @@
 #pragma once
 
-#include <unordered_map>
+#include <memory_resource>
 
 #include "forward.hpp"
+#include "index.hpp"
+
+namespace components::index {
+
+    // equality index on a flat open addressing table with linear probing,
+    // each slot keeps all the values of one key.
+    // There is no order between keys: lower_bound and upper_bound yield the entries
+    // placed before and after the ones of the key, which is enough to answer $ne
+    class hash_index_t final : public index_t {
+    public:
+        hash_index_t(std::pmr::memory_resource*, std::string name, const keys_base_storage_t&);
+        ~hash_index_t() override;
+
+    private:
+        struct slot_t {
+            explicit slot_t(std::pmr::memory_resource* resource);
+
+            std::size_t hash{0};
+            value_t key{nullptr};
+            std::pmr::vector<index_value_t> values;
+        };
+
+        using storage_t = std::pmr::vector<slot_t>;
+
+        class impl_t final : public index_t::iterator::iterator_impl_t {
+        public:
+            impl_t(const storage_t* slots, std::size_t slot, std::size_t position);
+            index_t::iterator::reference value_ref() const final;
+            iterator_impl_t* next() final;
+            iterator_impl_t* prev() final;
+            bool equals(const iterator_impl_t* other) const final;
+            bool not_equals(const iterator_impl_t* other) const final;
+            iterator_impl_t *copy() const final;
+
+        private:
+            const storage_t* slots_;
+            std::size_t slot_;
+            std::size_t position_;
+        };
+
+        auto insert_impl(value_t key, index_value_t value) -> void final;
+        auto insert_impl(document::document_ptr doc) -> void final;
+        auto remove_impl(value_t key) -> void final;
+        auto remove_impl(const composite_value_t& values, const document::document_id_t& id) -> void final;
+        range find_impl(const value_t& value) const final;
+        range lower_bound_impl(const value_t& value) const final;
+        range upper_bound_impl(const value_t& value) const final;
+        iterator cbegin_impl() const final;
+        iterator cend_impl() const final;
+
+        void clean_memory_to_new_elements_impl(std::size_t count) final;
+
+        static std::size_t next_occupied(const storage_t& slots, std::size_t slot);
+        static std::size_t prev_occupied(const storage_t& slots, std::size_t slot);
+
+        std::size_t find_slot(std::size_t hash, const value_t& key) const;
+        void erase_slot(std::size_t slot);
+        void rehash(std::size_t capacity);
+        iterator make_iterator(std::size_t slot) const;
+
+    private:
+        storage_t slots_;
+        std::size_t size_{0};
+    };
+
+} // namespace components::index
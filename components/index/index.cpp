@@ -1,5 +1,7 @@
 #include "index.hpp"
 
+#include <components/document/document_view.hpp>
+
 namespace components::index {
 
     index_t::index_t(std::pmr::memory_resource* resource, components::ql::index_type type, std::string name, const keys_base_storage_t& keys)
@@ -8,6 +10,14 @@ namespace components::index {
         , name_(std::move(name))
         , keys_(keys) {
         assert(resource != nullptr);
+        key_paths_.reserve(keys_.size());
+        for (const auto& key : keys_) {
+            key_paths_.emplace_back(key.as_string());
+        }
+    }
+
+    const std::vector<document::field_path_t>& index_t::key_paths() const noexcept {
+        return key_paths_;
     }
 
     index_t::range index_t::find(const value_t& value) const {
@@ -22,6 +32,18 @@ namespace components::index {
         return upper_bound_impl(value);
     }
 
+    index_t::range index_t::find(const composite_value_t& values) const {
+        return find_impl(values);
+    }
+
+    index_t::range index_t::lower_bound(const composite_value_t& values) const {
+        return lower_bound_impl(values);
+    }
+
+    index_t::range index_t::upper_bound(const composite_value_t& values) const {
+        return upper_bound_impl(values);
+    }
+
     index_t::iterator index_t::cbegin() const {
         return cbegin_impl();
     }
@@ -47,10 +69,62 @@ namespace components::index {
         insert_impl(std::move(doc));
     }
 
+    auto index_t::insert(const composite_value_t& values, index_value_t value) -> void {
+        return insert_impl(values, std::move(value));
+    }
+
+    auto index_t::insert(const composite_value_t& values, document::document_ptr doc) -> void {
+        auto id = document::get_document_id(doc);
+        return insert_impl(values, {id, std::move(doc)});
+    }
+
     auto index_t::remove(value_t key) -> void {
         remove_impl(key);
     }
 
+    auto index_t::remove(const composite_value_t& values) -> void {
+        remove_impl(values);
+    }
+
+    auto index_t::remove(const composite_value_t& values, const document::document_id_t& id) -> void {
+        remove_impl(values, id);
+    }
+
+    void index_t::insert_impl(const composite_value_t& values, index_value_t value) {
+        assert(!values.empty());
+        insert_impl(values.front(), std::move(value));
+    }
+
+    void index_t::remove_impl(const composite_value_t& values) {
+        assert(!values.empty());
+        remove_impl(values.front());
+    }
+
+    void index_t::remove_impl(const composite_value_t& values, const document::document_id_t&) {
+        remove_impl(values);
+    }
+
+    std::pmr::vector<composite_value_t> index_t::stored_keys_impl(const composite_value_t& entry) const {
+        std::pmr::vector<composite_value_t> keys(resource_);
+        keys.push_back(entry);
+        return keys;
+    }
+
+    index_t::range index_t::find_impl(const composite_value_t& values) const {
+        assert(!values.empty());
+        return find_impl(values.front());
+    }
+
+    index_t::range index_t::lower_bound_impl(const composite_value_t& values) const {
+        assert(!values.empty());
+        return lower_bound_impl(values.front());
+    }
+
+    index_t::range index_t::upper_bound_impl(const composite_value_t& values) const {
+        assert(!values.empty());
+        return upper_bound_impl(values.front());
+    }
+
     auto index_t::keys() -> std::pair<std::pmr::vector<key_t>::iterator, std::pmr::vector<key_t>::iterator> {
         return std::make_pair(keys_.begin(), keys_.end());
     }
@@ -79,10 +153,76 @@ namespace components::index {
         disk_agent_ = std::move(address);
     }
 
+    ql::index_compare index_t::compare_type() const noexcept {
+        return compare_type_;
+    }
+
+    void index_t::set_compare_type(ql::index_compare compare_type) noexcept {
+        compare_type_ = compare_type;
+    }
+
     void index_t::clean_memory_to_new_elements(std::size_t count) noexcept {
         clean_memory_to_new_elements_impl(count);
     }
 
+    bool index_t::is_sparse() const noexcept {
+        return sparse_;
+    }
+
+    void index_t::set_sparse(bool sparse) noexcept {
+        sparse_ = sparse;
+    }
+
+    bool index_t::is_partial() const noexcept {
+        return partial_filter_ != nullptr;
+    }
+
+    const expressions::compare_expression_ptr& index_t::partial_filter() const noexcept {
+        return partial_filter_;
+    }
+
+    const ql::storage_parameters& index_t::partial_parameters() const noexcept {
+        return partial_parameters_;
+    }
+
+    void index_t::set_partial_filter(expressions::compare_expression_ptr filter, ql::storage_parameters parameters, filter_t check) {
+        partial_filter_ = std::move(filter);
+        partial_parameters_ = std::move(parameters);
+        partial_check_ = std::move(check);
+    }
+
+    composite_value_t index_t::entry(const document::document_ptr& document) const {
+        auto values = entry_impl(document);
+        if (!values.empty() && partial_check_ && !partial_check_(document)) {
+            return composite_value_t(resource_);
+        }
+        return values;
+    }
+
+    composite_value_t index_t::entry_impl(const document::document_ptr& document) const {
+        composite_value_t values(resource_);
+        for (const auto& path : key_paths_) {
+            const auto* value = path.get(document);
+            if (sparse_ && (!value || value->type() == ::document::impl::value_type::null)) {
+                return composite_value_t(resource_);
+            }
+            if (!value) {
+                // no predicate matches a missing field, so neither does the index;
+                // a missing trailing key of a compound index is kept as null for prefix lookups
+                if (values.empty()) {
+                    return composite_value_t(resource_);
+                }
+                value = ::document::impl::value_t::null_value;
+            }
+            values.emplace_back(value);
+        }
+        return values;
+    }
+
+    std::pmr::vector<composite_value_t> index_t::stored_keys(const composite_value_t& entry) const {
+        return stored_keys_impl(entry);
+    }
+
     index_t::iterator_t::reference index_t::iterator_t::operator*() const {
         return impl_->value_ref();
     }
@@ -96,6 +236,11 @@ namespace components::index {
         return *this;
     }
 
+    index_t::iterator_t& index_t::iterator_t::operator--() {
+        impl_->prev();
+        return *this;
+    }
+
     bool index_t::iterator_t::operator==(const iterator_t& other) const {
         return impl_->equals(other.impl_);
     }
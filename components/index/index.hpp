@@ -1,7 +1,10 @@
 #pragma once
 
+#include <functional>
+
 #include "core/pmr.hpp"
 #include "forward.hpp"
+#include <components/document/field_path.hpp>
 #include <components/ql/index.hpp>
 
 namespace components::index {
@@ -39,6 +42,7 @@ namespace components::index {
             reference operator*() const;
             pointer operator->() const;
             iterator_t& operator++();
+            iterator_t& operator--();
             bool operator==(const iterator_t& other) const;
             bool operator!=(const iterator_t& other) const;
 
@@ -47,6 +51,7 @@ namespace components::index {
                 virtual ~iterator_impl_t() = default;
                 virtual reference value_ref() const = 0;
                 virtual iterator_impl_t* next() = 0;
+                virtual iterator_impl_t* prev() = 0;
                 virtual bool equals(const iterator_impl_t* other) const = 0;
                 virtual bool not_equals(const iterator_impl_t* other) const = 0;
                 virtual iterator_impl_t *copy() const = 0;
@@ -58,15 +63,23 @@ namespace components::index {
 
         using iterator = iterator_t;
         using range = std::pair<iterator, iterator>;
+        using filter_t = std::function<bool(const document::document_ptr&)>;
 
         void insert(value_t, index_value_t);
         void insert(value_t, const document::document_id_t&);
         void insert(value_t, document::document_ptr);
         void insert(document::document_ptr);
+        void insert(const composite_value_t&, index_value_t);
+        void insert(const composite_value_t&, document::document_ptr);
         void remove(value_t);
+        void remove(const composite_value_t&);
+        void remove(const composite_value_t&, const document::document_id_t&);
         range find(const value_t& value) const;
         range lower_bound(const value_t& value) const;
         range upper_bound(const value_t& value) const;
+        range find(const composite_value_t& values) const;
+        range lower_bound(const composite_value_t& values) const;
+        range upper_bound(const composite_value_t& values) const;
         iterator cbegin() const;
         iterator cend() const;
         auto keys() -> std::pair<keys_base_storage_t::iterator, keys_base_storage_t::iterator>;
@@ -77,18 +90,50 @@ namespace components::index {
         bool is_disk() const noexcept;
         const actor_zeta::address_t& disk_agent() const noexcept;
         void set_disk_agent(actor_zeta::address_t address) noexcept;
+        // the keys of the changes sent to the disk agent are encoded by it
+        ql::index_compare compare_type() const noexcept;
+        void set_compare_type(ql::index_compare compare_type) noexcept;
 
         void clean_memory_to_new_elements(std::size_t count) noexcept;
 
+        bool is_sparse() const noexcept;
+        void set_sparse(bool sparse) noexcept;
+        bool is_partial() const noexcept;
+        const expressions::compare_expression_ptr& partial_filter() const noexcept;
+        const ql::storage_parameters& partial_parameters() const noexcept;
+        // the expression and its parameters describe the filter to the planner, check evaluates it
+        void set_partial_filter(expressions::compare_expression_ptr filter, ql::storage_parameters parameters, filter_t check);
+        // entry of the document: values of all the keys in declaration order, empty when the document
+        // is left out of the index (missing leading key, missing or null key of a sparse index, partial filter);
+        // the one rule for bulk loads and per-document maintenance
+        composite_value_t entry(const document::document_ptr& document) const;
+        // keys the index stores an entry under: the entry itself, or one per distinct array element of a multikey index
+        std::pmr::vector<composite_value_t> stored_keys(const composite_value_t& entry) const;
+
     protected:
         index_t(std::pmr::memory_resource* resource, index_type type, std::string name, const keys_base_storage_t& keys);
 
+        // the keys resolved once into paths, in the order of keys(), to read them from every document
+        const std::vector<document::field_path_t>& key_paths() const noexcept;
+
         virtual void insert_impl(value_t value_key, index_value_t) = 0;
         virtual void insert_impl(document::document_ptr) = 0;
         virtual void remove_impl(value_t value_key) = 0;
         virtual range find_impl(const value_t& value) const = 0;
         virtual range lower_bound_impl(const value_t& value) const = 0;
         virtual range upper_bound_impl(const value_t& value) const = 0;
+        // a single field index is a compound index of one key, so by default
+        // the compound key is reduced to its first value
+        virtual void insert_impl(const composite_value_t& values, index_value_t);
+        virtual void remove_impl(const composite_value_t& values);
+        // the entry of the document id, the default removes any entry of the key
+        virtual void remove_impl(const composite_value_t& values, const document::document_id_t& id);
+        virtual std::pmr::vector<composite_value_t> stored_keys_impl(const composite_value_t& entry) const;
+        // values of the keys before the partial filter, an index not led by field keys takes its own from the document
+        virtual composite_value_t entry_impl(const document::document_ptr& document) const;
+        virtual range find_impl(const composite_value_t& values) const;
+        virtual range lower_bound_impl(const composite_value_t& values) const;
+        virtual range upper_bound_impl(const composite_value_t& values) const;
         virtual iterator cbegin_impl() const  = 0;
         virtual iterator cend_impl() const  = 0;
 
@@ -99,7 +144,13 @@ namespace components::index {
         index_type type_;
         std::string name_;
         keys_base_storage_t keys_;
+        std::vector<document::field_path_t> key_paths_;
         actor_zeta::address_t disk_agent_{actor_zeta::address_t::empty_address()};
+        ql::index_compare compare_type_{ql::index_compare::str};
+        bool sparse_{false};
+        expressions::compare_expression_ptr partial_filter_{nullptr};
+        ql::storage_parameters partial_parameters_;
+        filter_t partial_check_;
 
         friend class index_engine_t;
     };
@@ -25,16 +25,9 @@ namespace components::index {
     void insert(const index_engine_ptr& ptr, id_index id, std::pmr::vector<document_ptr>& docs) {
         auto* index = search_index(ptr, id);
         for (const auto& i : docs) {
-            auto range = index->keys();
-            for (auto j = range.first; j != range.second; ++j) {
-                const auto& key_tmp = *j;
-                const std::string& key = key_tmp.as_string(); // hack
-                document::document_view_t view(i);
-                if ((!(view.is_null(key)))) {
-                    auto* data = view.get_value(key);
-                    ::document::wrapper_value_t key_(data);
-                    index->insert(key_, i);
-                }
+            auto values = index->entry(i);
+            if (!values.empty()) {
+                index->insert(values, i);
             }
         }
     }
@@ -42,34 +35,18 @@ namespace components::index {
     void insert(const index_engine_ptr& ptr, id_index id, core::pmr::btree::btree_t<document::document_id_t, document_ptr>& docs) {
         auto* index = search_index(ptr, id);
         for (auto& doc : docs) {
-            auto range = index->keys();
-            for (auto j = range.first; j != range.second; ++j) {
-                const auto& key_tmp = *j;
-                const std::string& key = key_tmp.as_string(); // hack
-                document::document_view_t view(doc.second);
-                if ((!(view.is_null(key)))) {
-                    auto* data = view.get_value(key);
-                    ::document::wrapper_value_t key_(data);
-                    index->insert(key_, {doc.first, doc.second});
-                }
+            auto values = index->entry(doc.second);
+            if (!values.empty()) {
+                index->insert(values, {doc.first, doc.second});
             }
         }
     }
 
     void insert_one(const index_engine_ptr& ptr, id_index id, document_ptr doc) {
         auto* index = search_index(ptr, id);
-        auto range = index->keys();
-        for (auto j = range.first; j != range.second; ++j) {
-            if (j->which() == key_t::type::string) {
-                const auto& key_tmp = *j;
-                const std::string& key = key_tmp.as_string(); // hack
-                document::document_view_t view(doc);
-                if ((!(view.is_null(key)))) {
-                    auto* data = view.get_value(key);
-                    ::document::wrapper_value_t key_(data);
-                    index->insert(key_, doc);
-                }
-            }
+        auto values = index->entry(doc);
+        if (!values.empty()) {
+            index->insert(values, doc);
         }
     }
 
@@ -89,6 +66,10 @@ namespace components::index {
         return ptr->matching(name);
     }
 
+    auto search_indexes_by_prefix(const index_engine_ptr& ptr, const key_t& key) -> std::vector<index_t::pointer> {
+        return ptr->matching_prefix(key);
+    }
+
     auto make_index_engine(actor_zeta::detail::pmr::memory_resource* resource) -> index_engine_ptr {
         auto size = sizeof(index_engine_t);
         auto align = alignof(index_engine_t);
@@ -97,34 +78,14 @@ namespace components::index {
         return {index_engine, core::pmr::deleter_t(resource)};
     }
 
-    bool is_match_document(const index_ptr& index, const document_ptr& document) {
-        auto keys = index->keys();
-        components::document::document_view_t view(document);
-        for (auto key = keys.first; key != keys.second; ++key) {
-            if (!view.is_exists(key->as_string())) {
-                return false;
-            }
-        }
-        return true;
-    }
-
-    components::index::value_t get_value_by_index(const index_ptr& index, const document_ptr& document) {
-        auto keys = index->keys();
-        components::document::document_view_t view(document);
-        if (keys.first != keys.second) {
-            return components::index::value_t(view.get_value(keys.first->as_string()));
-            //todo: multi values index
-        }
-        return components::index::value_t(nullptr);
-    }
-
     index_engine_t::index_engine_t(actor_zeta::detail::pmr::memory_resource* resource)
         : resource_(resource)
         , mapper_(resource)
         , index_to_mapper_(resource)
         , index_to_address_(resource)
         , index_to_name_(resource)
-        , storage_(resource) {
+        , storage_(resource)
+        , pending_(resource) {
     }
 
     auto index_engine_t::add_index(const keys_base_storage_t& keys, index_ptr index) -> uint32_t {
@@ -149,6 +110,7 @@ namespace components::index {
             index_to_address_.erase(index->disk_agent());
         }
         index_to_name_.erase(index->name());
+        pending_.erase(index);
         //index_to_mapper_.erase(index.id); //todo
         mapper_.erase(index->keys_);
         storage_.erase(std::remove_if(storage_.begin(), storage_.end(), equal), storage_.end());
@@ -190,14 +152,28 @@ namespace components::index {
         return nullptr;
     }
 
+    // the keys of indexes are ordered lexicographically, so all the indexes led by key follow one another
+    auto index_engine_t::matching_prefix(const key_t& key) -> std::vector<index_t::pointer> {
+        std::vector<index_t::pointer> result;
+        for (auto it = mapper_.lower_bound(keys_base_storage_t({key}, resource_)); it != mapper_.end(); ++it) {
+            if (it->first.empty() || !(it->first.front() == key)) {
+                break;
+            }
+            result.push_back(it->second);
+        }
+        return result;
+    }
+
     void index_engine_t::insert_document(const document_ptr& document, pipeline::context_t* pipeline_context) {
         for (auto& index : storage_) {
-            if (is_match_document(index, document)) {
-                auto key = get_value_by_index(index, document);
+            auto key = index->entry(document);
+            if (!key.empty()) {
                 index->insert(key, document);
                 if (index->is_disk() && pipeline_context) {
-                    pipeline_context->send(index->disk_agent(), services::index::handler_id(services::index::route::insert),
-                                           key, document::get_document_id(document));
+                    auto& batch = pending_[index.get()];
+                    for (const auto& stored_key : index->stored_keys(key)) {
+                        batch.push_back(services::index::make_delta(services::index::delta_type::insert, stored_key, document::get_document_id(document), index->compare_type()));
+                    }
                 }
             }
         }
@@ -205,17 +181,30 @@ namespace components::index {
 
     void index_engine_t::delete_document(const document_ptr& document, pipeline::context_t* pipeline_context) {
         for (auto& index : storage_) {
-            if (is_match_document(index, document)) {
-                auto key = get_value_by_index(index, document);
-                index->remove(key); //todo: bug
+            auto key = index->entry(document);
+            if (!key.empty()) {
+                index->remove(key, document::get_document_id(document));
                 if (index->is_disk() && pipeline_context) {
-                    pipeline_context->send(index->disk_agent(), services::index::handler_id(services::index::route::remove),
-                                           key, document::get_document_id(document));
+                    auto& batch = pending_[index.get()];
+                    for (const auto& stored_key : index->stored_keys(key)) {
+                        batch.push_back(services::index::make_delta(services::index::delta_type::remove, stored_key, document::get_document_id(document), index->compare_type()));
+                    }
                 }
             }
         }
     }
 
+    void index_engine_t::flush(pipeline::context_t* pipeline_context) {
+        if (pipeline_context) {
+            for (auto& [index, batch] : pending_) {
+                if (!batch.empty()) {
+                    pipeline_context->send(index->disk_agent(), services::index::handler_id(services::index::route::batch), std::move(batch));
+                }
+            }
+        }
+        pending_.clear();
+    }
+
     auto index_engine_t::indexes() -> std::vector<std::string> {
         std::vector<std::string> res;
         res.reserve(storage_.size());
@@ -233,17 +222,4 @@ namespace components::index {
         }
     }
 
-    void sync_index_from_disk(const index_engine_ptr& ptr,
-                              const actor_zeta::address_t& index_address,
-                              const std::pmr::vector<document::document_id_t>& ids,
-                              const core::pmr::btree::btree_t<document::document_id_t, document_ptr> &storage) {
-        auto* index = search_index(ptr, index_address);
-        if (index) {
-            index->clean_memory_to_new_elements(ids.size());
-            for (const auto &id : ids) {
-                index->insert(storage.find(id)->second);
-            }
-        }
-    }
-
 } // namespace components::index
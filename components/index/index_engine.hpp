@@ -11,6 +11,7 @@
 #include "core/pmr.hpp"
 #include "forward.hpp"
 #include "index.hpp"
+#include <components/index/disk/batch.hpp>
 #include <components/pipeline/context.hpp>
 
 namespace components::index {
@@ -22,6 +23,7 @@ namespace components::index {
         auto matching(const keys_base_storage_t& query) -> index_t::pointer;
         auto matching(const actor_zeta::address_t& address) -> index_t::pointer;
         auto matching(const std::string& name) -> index_t::pointer;
+        auto matching_prefix(const key_t& key) -> std::vector<index_t::pointer>;
         auto add_index(const keys_base_storage_t&, index_ptr) -> uint32_t;
         auto add_disk_agent(id_index id, actor_zeta::address_t address) -> void;
         auto drop_index(index_t::pointer index) -> void;
@@ -30,6 +32,8 @@ namespace components::index {
 
         void insert_document(const document_ptr& document, pipeline::context_t *pipeline_context);
         void delete_document(const document_ptr& document, pipeline::context_t *pipeline_context);
+        // changes to disk indexes are kept until the statement ends, then each index agent gets them as one batch
+        void flush(pipeline::context_t *pipeline_context);
 
         auto indexes() -> std::vector<std::string>;
 
@@ -41,6 +45,7 @@ namespace components::index {
         using index_to_doc_t = std::pmr::unordered_map<id_index, index_t::pointer>;
         using index_to_address_t = std::pmr::map<actor_zeta::address_t, index_t::pointer>;
         using index_to_name_t = std::pmr::unordered_map<std::string, index_t::pointer>;
+        using pending_batches_t = std::pmr::unordered_map<index_t::pointer, services::index::batch_t>;
 
         actor_zeta::detail::pmr::memory_resource* resource_;
         keys_to_doc_t mapper_;
@@ -48,6 +53,7 @@ namespace components::index {
         index_to_address_t index_to_address_;
         index_to_name_t index_to_name_;
         base_storage storage_;
+        pending_batches_t pending_;
     };
 
     using index_engine_ptr = core::pmr::unique_ptr<index_engine_t>;
@@ -57,6 +63,7 @@ namespace components::index {
     auto search_index(const index_engine_ptr& ptr, const keys_base_storage_t& query) -> index_t::pointer;
     auto search_index(const index_engine_ptr& ptr, const actor_zeta::address_t& address) -> index_t::pointer;
     auto search_index(const index_engine_ptr& ptr, const std::string& name) -> index_t::pointer;
+    auto search_indexes_by_prefix(const index_engine_ptr& ptr, const key_t& key) -> std::vector<index_t::pointer>;
 
     template<class Target, class... Args>
     auto make_index(index_engine_ptr& ptr, std::string name, const keys_base_storage_t& keys, Args&&... args) -> uint32_t {
@@ -79,9 +86,5 @@ namespace components::index {
     void find(const index_engine_ptr& index, query_t query, result_set_t*);
 
     void set_disk_agent(const index_engine_ptr& ptr, id_index id, const actor_zeta::address_t& address);
-    void sync_index_from_disk(const index_engine_ptr& ptr,
-                              const actor_zeta::address_t& index_address,
-                              const std::pmr::vector<document::document_id_t>& ids,
-                              const core::pmr::btree::btree_t<document::document_id_t, document_ptr> &storage);
 
 } // namespace components::index
\ No newline at end of file
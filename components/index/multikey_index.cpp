@@ -0,0 +1,132 @@
+#include "multikey_index.hpp"
+
+#include <algorithm>
+
+#include <components/document/core/array.hpp>
+
+namespace components::index {
+
+    multikey_index_t::multikey_index_t(std::pmr::memory_resource* resource, std::string name, const keys_base_storage_t& keys)
+        : index_t(resource, ql::index_type::multikey, std::move(name), keys)
+        , storage_(resource) {}
+
+    multikey_index_t::~multikey_index_t() = default;
+
+    index_t::iterator::reference multikey_index_t::impl_t::value_ref() const {
+        return iterator_->second;
+    }
+
+    index_t::iterator_t::iterator_impl_t* multikey_index_t::impl_t::next() {
+        iterator_++;
+        return this;
+    }
+
+    index_t::iterator_t::iterator_impl_t* multikey_index_t::impl_t::prev() {
+        iterator_--;
+        return this;
+    }
+
+    bool multikey_index_t::impl_t::equals(const iterator_impl_t* other) const {
+        return iterator_ == dynamic_cast<const impl_t *>(other)->iterator_;
+    }
+
+    bool multikey_index_t::impl_t::not_equals(const iterator_impl_t* other) const {
+        return iterator_ != dynamic_cast<const impl_t *>(other)->iterator_;
+    }
+
+    index_t::iterator::iterator_impl_t *multikey_index_t::impl_t::copy() const {
+        return new impl_t(*this);
+    }
+
+    multikey_index_t::impl_t::impl_t(const_iterator iterator)
+        : iterator_(iterator) {
+    }
+
+    // sorted and without repeats, so a document is stored once per element however often the array holds it
+    composite_value_t multikey_index_t::elements(const value_t& value) const {
+        composite_value_t result(resource());
+        if (!value) {
+            return result;
+        }
+        if (value->type() == ::document::impl::value_type::array) {
+            for (auto it = value->as_array()->begin(); it; ++it) {
+                result.emplace_back(it.value());
+            }
+        } else {
+            result.push_back(value);
+        }
+        std::sort(result.begin(), result.end());
+        result.erase(std::unique(result.begin(), result.end()), result.end());
+        return result;
+    }
+
+    auto multikey_index_t::insert_impl(value_t key, index_value_t value) -> void {
+        for (const auto& element : elements(key)) {
+            storage_.insert({element, value});
+        }
+    }
+
+    auto multikey_index_t::insert_impl(document::document_ptr doc) -> void {
+        auto id = document::get_document_id(doc);
+        insert_impl(index::value_t{key_paths().front().get(doc)}, {id, std::move(doc)});
+    }
+
+    auto multikey_index_t::remove_impl(value_t key) -> void {
+        for (const auto& element : elements(key)) {
+            auto it = storage_.find(element);
+            if (it != storage_.end()) {
+                storage_.erase(it);
+            }
+        }
+    }
+
+    auto multikey_index_t::remove_impl(const composite_value_t& values, const document::document_id_t& id) -> void {
+        assert(!values.empty());
+        for (const auto& element : elements(values.front())) {
+            auto range = storage_.equal_range(element);
+            auto it = std::find_if(range.first, range.second, [&id](const storage_t::value_type& entry) {
+                return entry.second.id == id;
+            });
+            if (it != range.second) {
+                storage_.erase(it);
+            }
+        }
+    }
+
+    index_t::range multikey_index_t::find_impl(const value_t& value) const {
+        auto range = storage_.equal_range(value);
+        return std::make_pair(iterator(new impl_t(range.first)), iterator(new impl_t(range.second)));
+    }
+
+    index_t::range multikey_index_t::lower_bound_impl(const value_t& value) const {
+        auto it = storage_.lower_bound(value);
+        return std::make_pair(cbegin(), index_t::iterator(new impl_t(it)));
+    }
+
+    index_t::range multikey_index_t::upper_bound_impl(const value_t& value) const {
+        auto it = storage_.upper_bound(value);
+        return std::make_pair(index_t::iterator(new impl_t(it)), cend());
+    }
+
+    index_t::iterator multikey_index_t::cbegin_impl() const {
+        return index_t::iterator(new impl_t(storage_.cbegin()));
+    }
+
+    index_t::iterator multikey_index_t::cend_impl() const {
+        return index_t::iterator(new impl_t(storage_.cend()));
+    }
+
+    std::pmr::vector<composite_value_t> multikey_index_t::stored_keys_impl(const composite_value_t& entry) const {
+        assert(!entry.empty());
+        std::pmr::vector<composite_value_t> keys(resource());
+        for (const auto& element : elements(entry.front())) {
+            keys.emplace_back(1, element);
+        }
+        return keys;
+    }
+
+    void multikey_index_t::clean_memory_to_new_elements_impl(std::size_t) {
+        storage_.clear();
+    }
+
+} // namespace components::index
@@ -1,5 +1,8 @@
 #include "single_field_index.hpp"
 
+#include <algorithm>
+#include <cassert>
+
 namespace components::index {
 
     single_field_index_t::single_field_index_t(std::pmr::memory_resource* resource, std::string name, const keys_base_storage_t& keys)
@@ -16,6 +19,11 @@ namespace components::index {
         return this;
     }
 
+    index_t::iterator_t::iterator_impl_t* single_field_index_t::impl_t::prev() {
+        iterator_--;
+        return this;
+    }
+
     bool single_field_index_t::impl_t::equals(const iterator_impl_t* other) const {
         return iterator_ == dynamic_cast<const impl_t *>(other)->iterator_; //todo
     }
@@ -37,13 +45,26 @@ namespace components::index {
     }
 
     auto single_field_index_t::insert_impl(document::document_ptr doc) -> void {
-        auto view = document::document_view_t{doc};
         auto id = document::get_document_id(doc);
-        insert_impl(index::value_t{view.get_value(keys().first->as_string())}, {id, std::move(doc)});
+        insert_impl(index::value_t{key_paths().front().get(doc)}, {id, std::move(doc)});
     }
 
     auto single_field_index_t::remove_impl(components::index::value_t key) -> void {
-        storage_.erase(storage_.find(key));
+        auto it = storage_.find(key);
+        if (it != storage_.end()) {
+            storage_.erase(it);
+        }
+    }
+
+    auto single_field_index_t::remove_impl(const composite_value_t& values, const document::document_id_t& id) -> void {
+        assert(!values.empty());
+        auto range = storage_.equal_range(values.front());
+        auto it = std::find_if(range.first, range.second, [&id](const storage_t::value_type& entry) {
+            return entry.second.id == id;
+        });
+        if (it != range.second) {
+            storage_.erase(it);
+        }
     }
 
     index_t::range single_field_index_t::find_impl(const value_t& value) const {
@@ -24,6 +24,7 @@ namespace components::index {
             explicit impl_t(const_iterator iterator);
             index_t::iterator::reference value_ref() const final;
             iterator_impl_t* next() final;
+            iterator_impl_t* prev() final;
             bool equals(const iterator_impl_t* other) const final;
             bool not_equals(const iterator_impl_t* other) const final;
             iterator_impl_t *copy() const final;
@@ -35,6 +36,7 @@ namespace components::index {
         auto insert_impl(value_t key, index_value_t value) -> void final;
         auto insert_impl(document::document_ptr doc) -> void final;
         auto remove_impl(value_t key) -> void final;
+        auto remove_impl(const composite_value_t& values, const document::document_id_t& id) -> void final;
         range find_impl(const value_t& value) const final;
         range lower_bound_impl(const value_t& value) const final;
         range upper_bound_impl(const value_t& value) const final;
@@ -0,0 +1,110 @@
+#include <catch2/catch.hpp>
+
+#include <actor-zeta/detail/pmr/default_resource.hpp>
+#include <actor-zeta/detail/pmr/memory_resource.hpp>
+
+#include "components/index/composite_field_index.hpp"
+#include "components/index/index_engine.hpp"
+#include "components/tests/generaty.hpp"
+
+using namespace components::index;
+using key = components::expressions::key_t;
+
+namespace {
+
+    document_ptr gen_group_doc(int num) {
+        auto doc = document::impl::dict_t::new_dict();
+        doc->set("_id", gen_id(num));
+        doc->set("group", num % 4);
+        doc->set("count", num);
+        return make_document(doc);
+    }
+
+    composite_value_t make_values(std::pmr::memory_resource* resource,
+                                  std::vector<document::retained_const_t<document::impl::value_t>>& holder,
+                                  std::initializer_list<int> values) {
+        composite_value_t result(resource);
+        for (auto value : values) {
+            holder.emplace_back(document::impl::new_value(value));
+            result.emplace_back(holder.back().get());
+        }
+        return result;
+    }
+
+} // namespace
+
+TEST_CASE("composite_field_index:base") {
+    auto* resource = actor_zeta::detail::pmr::get_default_resource();
+    auto index_engine = make_index_engine(resource);
+    auto id = make_index<composite_field_index_t>(index_engine, "composite_group_count", {key("group"), key("count")});
+    std::pmr::vector<document_ptr> docs(resource);
+    for (int i = 100; i >= 1; --i) {
+        docs.push_back(gen_group_doc(i));
+    }
+    insert(index_engine, id, docs);
+    auto* index = search_index(index_engine, id);
+    REQUIRE(index->type() == components::ql::index_type::composite);
+    std::vector<document::retained_const_t<document::impl::value_t>> holder;
+
+    SECTION("order") {
+        int prev_group = -1;
+        int prev_count = -1;
+        for (auto it = index->cbegin(); it != index->cend(); ++it) {
+            document_view_t view(it->doc);
+            auto group = int(view.get_long("group"));
+            auto count = int(view.get_long("count"));
+            REQUIRE((group > prev_group || (group == prev_group && count > prev_count)));
+            prev_group = group;
+            prev_count = count;
+        }
+    }
+
+    SECTION("find::full_key") {
+        auto range = index->find(make_values(resource, holder, {1, 53}));
+        REQUIRE(std::distance(range.first, range.second) == 1);
+        REQUIRE(document_view_t(range.first->doc).get_long("count") == 53);
+        range = index->find(make_values(resource, holder, {2, 53}));
+        REQUIRE(range.first == range.second);
+    }
+
+    SECTION("delete::same_key") {
+        auto doc = gen_group_doc(101);
+        doc->set("group", 1);
+        doc->set("count", 53);
+        index_engine->insert_document(doc, nullptr);
+        index_engine->delete_document(doc, nullptr);
+        auto range = index->find(make_values(resource, holder, {1, 53}));
+        REQUIRE(std::distance(range.first, range.second) == 1);
+        REQUIRE(document_view_t(range.first->doc).get_string("_id") == gen_id(53));
+    }
+
+    SECTION("find::prefix") {
+        auto range = index->find(make_values(resource, holder, {1}));
+        REQUIRE(std::distance(range.first, range.second) == 25);
+        REQUIRE(document_view_t(range.first->doc).get_long("count") == 1);
+        for (auto it = range.first; it != range.second; ++it) {
+            REQUIRE(document_view_t(it->doc).get_long("group") == 1);
+        }
+    }
+
+    SECTION("find::prefix_and_range") {
+        auto prefix = index->find(make_values(resource, holder, {1}));
+        auto upper = index->upper_bound(make_values(resource, holder, {1, 50}));
+        REQUIRE(std::distance(upper.first, prefix.second) == 12);
+        REQUIRE(document_view_t(upper.first->doc).get_long("count") == 53);
+        auto lower = index->lower_bound(make_values(resource, holder, {1, 50}));
+        REQUIRE(std::distance(prefix.first, lower.second) == 13);
+    }
+
+    SECTION("single_value") {
+        auto value = ::document::impl::new_value(3);
+        auto range = index->find(value_t(value));
+        REQUIRE(std::distance(range.first, range.second) == 25);
+    }
+
+    SECTION("remove") {
+        index->remove(make_values(resource, holder, {1, 53}));
+        auto range = index->find(make_values(resource, holder, {1}));
+        REQUIRE(std::distance(range.first, range.second) == 24);
+    }
+}
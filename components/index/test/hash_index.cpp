@@ -0,0 +1,112 @@
+#include <catch2/catch.hpp>
+
+#include <actor-zeta/detail/pmr/default_resource.hpp>
+#include <actor-zeta/detail/pmr/memory_resource.hpp>
+
+#include "components/index/hash_index.hpp"
+#include "components/index/index_engine.hpp"
+#include "components/tests/generaty.hpp"
+
+using namespace components::index;
+using key = components::expressions::key_t;
+
+TEST_CASE("hash_index:base") {
+    auto* resource = actor_zeta::detail::pmr::get_default_resource();
+    hash_index_t index(resource, "hash_count", {key("count")});
+    REQUIRE(index.cbegin() == index.cend());
+    for (int i = 1; i <= 1000; ++i) {
+        auto doc = gen_doc(i);
+        document_view_t view(doc);
+        index.insert(document::wrapper_value_t(view.get_value(std::string_view("count"))), doc);
+    }
+    REQUIRE(std::distance(index.cbegin(), index.cend()) == 1000);
+
+    SECTION("find") {
+        for (int i : {1, 10, 500, 1000}) {
+            auto value = ::document::impl::new_value(i);
+            auto range = index.find(value_t(value));
+            REQUIRE(std::distance(range.first, range.second) == 1);
+            REQUIRE(document_view_t(range.first->doc).get_long("count") == i);
+        }
+        auto value = ::document::impl::new_value(1001);
+        auto range = index.find(value_t(value));
+        REQUIRE(range.first == range.second);
+    }
+
+    SECTION("find::duplicates") {
+        for (int i : {10, 10, 20}) {
+            auto doc = gen_doc(i);
+            document_view_t view(doc);
+            index.insert(document::wrapper_value_t(view.get_value(std::string_view("count"))), doc);
+        }
+        auto value = ::document::impl::new_value(10);
+        auto range = index.find(value_t(value));
+        REQUIRE(std::distance(range.first, range.second) == 3);
+        for (auto it = range.first; it != range.second; ++it) {
+            REQUIRE(document_view_t(it->doc).get_long("count") == 10);
+        }
+    }
+
+    SECTION("ne") {
+        auto value = ::document::impl::new_value(500);
+        auto lower = index.lower_bound(value_t(value));
+        auto upper = index.upper_bound(value_t(value));
+        REQUIRE(std::distance(lower.first, lower.second) + std::distance(upper.first, upper.second) == 999);
+        for (auto it = lower.first; it != lower.second; ++it) {
+            REQUIRE(document_view_t(it->doc).get_long("count") != 500);
+        }
+        for (auto it = upper.first; it != upper.second; ++it) {
+            REQUIRE(document_view_t(it->doc).get_long("count") != 500);
+        }
+    }
+
+    SECTION("remove") {
+        for (int i = 1; i <= 1000; i += 2) {
+            auto value = ::document::impl::new_value(i);
+            index.remove(value_t(value));
+        }
+        REQUIRE(std::distance(index.cbegin(), index.cend()) == 500);
+        for (int i = 1; i <= 1000; ++i) {
+            auto value = ::document::impl::new_value(i);
+            auto range = index.find(value_t(value));
+            REQUIRE(std::distance(range.first, range.second) == (i % 2 == 0 ? 1 : 0));
+        }
+    }
+
+    SECTION("backward") {
+        int count = 0;
+        auto it = index.cend();
+        while (it != index.cbegin()) {
+            --it;
+            ++count;
+        }
+        REQUIRE(count == 1000);
+    }
+}
+
+TEST_CASE("hash_index:engine") {
+    auto* resource = actor_zeta::detail::pmr::get_default_resource();
+    auto index_engine = make_index_engine(resource);
+    auto id = make_index<hash_index_t>(index_engine, "hash_count_str", {key("countStr")});
+    std::pmr::vector<document_ptr> docs(resource);
+    for (int i = 1; i <= 100; ++i) {
+        docs.push_back(gen_doc(i));
+    }
+    insert(index_engine, id, docs);
+    auto* index = search_index(index_engine, id);
+    REQUIRE(index->type() == components::ql::index_type::hashed);
+    auto value = ::document::impl::new_value(std::string_view("42"));
+    auto range = index->find(value_t(value));
+    REQUIRE(std::distance(range.first, range.second) == 1);
+    REQUIRE(document_view_t(range.first->doc).get_long("count") == 42);
+
+    SECTION("delete::same_key") {
+        auto doc = gen_doc(101);
+        doc->set("countStr", std::string_view("42"));
+        index_engine->insert_document(doc, nullptr);
+        index_engine->delete_document(doc, nullptr);
+        range = index->find(value_t(value));
+        REQUIRE(std::distance(range.first, range.second) == 1);
+        REQUIRE(document_view_t(range.first->doc).get_string("_id") == gen_id(42));
+    }
+}
@@ -0,0 +1,90 @@
+#include <catch2/catch.hpp>
+
+#include <actor-zeta/detail/pmr/default_resource.hpp>
+#include <actor-zeta/detail/pmr/memory_resource.hpp>
+
+#include "components/index/index_engine.hpp"
+#include "components/index/multikey_index.hpp"
+#include "components/tests/generaty.hpp"
+
+using namespace components::index;
+using key = components::expressions::key_t;
+
+namespace {
+
+    // tags of the document i: its divisors up to 5, with 1 repeated; the document 7 has a scalar tag, 11 an empty array
+    document_ptr gen_tags_doc(int i) {
+        auto doc = document::impl::dict_t::new_dict();
+        doc->set("_id", gen_id(i));
+        if (i == 7) {
+            doc->set("tags", 7);
+        } else {
+            auto tags = document::impl::array_t::new_array();
+            if (i != 11) {
+                tags->append(1);
+                tags->append(1);
+                for (int d = 2; d <= 5; ++d) {
+                    if (i % d == 0) {
+                        tags->append(d);
+                    }
+                }
+            }
+            doc->set("tags", tags);
+        }
+        return make_document(doc);
+    }
+
+    std::ptrdiff_t count(const index_t* index, int value) {
+        auto key = ::document::impl::new_value(value);
+        auto range = index->find(value_t(key));
+        return std::distance(range.first, range.second);
+    }
+
+} // namespace
+
+TEST_CASE("multikey_index:base") {
+    auto* resource = actor_zeta::detail::pmr::get_default_resource();
+    auto engine = make_index_engine(resource);
+    keys_base_storage_t keys({key("tags")}, resource);
+    auto id = make_index<multikey_index_t>(engine, "multikey_tags", keys);
+    for (int i = 1; i <= 30; ++i) {
+        engine->insert_document(gen_tags_doc(i), nullptr);
+    }
+    auto* index = search_index(engine, id);
+    REQUIRE(index->type() == components::ql::index_type::multikey);
+    REQUIRE(count(index, 1) == 28);
+    REQUIRE(count(index, 2) == 15);
+    REQUIRE(count(index, 3) == 10);
+    REQUIRE(count(index, 4) == 7);
+    REQUIRE(count(index, 5) == 6);
+    REQUIRE(count(index, 7) == 1);
+    REQUIRE(count(index, 6) == 0);
+    REQUIRE(std::distance(index->cbegin(), index->cend()) == 28 + 15 + 10 + 7 + 6 + 1);
+
+    engine->delete_document(gen_tags_doc(30), nullptr);
+    engine->delete_document(gen_tags_doc(7), nullptr);
+    engine->delete_document(gen_tags_doc(11), nullptr);
+    REQUIRE(count(index, 1) == 27);
+    REQUIRE(count(index, 2) == 14);
+    REQUIRE(count(index, 3) == 9);
+    REQUIRE(count(index, 5) == 5);
+    REQUIRE(count(index, 7) == 0);
+    auto five = ::document::impl::new_value(5);
+    auto range = index->find(value_t(five));
+    for (auto it = range.first; it != range.second; ++it) {
+        REQUIRE_FALSE(it->id == components::document::document_id_t(gen_id(30)));
+    }
+}
+
+TEST_CASE("multikey_index:stored_keys") {
+    auto* resource = actor_zeta::detail::pmr::get_default_resource();
+    multikey_index_t index(resource, "multikey_tags", {key("tags")});
+    auto keys = index.stored_keys(index.entry(gen_tags_doc(6)));
+    REQUIRE(keys.size() == 3);
+    REQUIRE(keys.at(0).size() == 1);
+    REQUIRE(keys.at(0).front()->as_int() == 1);
+    REQUIRE(keys.at(1).front()->as_int() == 2);
+    REQUIRE(keys.at(2).front()->as_int() == 3);
+    REQUIRE(index.stored_keys(index.entry(gen_tags_doc(7))).size() == 1);
+    REQUIRE(index.stored_keys(index.entry(gen_tags_doc(11))).empty());
+}
@@ -97,6 +97,18 @@ TEST_CASE("single_field_index:engine") {
     }
 
     insert(index_engine, id, data);
+
+    SECTION("delete::same_key") {
+        auto doc = gen_doc(11);
+        doc->set("count", 5);
+        index_engine->insert_document(doc, nullptr);
+        index_engine->delete_document(doc, nullptr);
+        auto value = ::document::impl::new_value(5);
+        auto range = search_index(index_engine, id)->find(components::index::value_t(value));
+        REQUIRE(std::distance(range.first, range.second) == 1);
+        REQUIRE(document_view_t(range.first->doc).get_string("_id") == gen_id(5));
+    }
+
     auto address = actor_zeta::address_t::empty_address();
     ///result_set_t set(resource, address);
 
@@ -0,0 +1,102 @@
+#include <catch2/catch.hpp>
+
+#include <actor-zeta/detail/pmr/default_resource.hpp>
+#include <actor-zeta/detail/pmr/memory_resource.hpp>
+
+#include "components/index/index_engine.hpp"
+#include "components/index/single_field_index.hpp"
+#include "components/tests/generaty.hpp"
+
+using namespace components::index;
+using key = components::expressions::key_t;
+
+namespace {
+
+    // count is always set, flag is set for i % 10 == 0, null for i % 10 == 5 and missing otherwise
+    document_ptr gen_flag_doc(int i) {
+        auto doc = document::impl::dict_t::new_dict();
+        doc->set("_id", gen_id(i));
+        doc->set("count", i);
+        if (i % 10 == 0) {
+            doc->set("flag", i);
+        } else if (i % 10 == 5) {
+            doc->set("flag", nullptr);
+        }
+        return make_document(doc);
+    }
+
+    // half of the documents arrive one by one, the other half in bulk, as on an index creation
+    index_t* fill_index(index_engine_ptr& engine, id_index id) {
+        std::pmr::vector<document_ptr> docs(engine->resource());
+        for (int i = 1; i <= 100; ++i) {
+            if (i % 2 == 0) {
+                engine->insert_document(gen_flag_doc(i), nullptr);
+            } else {
+                docs.push_back(gen_flag_doc(i));
+            }
+        }
+        insert(engine, id, docs);
+        return search_index(engine, id);
+    }
+
+    std::ptrdiff_t size(const index_t* index) {
+        return std::distance(index->cbegin(), index->cend());
+    }
+
+} // namespace
+
+TEST_CASE("sparse_partial_index:full") {
+    auto* resource = actor_zeta::detail::pmr::get_default_resource();
+    auto engine = make_index_engine(resource);
+    keys_base_storage_t keys({key("flag")}, resource);
+    auto id = make_index<single_field_index_t>(engine, "single_flag", keys);
+    auto* index = fill_index(engine, id);
+    REQUIRE_FALSE(index->is_sparse());
+    REQUIRE_FALSE(index->is_partial());
+    REQUIRE(size(index) == 20);
+    auto null = ::document::impl::new_value(nullptr);
+    REQUIRE(std::distance(index->find(value_t(null)).first, index->find(value_t(null)).second) == 10);
+}
+
+TEST_CASE("sparse_partial_index:sparse") {
+    auto* resource = actor_zeta::detail::pmr::get_default_resource();
+    auto engine = make_index_engine(resource);
+    keys_base_storage_t keys({key("flag")}, resource);
+    auto id = make_index<single_field_index_t>(engine, "single_flag", keys);
+    search_index(engine, id)->set_sparse(true);
+    auto* index = fill_index(engine, id);
+    REQUIRE(index->is_sparse());
+    REQUIRE(size(index) == 10);
+    for (auto it = index->cbegin(); it != index->cend(); ++it) {
+        REQUIRE(document_view_t(it->doc).get_long("flag") % 10 == 0);
+    }
+
+    engine->delete_document(gen_flag_doc(20), nullptr);
+    engine->delete_document(gen_flag_doc(25), nullptr);
+    engine->delete_document(gen_flag_doc(27), nullptr);
+    REQUIRE(size(index) == 9);
+}
+
+TEST_CASE("sparse_partial_index:partial") {
+    auto* resource = actor_zeta::detail::pmr::get_default_resource();
+    auto engine = make_index_engine(resource);
+    keys_base_storage_t keys({key("count")}, resource);
+    auto id = make_index<single_field_index_t>(engine, "single_count", keys);
+    components::ql::storage_parameters parameters;
+    components::ql::add_parameter(parameters, core::parameter_id_t(1), 90);
+    search_index(engine, id)->set_partial_filter(
+        components::expressions::make_compare_expression(resource, components::expressions::compare_type::gt, key("count"), core::parameter_id_t(1)),
+        std::move(parameters),
+        [](const document_ptr& doc) {
+            return document_view_t(doc).get_long("count") > 90;
+        });
+    auto* index = fill_index(engine, id);
+    REQUIRE(index->is_partial());
+    REQUIRE(size(index) == 10);
+    REQUIRE(document_view_t(index->cbegin()->doc).get_long("count") == 91);
+
+    engine->delete_document(gen_flag_doc(10), nullptr);
+    REQUIRE(size(index) == 10);
+    engine->delete_document(gen_flag_doc(100), nullptr);
+    REQUIRE(size(index) == 9);
+}
@@ -0,0 +1,111 @@
+#include <catch2/catch.hpp>
+
+#include <actor-zeta/detail/pmr/default_resource.hpp>
+#include <actor-zeta/detail/pmr/memory_resource.hpp>
+
+#include "components/index/index_engine.hpp"
+#include "components/index/wildcard_index.hpp"
+#include "components/tests/generaty.hpp"
+
+using namespace components::index;
+using key = components::expressions::key_t;
+
+namespace {
+
+    template<class T>
+    std::ptrdiff_t count(const index_t* index, std::string_view path, T value) {
+        auto path_value = ::document::impl::new_value(path);
+        auto value_value = ::document::impl::new_value(value);
+        composite_value_t values(index->resource());
+        values.emplace_back(path_value.get());
+        values.emplace_back(value_value.get());
+        auto range = index->find(values);
+        return std::distance(range.first, range.second);
+    }
+
+} // namespace
+
+TEST_CASE("wildcard_index:base") {
+    auto* resource = actor_zeta::detail::pmr::get_default_resource();
+    auto engine = make_index_engine(resource);
+    keys_base_storage_t keys({key(wildcard_index_t::key)}, resource);
+    auto id = make_index<wildcard_index_t>(engine, "wildcard", keys);
+    for (int i = 1; i <= 100; ++i) {
+        engine->insert_document(gen_doc(i), nullptr);
+    }
+    auto* index = static_cast<wildcard_index_t*>(search_index(engine, id));
+    REQUIRE(index->type() == components::ql::index_type::wildcard);
+    REQUIRE(count(index, "count", 10) == 1);
+    REQUIRE(count(index, "countStr", std::string_view("10")) == 1);
+    REQUIRE(count(index, "countDict.odd", true) == 50);
+    REQUIRE(count(index, "countDict.three", true) == 33);
+    REQUIRE(count(index, "countArray", 10) == 5);
+    REQUIRE(count(index, "mixedDict.10.five", true) == 5);
+    REQUIRE(count(index, "_id", std::string_view(gen_id(10))) == 0);
+
+    REQUIRE(index->is_scalar_path("count"));
+    REQUIRE(index->is_scalar_path("countDict.odd"));
+    REQUIRE_FALSE(index->is_scalar_path("countDict"));
+    REQUIRE_FALSE(index->is_scalar_path("countArray"));
+    REQUIRE(index->is_under_array("countArray.0"));
+    REQUIRE(index->is_under_array("dictArray.0.number"));
+    REQUIRE_FALSE(index->is_under_array("countArray"));
+    REQUIRE_FALSE(index->is_under_array("countDict.odd"));
+
+    engine->delete_document(gen_doc(10), nullptr);
+    REQUIRE(count(index, "count", 10) == 0);
+    REQUIRE(count(index, "countDict.odd", true) == 50);
+    REQUIRE(count(index, "countDict.odd", false) == 49);
+    REQUIRE(count(index, "countArray", 10) == 4);
+}
+
+TEST_CASE("wildcard_index:paths") {
+    auto* resource = actor_zeta::detail::pmr::get_default_resource();
+    keys_base_storage_t include({key("countDict"), key("count")}, resource);
+    keys_base_storage_t exclude({key("countDict.five")}, resource);
+    wildcard_index_t index(resource, "wildcard", {key(wildcard_index_t::key)}, include, exclude);
+    REQUIRE(index.is_indexed_path("count"));
+    REQUIRE(index.is_indexed_path("countDict.odd"));
+    REQUIRE_FALSE(index.is_indexed_path("countDict.five"));
+    REQUIRE_FALSE(index.is_indexed_path("countStr"));
+    REQUIRE_FALSE(index.is_indexed_path("_id"));
+
+    // keys are built for the documents of the index
+    auto doc = gen_doc(15);
+    index.insert(index.entry(doc), doc);
+    auto keys = index.stored_keys(index.entry(doc));
+    REQUIRE(keys.size() == 4);
+    REQUIRE(keys.front().size() == 2);
+    REQUIRE(keys.front().front()->as_string() == "count");
+    REQUIRE(keys.front().back()->as_int() == 15);
+    REQUIRE(keys.back().front()->as_string() == "countDict.three");
+    REQUIRE(keys.back().back()->as_bool());
+}
+
+TEST_CASE("wildcard_index:unused paths") {
+    auto* resource = actor_zeta::detail::pmr::get_default_resource();
+    auto engine = make_index_engine(resource);
+    keys_base_storage_t keys({key(wildcard_index_t::key)}, resource);
+    auto id = make_index<wildcard_index_t>(engine, "wildcard", keys);
+    auto* index = static_cast<wildcard_index_t*>(search_index(engine, id));
+    auto doc_array = components::document::document_from_json(R"({"_id": ")" + gen_id(1) + R"(", "tags": [1, 2], "flag": true})");
+    auto doc_scalar = components::document::document_from_json(R"({"_id": ")" + gen_id(2) + R"(", "tags": 3, "flag": false})");
+    engine->insert_document(doc_array, nullptr);
+    engine->insert_document(doc_scalar, nullptr);
+    REQUIRE_FALSE(index->is_scalar_path("tags"));
+    REQUIRE(count(index, "tags", 1) == 1);
+
+    // once the last document holding an array at the path is gone, the path is scalar again
+    engine->delete_document(doc_array, nullptr);
+    REQUIRE(index->is_scalar_path("tags"));
+    REQUIRE(count(index, "tags", 1) == 0);
+    REQUIRE(count(index, "tags", 3) == 1);
+
+    // the last document under the paths is gone, the keys of the document just removed can still be built
+    engine->delete_document(doc_scalar, nullptr);
+    REQUIRE(index->stored_keys(index->entry(doc_scalar)).size() == 2);
+
+    engine->insert_document(doc_array, nullptr);
+    REQUIRE(count(index, "tags", 2) == 1);
+    REQUIRE(count(index, "flag", false) == 0);
+}
@@ -0,0 +1,315 @@
+#include "wildcard_index.hpp"
+
+#include <algorithm>
+
+#include <components/document/core/array.hpp>
+#include <components/document/core/dict.hpp>
+
+namespace components::index {
+
+    namespace {
+
+        // the path or a path under it
+        bool is_under(const std::string& path, const key_t& prefix) {
+            const auto& str = prefix.as_string();
+            return path.size() >= str.size() && path.compare(0, str.size(), str) == 0 &&
+                   (path.size() == str.size() || path[str.size()] == '.');
+        }
+
+    } // namespace
+
+    wildcard_index_t::wildcard_index_t(std::pmr::memory_resource* resource, std::string name, const keys_base_storage_t& keys)
+        : wildcard_index_t(resource, std::move(name), keys, keys_base_storage_t(resource), keys_base_storage_t(resource)) {}
+
+    wildcard_index_t::wildcard_index_t(std::pmr::memory_resource* resource, std::string name, const keys_base_storage_t& keys,
+                                       const keys_base_storage_t& include, const keys_base_storage_t& exclude)
+        : index_t(resource, ql::index_type::wildcard, std::move(name), keys)
+        , storage_(resource)
+        , include_(include, resource)
+        , exclude_(exclude, resource)
+        , paths_(resource)
+        , unused_paths_(resource)
+        , array_paths_(resource)
+        , dict_paths_(resource) {}
+
+    wildcard_index_t::~wildcard_index_t() = default;
+
+    bool wildcard_index_t::is_indexed_path(const std::string& path) const {
+        if (path == "_id") {
+            return false;
+        }
+        auto is_path_under = [&path](const key_t& prefix) {
+            return is_under(path, prefix);
+        };
+        if (!include_.empty() && std::none_of(include_.begin(), include_.end(), is_path_under)) {
+            return false;
+        }
+        return std::none_of(exclude_.begin(), exclude_.end(), is_path_under);
+    }
+
+    bool wildcard_index_t::is_scalar_path(const std::string& path) const {
+        return array_paths_.find(std::string_view(path)) == array_paths_.end() && dict_paths_.find(std::string_view(path)) == dict_paths_.end();
+    }
+
+    bool wildcard_index_t::is_under_array(const std::string& path) const {
+        for (auto pos = path.find('.'); pos != std::string::npos; pos = path.find('.', pos + 1)) {
+            if (array_paths_.find(std::string_view(path).substr(0, pos)) != array_paths_.end()) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    index_t::iterator::reference wildcard_index_t::impl_t::value_ref() const {
+        return iterator_->second;
+    }
+
+    index_t::iterator_t::iterator_impl_t* wildcard_index_t::impl_t::next() {
+        iterator_++;
+        return this;
+    }
+
+    index_t::iterator_t::iterator_impl_t* wildcard_index_t::impl_t::prev() {
+        iterator_--;
+        return this;
+    }
+
+    bool wildcard_index_t::impl_t::equals(const iterator_impl_t* other) const {
+        return iterator_ == dynamic_cast<const impl_t *>(other)->iterator_;
+    }
+
+    bool wildcard_index_t::impl_t::not_equals(const iterator_impl_t* other) const {
+        return iterator_ != dynamic_cast<const impl_t *>(other)->iterator_;
+    }
+
+    index_t::iterator::iterator_impl_t *wildcard_index_t::impl_t::copy() const {
+        return new impl_t(*this);
+    }
+
+    wildcard_index_t::impl_t::impl_t(const_iterator iterator)
+        : iterator_(iterator) {
+    }
+
+    auto wildcard_index_t::insert_impl(value_t key, index_value_t value) -> void {
+        evict_unused_paths_();
+        count_paths_(*key, {}, true);
+        for (const auto& scalar : scalars(key)) {
+            storage_.insert({make_key(acquire_path_(scalar.path), scalar.value), value});
+        }
+    }
+
+    auto wildcard_index_t::insert_impl(document::document_ptr doc) -> void {
+        auto view = document::document_view_t{doc};
+        auto id = document::get_document_id(doc);
+        insert_impl(index::value_t{view.get_value()}, {id, std::move(doc)});
+    }
+
+    auto wildcard_index_t::remove_impl(value_t key) -> void {
+        evict_unused_paths_();
+        for (const auto& scalar : scalars(key)) {
+            const auto* path = find_path_(scalar.path);
+            if (!path) {
+                continue;
+            }
+            auto it = storage_.find(make_key(*path, scalar.value));
+            if (it != storage_.end()) {
+                storage_.erase(it);
+            }
+            release_path_(scalar.path);
+        }
+        count_paths_(*key, {}, false);
+    }
+
+    auto wildcard_index_t::remove_impl(const composite_value_t& values, const document::document_id_t& id) -> void {
+        assert(!values.empty());
+        evict_unused_paths_();
+        for (const auto& scalar : scalars(values.front())) {
+            const auto* path = find_path_(scalar.path);
+            if (!path) {
+                continue;
+            }
+            auto range = storage_.equal_range(make_key(*path, scalar.value));
+            auto it = std::find_if(range.first, range.second, [&id](const storage_t::value_type& entry) {
+                return entry.second.id == id;
+            });
+            if (it != range.second) {
+                storage_.erase(it);
+            }
+            release_path_(scalar.path);
+        }
+        count_paths_(*values.front(), {}, false);
+    }
+
+    index_t::range wildcard_index_t::find_impl(const value_t& value) const {
+        return find_impl(composite_value_t(1, value, resource()));
+    }
+
+    index_t::range wildcard_index_t::lower_bound_impl(const value_t& value) const {
+        return lower_bound_impl(composite_value_t(1, value, resource()));
+    }
+
+    index_t::range wildcard_index_t::upper_bound_impl(const value_t& value) const {
+        return upper_bound_impl(composite_value_t(1, value, resource()));
+    }
+
+    index_t::range wildcard_index_t::find_impl(const composite_value_t& values) const {
+        auto range = storage_.equal_range(values);
+        return std::make_pair(iterator(new impl_t(range.first)), iterator(new impl_t(range.second)));
+    }
+
+    index_t::range wildcard_index_t::lower_bound_impl(const composite_value_t& values) const {
+        auto it = storage_.lower_bound(values);
+        return std::make_pair(cbegin(), index_t::iterator(new impl_t(it)));
+    }
+
+    index_t::range wildcard_index_t::upper_bound_impl(const composite_value_t& values) const {
+        auto it = storage_.upper_bound(values);
+        return std::make_pair(index_t::iterator(new impl_t(it)), cend());
+    }
+
+    index_t::iterator wildcard_index_t::cbegin_impl() const {
+        return index_t::iterator(new impl_t(storage_.cbegin()));
+    }
+
+    index_t::iterator wildcard_index_t::cend_impl() const {
+        return index_t::iterator(new impl_t(storage_.cend()));
+    }
+
+    std::pmr::vector<composite_value_t> wildcard_index_t::stored_keys_impl(const composite_value_t& entry) const {
+        assert(!entry.empty());
+        std::pmr::vector<composite_value_t> keys(resource());
+        for (const auto& scalar : scalars(entry.front())) {
+            if (const auto* path = find_path_(scalar.path)) {
+                keys.push_back(make_key(*path, scalar.value));
+            }
+        }
+        return keys;
+    }
+
+    // the whole document is the entry, its (path, value) pairs are taken from it on the way into the index
+    composite_value_t wildcard_index_t::entry_impl(const document::document_ptr& document) const {
+        composite_value_t values(resource());
+        const auto* root = document::document_view_t(document).get_value();
+        if (root) {
+            values.emplace_back(root);
+        }
+        return values;
+    }
+
+    // the paths stay counted after the in-memory copy of a disk index is cleaned, they follow the documents of the index
+    void wildcard_index_t::clean_memory_to_new_elements_impl(std::size_t) {
+        storage_.clear();
+    }
+
+    std::vector<wildcard_index_t::path_value_t> wildcard_index_t::scalars(const value_t& root) const {
+        std::vector<path_value_t> result;
+        scalars_(*root, {}, result);
+        std::sort(result.begin(), result.end(), [](const path_value_t& lhs, const path_value_t& rhs) {
+            return lhs.path < rhs.path || (lhs.path == rhs.path && lhs.value < rhs.value);
+        });
+        result.erase(std::unique(result.begin(), result.end(), [](const path_value_t& lhs, const path_value_t& rhs) {
+                         return lhs.path == rhs.path && lhs.value == rhs.value;
+                     }),
+                     result.end());
+        return result;
+    }
+
+    void wildcard_index_t::scalars_(const ::document::impl::value_t* value, const std::string& path, std::vector<path_value_t>& result) const {
+        using ::document::impl::value_type;
+        if (!value) {
+            return;
+        }
+        switch (value->type()) {
+            case value_type::dict:
+                for (auto it = value->as_dict()->begin(); it; ++it) {
+                    auto key = std::string(it.key_string());
+                    scalars_(it.value(), path.empty() ? key : path + "." + key, result);
+                }
+                break;
+            case value_type::array:
+                if (is_indexed_path(path)) {
+                    for (auto it = value->as_array()->begin(); it; ++it) {
+                        auto type = it.value()->type();
+                        if (type != value_type::dict && type != value_type::array) {
+                            result.push_back({path, value_t(it.value())});
+                        }
+                    }
+                }
+                break;
+            default:
+                if (!path.empty() && is_indexed_path(path)) {
+                    result.push_back({path, value_t(value)});
+                }
+                break;
+        }
+    }
+
+    void wildcard_index_t::count_paths_(const ::document::impl::value_t* value, const std::string& path, bool is_insert) {
+        using ::document::impl::value_type;
+        if (!value) {
+            return;
+        }
+        if (value->type() == value_type::dict) {
+            if (!path.empty()) {
+                count_path_(dict_paths_, path, is_insert);
+            }
+            for (auto it = value->as_dict()->begin(); it; ++it) {
+                auto key = std::string(it.key_string());
+                count_paths_(it.value(), path.empty() ? key : path + "." + key, is_insert);
+            }
+        } else if (value->type() == value_type::array) {
+            count_path_(array_paths_, path, is_insert);
+        }
+    }
+
+    void wildcard_index_t::count_path_(path_counts_t& counts, const std::string& path, bool is_insert) {
+        auto it = counts.find(std::string_view(path));
+        if (is_insert) {
+            if (it == counts.end()) {
+                it = counts.emplace(std::string_view(path), 0).first;
+            }
+            ++it->second;
+        } else if (it != counts.end() && --it->second == 0) {
+            counts.erase(it);
+        }
+    }
+
+    const wildcard_index_t::path_t* wildcard_index_t::find_path_(std::string_view path) const {
+        auto it = paths_.find(path);
+        return it == paths_.end() ? nullptr : &it->second;
+    }
+
+    const wildcard_index_t::path_t& wildcard_index_t::acquire_path_(const std::string& path) {
+        auto it = paths_.find(std::string_view(path));
+        if (it == paths_.end()) {
+            it = paths_.emplace(std::string_view(path), path_t{::document::impl::new_value(std::string_view(path)), 0}).first;
+        }
+        ++it->second.count;
+        return it->second;
+    }
+
+    void wildcard_index_t::release_path_(const std::string& path) {
+        auto it = paths_.find(std::string_view(path));
+        if (it != paths_.end() && it->second.count > 0 && --it->second.count == 0) {
+            unused_paths_.push_back(it->first);
+        }
+    }
+
+    void wildcard_index_t::evict_unused_paths_() {
+        for (const auto& path : unused_paths_) {
+            auto it = paths_.find(std::string_view(path));
+            if (it != paths_.end() && it->second.count == 0) {
+                paths_.erase(it);
+            }
+        }
+        unused_paths_.clear();
+    }
+
+    composite_value_t wildcard_index_t::make_key(const path_t& path, value_t value) const {
+        composite_value_t key(resource());
+        key.emplace_back(path.value.get());
+        key.push_back(value);
+        return key;
+    }
+
+} // namespace components::index
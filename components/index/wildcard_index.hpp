@@ -0,0 +1,112 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+
+#include <core/btree/btree.hpp>
+
+#include "composite_field_index.hpp"
+#include "forward.hpp"
+#include "index.hpp"
+
+namespace components::index {
+
+    // index of every scalar reachable in a document through nested dicts: its entries are (path, value)
+    // pairs ordered by path, then value, so the entries of one path form a contiguous range.
+    // The elements of an array are stored under the path of the array, as by a multikey index.
+    // include and exclude limit the indexed paths to the ones under include (all if empty) and not under exclude;
+    // _id is left to the primary key
+    class wildcard_index_t final : public index_t {
+    public:
+        using comparator_t = composite_field_index_t::comparator_t;
+        using storage_t = core::pmr::btree::multi_btree_t<composite_value_t, index_value_t, comparator_t>;
+        using const_iterator = storage_t::const_iterator;
+
+        // the key of wildcard indexes, the planner finds them by it
+        static constexpr const char* key = "$**";
+
+        wildcard_index_t(std::pmr::memory_resource*, std::string name, const keys_base_storage_t&);
+        wildcard_index_t(std::pmr::memory_resource*, std::string name, const keys_base_storage_t&,
+                         const keys_base_storage_t& include, const keys_base_storage_t& exclude);
+        ~wildcard_index_t() override;
+
+        bool is_indexed_path(const std::string& path) const;
+        // no document held a dict or an array at the path, so its entries are all of its values
+        bool is_scalar_path(const std::string& path) const;
+        // some document held an array at a path the path goes through, whose elements are not indexed by position
+        bool is_under_array(const std::string& path) const;
+
+    private:
+        class impl_t final : public index_t::iterator::iterator_impl_t {
+        public:
+            explicit impl_t(const_iterator iterator);
+            index_t::iterator::reference value_ref() const final;
+            iterator_impl_t* next() final;
+            iterator_impl_t* prev() final;
+            bool equals(const iterator_impl_t* other) const final;
+            bool not_equals(const iterator_impl_t* other) const final;
+            iterator_impl_t *copy() const final;
+
+        private:
+            const_iterator iterator_;
+        };
+
+        struct path_value_t {
+            std::string path;
+            value_t value;
+        };
+
+        // the value the keys of a path lead with, and the (path, value) pairs of the indexed documents under the path
+        struct path_t {
+            ::document::retained_const_t<::document::impl::value_t> value;
+            std::size_t count{0};
+        };
+
+        using paths_t = std::pmr::map<std::pmr::string, path_t, std::less<>>;
+        // the indexed documents holding a dict or an array at a path
+        using path_counts_t = std::pmr::map<std::pmr::string, std::size_t, std::less<>>;
+
+        auto insert_impl(value_t key, index_value_t value) -> void final;
+        auto insert_impl(document::document_ptr doc) -> void final;
+        auto remove_impl(value_t key) -> void final;
+        auto remove_impl(const composite_value_t& values, const document::document_id_t& id) -> void final;
+        range find_impl(const value_t& value) const final;
+        range lower_bound_impl(const value_t& value) const final;
+        range upper_bound_impl(const value_t& value) const final;
+        range find_impl(const composite_value_t& values) const final;
+        range lower_bound_impl(const composite_value_t& values) const final;
+        range upper_bound_impl(const composite_value_t& values) const final;
+        iterator cbegin_impl() const final;
+        iterator cend_impl() const final;
+        std::pmr::vector<composite_value_t> stored_keys_impl(const composite_value_t& entry) const final;
+        composite_value_t entry_impl(const document::document_ptr& document) const final;
+
+        void clean_memory_to_new_elements_impl(std::size_t count) final;
+
+        // the (path, value) pairs of a document, each one once
+        std::vector<path_value_t> scalars(const value_t& root) const;
+        void scalars_(const ::document::impl::value_t* value, const std::string& path, std::vector<path_value_t>& result) const;
+        void count_paths_(const ::document::impl::value_t* value, const std::string& path, bool is_insert);
+        static void count_path_(path_counts_t& counts, const std::string& path, bool is_insert);
+        const path_t* find_path_(std::string_view path) const;
+        const path_t& acquire_path_(const std::string& path);
+        void release_path_(const std::string& path);
+        void evict_unused_paths_();
+        composite_value_t make_key(const path_t& path, value_t value) const;
+
+    private:
+        storage_t storage_;
+        keys_base_storage_t include_;
+        keys_base_storage_t exclude_;
+        // a path no document uses anymore stays until the next insert or remove,
+        // so the keys of the document just removed can still be built for the disk index
+        paths_t paths_;
+        std::pmr::vector<std::pmr::string> unused_paths_;
+        path_counts_t array_paths_;
+        path_counts_t dict_paths_;
+    };
+
+} // namespace components::index
@@ -55,6 +55,9 @@ namespace components::ql {
                 case aggregate::operator_type::sort:
                     stream << aggregate.get_operator<aggregate::sort_t>(i);
                     break;
+                case aggregate::operator_type::limit:
+                    stream << "$limit: " << aggregate.get_operator<limit_t>(i).limit();
+                    break;
                 default:
                     break;
             }
@@ -5,6 +5,7 @@
 #include <variant>
 
 #include "group.hpp"
+#include "limit.hpp"
 #include "match.hpp"
 #include "sort.hpp"
 #include "merge.hpp"
@@ -29,6 +30,7 @@ namespace components::ql::aggregate {
         std::variant<
             aggregate::group_t,
             aggregate::match_t,
+            limit_t,
             aggregate::sort_t,
             aggregate::merge_t>
             storage_;
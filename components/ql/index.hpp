@@ -1,7 +1,9 @@
 #pragma once
 
-#include "ql_statement.hpp"
+#include "ql_param_statement.hpp"
+#include <components/expressions/compare_expression.hpp>
 #include <components/expressions/key.hpp>
+#include <components/expressions/msgpack.hpp>
 #include <memory_resource>
 #include <msgpack.hpp>
 #include <vector>
@@ -62,6 +64,14 @@ namespace components::ql {
         keys_base_storage_t keys_;
         index_type index_type_;
         index_compare index_compare_;
+        // sparse: documents with a missing or null key are left out of the index
+        bool sparse_{false};
+        // partial: only documents matching the filter are indexed, nullptr indexes all of them
+        expressions::compare_expression_ptr partial_filter_{nullptr};
+        storage_parameters partial_parameters_;
+        // wildcard: the paths, with all the paths under them, the index is limited to (all paths if empty) and left out of
+        keys_base_storage_t include_paths_;
+        keys_base_storage_t exclude_paths_;
     };
 
     struct drop_index_t final : ql_statement_t {
@@ -97,7 +107,8 @@ namespace msgpack {
             template<>
             struct convert<components::ql::create_index_t> final {
                 msgpack::object const& operator()(msgpack::object const& o, components::ql::create_index_t& v) const {
-                    if (o.type != msgpack::type::ARRAY || o.via.array.size != 5) {
+                    // 5 elements: written before sparse and partial indexes, 8: before wildcard indexes
+                    if (o.type != msgpack::type::ARRAY || (o.via.array.size != 5 && o.via.array.size != 8 && o.via.array.size != 10)) {
                         throw msgpack::type_error();
                     }
                     v.database_ = o.via.array.ptr[0].as<std::string>();
@@ -106,6 +117,19 @@ namespace msgpack {
                     v.index_compare_ = static_cast<components::ql::index_compare>(o.via.array.ptr[3].as<uint8_t>());
                     auto data = o.via.array.ptr[4].as<std::vector<std::string>>();
                     v.keys_ = components::ql::keys_base_storage_t(data.begin(), data.end());
+                    if (o.via.array.size >= 8) {
+                        v.sparse_ = o.via.array.ptr[5].as<bool>();
+                        if (!o.via.array.ptr[6].is_nil()) {
+                            v.partial_filter_ = o.via.array.ptr[6].as<components::expressions::compare_expression_ptr>();
+                        }
+                        v.partial_parameters_ = o.via.array.ptr[7].as<components::ql::storage_parameters>();
+                    }
+                    if (o.via.array.size == 10) {
+                        auto include = o.via.array.ptr[8].as<std::vector<std::string>>();
+                        v.include_paths_ = components::ql::keys_base_storage_t(include.begin(), include.end());
+                        auto exclude = o.via.array.ptr[9].as<std::vector<std::string>>();
+                        v.exclude_paths_ = components::ql::keys_base_storage_t(exclude.begin(), exclude.end());
+                    }
                     return o;
                 }
             };
@@ -114,12 +138,21 @@ namespace msgpack {
             struct pack<components::ql::create_index_t> final {
                 template<typename Stream>
                 packer<Stream>& operator()(msgpack::packer<Stream>& o, components::ql::create_index_t const& v) const {
-                    o.pack_array(5);
+                    o.pack_array(10);
                     o.pack(v.database_);
                     o.pack(v.collection_);
                     o.pack(static_cast<uint8_t>(v.index_type_));
                     o.pack(static_cast<uint8_t>(v.index_compare_));
                     o.pack(v.keys_);
+                    o.pack(v.sparse_);
+                    if (v.partial_filter_) {
+                        o.pack(v.partial_filter_);
+                    } else {
+                        o.pack_nil();
+                    }
+                    o.pack(v.partial_parameters_);
+                    o.pack(v.include_paths_);
+                    o.pack(v.exclude_paths_);
                     return o;
                 }
             };
@@ -128,7 +161,7 @@ namespace msgpack {
             struct object_with_zone<components::ql::create_index_t> final {
                 void operator()(msgpack::object::with_zone& o, components::ql::create_index_t const& v) const {
                     o.type = type::ARRAY;
-                    o.via.array.size = 5;
+                    o.via.array.size = 10;
                     o.via.array.ptr = static_cast<msgpack::object*>(o.zone.allocate_align(sizeof(msgpack::object) * o.via.array.size, MSGPACK_ZONE_ALIGNOF(msgpack::object)));
                     o.via.array.ptr[0] = msgpack::object(v.database_, o.zone);
                     o.via.array.ptr[1] = msgpack::object(v.collection_, o.zone);
@@ -136,6 +169,13 @@ namespace msgpack {
                     o.via.array.ptr[3] = msgpack::object(static_cast<uint8_t>(v.index_compare_), o.zone);
                     std::vector<std::string> tmp(v.keys_.begin(), v.keys_.end());
                     o.via.array.ptr[4] = msgpack::object(tmp, o.zone);
+                    o.via.array.ptr[5] = msgpack::object(v.sparse_, o.zone);
+                    o.via.array.ptr[6] = v.partial_filter_ ? msgpack::object(v.partial_filter_, o.zone) : msgpack::object();
+                    o.via.array.ptr[7] = msgpack::object(v.partial_parameters_, o.zone);
+                    std::vector<std::string> include(v.include_paths_.begin(), v.include_paths_.end());
+                    o.via.array.ptr[8] = msgpack::object(include, o.zone);
+                    std::vector<std::string> exclude(v.exclude_paths_.begin(), v.exclude_paths_.end());
+                    o.via.array.ptr[9] = msgpack::object(exclude, o.zone);
                 }
             };
 
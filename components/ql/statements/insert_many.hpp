@@ -2,6 +2,7 @@
 
 #include <memory_resource>
 #include <components/document/msgpack/msgpack_encoder.hpp>
+#include <components/document/msgpack/packed_documents.hpp>
 #include <components/ql/ql_statement.hpp>
 #include <boost/beast/core/span.hpp>
 #include <msgpack.hpp>
@@ -16,6 +17,8 @@ namespace components::ql {
         insert_many_t& operator=(insert_many_t&&) = default;
         ~insert_many_t();
         std::pmr::vector<components::document::document_ptr> documents_;
+        // the inserted documents as their collection encoded them, the wal writes these instead of documents_
+        components::document::packed_documents_ptr packed_documents_;
     };
 } // namespace components::ql
 
@@ -2,6 +2,7 @@
 
 #include <boost/beast/core/span.hpp>
 #include <components/document/msgpack/msgpack_encoder.hpp>
+#include <components/document/msgpack/packed_documents.hpp>
 #include <msgpack.hpp>
 #include <msgpack/zone.hpp>
 #include <msgpack/adaptor/list.hpp>
@@ -17,6 +18,8 @@ namespace components::ql {
         insert_one_t& operator=(insert_one_t&&) = default;
         ~insert_one_t();
         components::document::document_ptr document_;
+        // the inserted document as its collection encoded it, the wal writes it instead of document_
+        components::document::packed_documents_ptr packed_documents_;
     };
 } // namespace components::ql
 
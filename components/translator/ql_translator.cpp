@@ -6,6 +6,7 @@
 #include <components/logical_plan/node_delete.hpp>
 #include <components/logical_plan/node_group.hpp>
 #include <components/logical_plan/node_insert.hpp>
+#include <components/logical_plan/node_limit.hpp>
 #include <components/logical_plan/node_match.hpp>
 #include <components/logical_plan/node_sort.hpp>
 #include <components/logical_plan/node_update.hpp>
@@ -30,6 +31,9 @@ namespace components::translator {
                 case operator_type::sort:
                     node->append_child(logical_plan::make_node_sort(resource, node->collection_full(), aggregate->get_operator<ql::aggregate::sort_t>(i)));
                     break;
+                case operator_type::limit:
+                    node->append_child(logical_plan::make_node_limit(resource, node->collection_full(), aggregate->get_operator<ql::limit_t>(i)));
+                    break;
                 default:
                     break;
             }
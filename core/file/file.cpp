@@ -1,7 +1,10 @@
 #include "file.hpp"
 #include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <sys/uio.h>
 #include <unistd.h>
+#include <algorithm>
 
 namespace core::file {
 
@@ -87,8 +90,64 @@ namespace core::file {
         ::ftruncate(fd_, offset_);
     }
 
+    void file_t::truncate(__off64_t size) {
+        ::ftruncate(fd_, size);
+        offset_ = std::min(offset_, size);
+    }
+
     void file_t::seek_eof() {
         offset_ = ::lseek64(fd_, 0, SEEK_END);
     }
 
+    bool file_t::sync() {
+        return ::fdatasync(fd_) == 0;
+    }
+
+    __off64_t file_t::offset() const {
+        return offset_;
+    }
+
+
+    mapped_file_t::mapped_file_t(const path_t& path)
+        : data_(nullptr)
+        , size_(0) {
+        auto fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return;
+        }
+        struct stat info{};
+        if (::fstat(fd, &info) == 0 && info.st_size > 0) {
+            auto data = ::mmap(nullptr, std::size_t(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data != MAP_FAILED) {
+                data_ = static_cast<char*>(data);
+                size_ = std::size_t(info.st_size);
+                ::madvise(data_, size_, MADV_SEQUENTIAL);
+            }
+        }
+        ::close(fd);
+    }
+
+    mapped_file_t::~mapped_file_t() {
+        if (data_) {
+            ::munmap(data_, size_);
+        }
+    }
+
+    const char* mapped_file_t::data() const {
+        return data_;
+    }
+
+    std::size_t mapped_file_t::size() const {
+        return size_;
+    }
+
+    void mapped_file_t::release(std::size_t size) {
+        // drops the already consumed whole pages from the resident set
+        auto page_size = std::size_t(::sysconf(_SC_PAGESIZE));
+        size = std::min(size, size_) / page_size * page_size;
+        if (data_ && size > 0) {
+            ::madvise(data_, size, MADV_DONTNEED);
+        }
+    }
+
 } //namespace core::file
@@ -24,11 +24,30 @@ namespace core::file {
         void append(std::string& data);
         void append(const std::string& data);
         void rewrite(std::string& data);
+        void truncate(__off64_t size);
         void seek_eof();
+        bool sync();
+        __off64_t offset() const;
 
     private:
         int fd_;
         __off64_t offset_;
     };
 
+    class mapped_file_t {
+    public:
+        explicit mapped_file_t(const path_t& path);
+        mapped_file_t(const mapped_file_t&) = delete;
+        mapped_file_t& operator=(const mapped_file_t&) = delete;
+        ~mapped_file_t();
+
+        const char* data() const;
+        std::size_t size() const;
+        void release(std::size_t size);
+
+    private:
+        char* data_;
+        std::size_t size_;
+    };
+
 } //namespace core::file
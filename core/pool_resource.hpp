@@ -0,0 +1,122 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+
+namespace core::pmr {
+
+    // size-class pool that hands freed blocks out again instead of only growing, and keeps account of the bytes
+    // its owner has in use and of the bytes it took from the upstream.
+    // Blocks are freed on other threads and after the owner is gone (results leave the actor that made them),
+    // so the pool is synchronized and lives, holding its memory, until the owner released it and its last block is back
+    class pool_resource_t final : public std::pmr::memory_resource {
+    public:
+        struct statistic_t {
+            std::size_t bytes_in_use{0};
+            std::size_t peak_bytes_in_use{0};
+            std::size_t reserved_bytes{0};
+            std::size_t allocations{0};
+            std::size_t deallocations{0};
+        };
+
+        struct deleter_t {
+            void operator()(pool_resource_t* resource) const noexcept {
+                resource->unref_();
+            }
+        };
+        using ptr = std::unique_ptr<pool_resource_t, deleter_t>;
+
+        static ptr make(std::pmr::memory_resource* upstream = std::pmr::new_delete_resource()) {
+            return ptr(new pool_resource_t(upstream));
+        }
+
+        statistic_t statistic() const noexcept {
+            statistic_t result;
+            result.bytes_in_use = bytes_in_use_.load(std::memory_order_relaxed);
+            result.peak_bytes_in_use = peak_bytes_in_use_.load(std::memory_order_relaxed);
+            result.reserved_bytes = upstream_.reserved_bytes();
+            result.allocations = allocations_.load(std::memory_order_relaxed);
+            result.deallocations = deallocations_.load(std::memory_order_relaxed);
+            return result;
+        }
+
+    private:
+        // the memory the pool holds from its upstream, the part of the footprint that deletes do not give back
+        class upstream_t final : public std::pmr::memory_resource {
+        public:
+            explicit upstream_t(std::pmr::memory_resource* upstream) noexcept
+                : upstream_(upstream) {}
+
+            std::size_t reserved_bytes() const noexcept {
+                return reserved_bytes_.load(std::memory_order_relaxed);
+            }
+
+        private:
+            void* do_allocate(std::size_t bytes, std::size_t alignment) final {
+                auto* p = upstream_->allocate(bytes, alignment);
+                reserved_bytes_.fetch_add(bytes, std::memory_order_relaxed);
+                return p;
+            }
+
+            void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) final {
+                upstream_->deallocate(p, bytes, alignment);
+                reserved_bytes_.fetch_sub(bytes, std::memory_order_relaxed);
+            }
+
+            bool do_is_equal(const std::pmr::memory_resource& other) const noexcept final {
+                return this == &other;
+            }
+
+            std::pmr::memory_resource* upstream_;
+            std::atomic<std::size_t> reserved_bytes_{0};
+        };
+
+        explicit pool_resource_t(std::pmr::memory_resource* upstream)
+            : upstream_(upstream)
+            , pool_(&upstream_) {}
+
+        ~pool_resource_t() final = default;
+
+        void* do_allocate(std::size_t bytes, std::size_t alignment) final {
+            auto* p = pool_.allocate(bytes, alignment);
+            references_.fetch_add(1, std::memory_order_relaxed);
+            allocations_.fetch_add(1, std::memory_order_relaxed);
+            auto in_use = bytes_in_use_.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+            auto peak = peak_bytes_in_use_.load(std::memory_order_relaxed);
+            while (peak < in_use && !peak_bytes_in_use_.compare_exchange_weak(peak, in_use, std::memory_order_relaxed)) {
+            }
+            return p;
+        }
+
+        void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) final {
+            pool_.deallocate(p, bytes, alignment);
+            deallocations_.fetch_add(1, std::memory_order_relaxed);
+            bytes_in_use_.fetch_sub(bytes, std::memory_order_relaxed);
+            unref_();
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept final {
+            return this == &other;
+        }
+
+        // one reference for the owner and one for each block out
+        void unref_() noexcept {
+            if (references_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                delete this;
+            }
+        }
+
+        upstream_t upstream_;
+        std::pmr::synchronized_pool_resource pool_;
+        std::atomic<std::size_t> references_{1};
+        std::atomic<std::size_t> bytes_in_use_{0};
+        std::atomic<std::size_t> peak_bytes_in_use_{0};
+        std::atomic<std::size_t> allocations_{0};
+        std::atomic<std::size_t> deallocations_{0};
+    };
+
+    using pool_resource_ptr = pool_resource_t::ptr;
+
+} // namespace core::pmr
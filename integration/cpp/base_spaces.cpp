@@ -4,7 +4,9 @@
 
 #include <actor-zeta.hpp>
 
+#include <algorithm>
 #include <memory>
+#include <thread>
 
 #include "core/system_command.hpp"
 
@@ -14,29 +16,54 @@ namespace duck_charmer {
 
     constexpr static auto name_dispatcher = "dispatcher";
 
+    std::size_t hardware_threads() {
+        return std::max(std::size_t(std::thread::hardware_concurrency()), std::size_t(1));
+    }
+
+    // the wal and every disk agent may use a thread of their own
+    std::size_t storage_threads(const configuration::config& config) {
+        if (config.scheduler.storage_threads > 0) {
+            return config.scheduler.storage_threads;
+        }
+        return std::min(hardware_threads(), config.disk.agents + 1);
+    }
+
+    // collections get whatever is left by the storage and the dispatcher
+    std::size_t query_threads(const configuration::config& config) {
+        if (config.scheduler.query_threads > 0) {
+            return config.scheduler.query_threads;
+        }
+        auto reserved = storage_threads(config) + config.scheduler.dispatcher_threads;
+        return hardware_threads() > reserved ? hardware_threads() - reserved : 1;
+    }
+
     base_spaces::base_spaces(const configuration::config& config)
-        : scheduler_(new actor_zeta::shared_work(1, 1000))
-        , scheduler_dispather_(new actor_zeta::shared_work(1, 1000)) {
+        : scheduler_(new actor_zeta::shared_work(query_threads(config), config.scheduler.max_throughput))
+        , scheduler_storage_(new actor_zeta::shared_work(storage_threads(config), config.scheduler.max_throughput))
+        , scheduler_dispather_(new actor_zeta::shared_work(std::max(config.scheduler.dispatcher_threads, std::size_t(1)), config.scheduler.max_throughput)) {
         log_ = initialization_logger("python", config.log.path.c_str());
         log_.set_level(config.log.level);
-        trace(log_, "spaces::spaces()");
+        trace(log_, "spaces::spaces(), threads: query {}, storage {}, dispatcher {}", query_threads(config), storage_threads(config), config.scheduler.dispatcher_threads);
 
         ///scheduler_.reset(new actor_zeta::shared_work(1, 1000), actor_zeta::detail::thread_pool_deleter());
         resource = actor_zeta::detail::pmr::get_default_resource();
 
         trace(log_, "manager_wal start");
         if (config.wal.on) {
-            manager_wal_ = actor_zeta::spawn_supervisor<services::wal::manager_wal_replicate_t>(resource, scheduler_.get(), config.wal, log_);
+            manager_wal_ = actor_zeta::spawn_supervisor<services::wal::manager_wal_replicate_t>(resource, scheduler_storage_.get(), config.wal, log_);
         } else {
-            manager_wal_ = actor_zeta::spawn_supervisor<services::wal::manager_wal_replicate_empty_t>(resource, scheduler_.get(), log_);
+            manager_wal_ = actor_zeta::spawn_supervisor<services::wal::manager_wal_replicate_empty_t>(resource, scheduler_storage_.get(), log_);
         }
         trace(log_, "manager_wal finish");
 
         trace(log_, "manager_disk start");
         if (config.disk.on) {
-            manager_disk_ = actor_zeta::spawn_supervisor<services::disk::manager_disk_t>(resource, scheduler_.get(), config.disk, log_);
+            auto config_disk = config.disk;
+            // the documents can be recovered from our own wal, rocksdb does not need to log them once more
+            config_disk.rocksdb_wal = config_disk.rocksdb_wal && !(config.wal.on && config.wal.sync_to_disk);
+            manager_disk_ = actor_zeta::spawn_supervisor<services::disk::manager_disk_t>(resource, scheduler_storage_.get(), config_disk, log_);
         } else {
-            manager_disk_ = actor_zeta::spawn_supervisor<services::disk::manager_disk_empty_t>(resource, scheduler_.get());
+            manager_disk_ = actor_zeta::spawn_supervisor<services::disk::manager_disk_empty_t>(resource, scheduler_storage_.get());
         }
         trace(log_, "manager_disk finish");
 
@@ -67,7 +94,7 @@ namespace duck_charmer {
             manager_disk_,
             actor_zeta::address_t::empty_address(),
             core::handler_id(core::route::sync),
-            std::make_tuple(manager_dispatcher_->address()));
+            std::make_tuple(manager_wal_->address(), manager_dispatcher_->address()));
 
         actor_zeta::send(
             manager_database_,
@@ -79,6 +106,7 @@ namespace duck_charmer {
         actor_zeta::send(manager_disk_, actor_zeta::address_t::empty_address(), disk::handler_id(disk::route::create_agent));
         manager_dispatcher_->create_dispatcher(name_dispatcher);
         scheduler_dispather_->start();
+        scheduler_storage_->start();
         scheduler_->start();
         trace(log_, "spaces::spaces() final");
     }
@@ -94,6 +122,7 @@ namespace duck_charmer {
     base_spaces::~base_spaces() {
         trace(log_, "delete spaces");
         scheduler_->stop();
+        scheduler_storage_->stop();
         scheduler_dispather_->stop();
     }
 
@@ -0,0 +1,71 @@
+#include <benchmark/benchmark.h>
+
+#include <components/tests/generaty.hpp>
+#include <services/disk/disk.hpp>
+
+using namespace services::disk;
+
+constexpr auto database_name = "TestDatabase";
+constexpr auto collection_name = "TestCollection";
+constexpr int count_collections = 8;
+constexpr int count_documents = 20000;
+
+const path_t& disk_path() {
+    static const path_t path = [] {
+        path_t path = "/tmp/benchmark/disk_load";
+        std::filesystem::remove_all(path);
+        disk_t disk(path);
+        disk.append_database(database_name);
+        for (int n = 0; n < count_collections; ++n) {
+            auto collection = collection_name + std::to_string(n);
+            disk.append_collection(database_name, collection);
+            std::pmr::vector<document_ptr> documents;
+            for (int num = 1; num <= count_documents; ++num) {
+                documents.push_back(gen_doc(num));
+            }
+            disk.save_documents(database_name, collection, documents);
+        }
+        return path;
+    }();
+    return path;
+}
+
+// the former load path: list the keys first, then a point lookup per document
+void disk_load_by_keys(benchmark::State& state) {
+    disk_t disk(disk_path());
+    for (auto _ : state) {
+        result_load_t result(disk.databases(), disk.wal_id());
+        for (auto& database : *result) {
+            database.set_collection(disk.collections(database.name));
+            for (auto& collection : database.collections) {
+                for (const auto& id : disk.load_list_documents(database.name, collection.name)) {
+                    collection.documents.push_back(disk.load_document(id));
+                }
+            }
+        }
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * count_collections * count_documents);
+}
+BENCHMARK(disk_load_by_keys)->Unit(benchmark::kMillisecond);
+
+void disk_load(benchmark::State& state) {
+    disk_t disk(disk_path());
+    for (auto _ : state) {
+        auto result = disk.load(std::size_t(state.range(0)));
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * count_collections * count_documents);
+}
+BENCHMARK(disk_load)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+
+int main(int argc, char** argv) {
+    ::benchmark::Initialize(&argc, argv);
+    if (::benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    ::benchmark::RunSpecifiedBenchmarks();
+    ::benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,63 @@
+#include <benchmark/benchmark.h>
+#include <services/collection/operators/operator_group.hpp>
+#include <services/collection/operators/scan/transfer_scan.hpp>
+#include <services/collection/operators/get/simple_value.hpp>
+#include <services/collection/operators/aggregate/operator_count.hpp>
+#include <services/collection/operators/aggregate/operator_sum.hpp>
+#include <services/collection/operators/aggregate/operator_min.hpp>
+#include <services/collection/operators/aggregate/operator_max.hpp>
+#include <services/collection/operators/aggregate/operator_avg.hpp>
+#include <services/collection/tests/operators/test_operator_generaty.hpp>
+
+using namespace services::collection::operators;
+using key = components::expressions::key_t;
+
+context_ptr create_group_collection(int count_documents, int count_groups) {
+    static auto log = initialization_logger("python", "/tmp/docker_logs/");
+    log.set_level(log_t::level::off);
+    auto collection = make_context(log);
+    std::pmr::vector<document_ptr> documents(collection->resource);
+    documents.reserve(std::size_t(count_documents));
+    for (int i = 0; i < count_documents; ++i) {
+        auto document = components::document::make_document();
+        document->set("_id", gen_id(i + 1));
+        document->set("group", i % count_groups);
+        document->set("count", i);
+        documents.push_back(std::move(document));
+    }
+    operator_insert insert(d(collection)->view(), std::move(documents));
+    insert.on_execute(nullptr);
+    return collection;
+}
+
+void group_by(benchmark::State& state) {
+    auto collection = create_group_collection(int(state.range(0)), int(state.range(1)));
+    for (auto _ : state) {
+        auto group = std::make_unique<operator_group_t>(d(collection)->view());
+        group->set_children(std::make_unique<transfer_scan>(d(collection)->view(), components::ql::limit_t::unlimit()));
+        group->add_key("group", get::simple_value_t::create(key("group")));
+        group->add_value("count", std::make_unique<aggregate::operator_count_t>(d(collection)->view()));
+        group->add_value("sum", std::make_unique<aggregate::operator_sum_t>(d(collection)->view(), key("count")));
+        group->add_value("min", std::make_unique<aggregate::operator_min_t>(d(collection)->view(), key("count")));
+        group->add_value("max", std::make_unique<aggregate::operator_max_t>(d(collection)->view(), key("count")));
+        group->add_value("avg", std::make_unique<aggregate::operator_avg_t>(d(collection)->view(), key("count")));
+        group->on_execute(nullptr);
+        benchmark::DoNotOptimize(group->output());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(group_by)
+    ->Args({100000, 100})
+    ->Args({100000, 10000})
+    ->Args({1000000, 100000})
+    ->Unit(benchmark::kMillisecond);
+
+int main(int argc, char** argv) {
+    ::benchmark::Initialize(&argc, argv);
+    if (::benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    ::benchmark::RunSpecifiedBenchmarks();
+    ::benchmark::Shutdown();
+    return 0;
+}
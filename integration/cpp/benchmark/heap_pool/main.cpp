@@ -0,0 +1,51 @@
+#include <benchmark/benchmark.h>
+#include <components/document/core/heap_pool.hpp>
+#include <components/tests/generaty.hpp>
+
+using ::document::impl::heap_allocation_scope_t;
+using ::document::impl::heap_pool_t;
+
+// builds and drops a batch of documents, state.range(0) documents each, from the global heap
+void batch_global(benchmark::State& state) {
+    std::vector<components::document::document_ptr> documents;
+    documents.reserve(std::size_t(state.range(0)));
+    for (auto _ : state) {
+        for (int i = 0; i < state.range(0); ++i) {
+            documents.push_back(gen_doc(i));
+        }
+        documents.clear();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(batch_global)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+// the same batches drawn from a pool of their own, counting the heap values a document takes
+void batch_pool(benchmark::State& state) {
+    std::vector<components::document::document_ptr> documents;
+    documents.reserve(std::size_t(state.range(0)));
+    std::size_t allocations = 0;
+    for (auto _ : state) {
+        auto pool = heap_pool_t::make();
+        {
+            heap_allocation_scope_t scope(pool.get());
+            for (int i = 0; i < state.range(0); ++i) {
+                documents.push_back(gen_doc(i));
+            }
+        }
+        allocations += pool->allocation_count();
+        documents.clear();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["allocations_per_document"] = benchmark::Counter(double(allocations) / double(state.iterations() * state.range(0)));
+}
+BENCHMARK(batch_pool)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+int main(int argc, char** argv) {
+    ::benchmark::Initialize(&argc, argv);
+    if (::benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    ::benchmark::RunSpecifiedBenchmarks();
+    ::benchmark::Shutdown();
+    return 0;
+}
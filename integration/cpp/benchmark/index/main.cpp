@@ -12,6 +12,8 @@ constexpr bool disk_off = false;
 constexpr bool index_on = true;
 constexpr bool index_off = false;
 
+static const collection_name_t collection_name_with_hash_index = "TestCollectionWithHashIndex";
+
 #define BENCHMARK_FUNC(FUNC, WAL_ON, DISK_ON) \
     BENCHMARK(FUNC<WAL_ON, DISK_ON, index_off>)->Arg(100); \
     BENCHMARK(FUNC<WAL_ON, DISK_ON, index_on>)->Arg(100)
@@ -58,6 +60,30 @@ void only_find_gt(benchmark::State& state) {
     }
 }
 
+template <bool on_wal, bool on_disk>
+void init_hash_index() {
+    init_collection<on_wal, on_disk>(collection_name_with_hash_index);
+    auto* dispatcher = wr_dispatcher<on_wal, on_disk>();
+    auto session = duck_charmer::session_id_t();
+    create_index_t ql{database_name, collection_name_with_hash_index, index_type::hashed, index_compare::int64};
+    ql.keys_.emplace_back("count");
+    dispatcher->create_index(session, ql);
+}
+
+template <bool on_wal, bool on_disk, index_type type>
+void find_eq_point_lookups(benchmark::State& state) {
+    state.PauseTiming();
+    auto* dispatcher = wr_dispatcher<on_wal, on_disk>();
+    collection_name_t collection_name = type == index_type::hashed ? collection_name_with_hash_index : collection_name_with_index;
+    auto session = duck_charmer::session_id_t();
+    state.ResumeTiming();
+    for (auto _ : state) {
+        for (int i = 0; i < state.range(0); ++i) {
+            dispatcher->find(session, create_aggregate(collection_name, compare_type::eq, "count", 1 + (i * 97) % size_collection));
+        }
+    }
+}
+
 template <bool on_wal, bool on_disk, bool on_index>
 void delete_insert_update_one(benchmark::State& state) {
     state.PauseTiming();
@@ -87,6 +113,8 @@ BENCHMARK_FUNC(only_find_all, wal_off, disk_off);
 BENCHMARK_FUNC(only_find_eq, wal_off, disk_off);
 BENCHMARK_FUNC(only_find_gt, wal_off, disk_off);
 BENCHMARK_FUNC(delete_insert_update_one, wal_off, disk_off);
+BENCHMARK(find_eq_point_lookups<wal_off, disk_off, index_type::single>)->Arg(100);
+BENCHMARK(find_eq_point_lookups<wal_off, disk_off, index_type::hashed>)->Arg(100);
 
 #ifdef test_with_disk
 BENCHMARK_FUNC(only_find_all, wal_on, disk_on);
@@ -101,6 +129,7 @@ int main(int argc, char** argv) {
         return 1;
     }
     init_spaces<wal_off, disk_off>();
+    init_hash_index<wal_off, disk_off>();
 #ifdef test_with_disk
     init_spaces<wal_on, disk_on>();
 #endif
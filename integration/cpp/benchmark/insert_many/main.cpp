@@ -1,21 +1,47 @@
-#include "../classes.hpp"
-
-void insert_many(benchmark::State& state) {
-    state.PauseTiming();
-    auto* dispatcher = unique_spaces::get().dispatcher();
-    auto session = duck_charmer::session_id_t();
-    dispatcher->create_database(session, database_name);
-    dispatcher->create_collection(session, database_name, collection_name);
-    state.ResumeTiming();
+#include <benchmark/benchmark.h>
+
+#include <components/tests/generaty.hpp>
+#include <services/disk/disk.hpp>
+
+using namespace services::disk;
+
+constexpr auto database_name = "TestDatabase";
+constexpr auto collection_name = "TestCollection";
+
+std::pmr::vector<document_ptr> gen_documents(int64_t count) {
+    std::pmr::vector<document_ptr> documents;
+    for (int num = 1; num <= count; ++num) {
+        documents.push_back(gen_doc(num));
+    }
+    return documents;
+}
+
+// range(0): documents in one insert_many, range(1): rocksdb wal on/off
+void insert_many_by_document(benchmark::State& state) {
+    const path_t path = "/tmp/benchmark/insert_many_by_document";
+    std::filesystem::remove_all(path);
+    disk_t disk(path, state.range(1) != 0);
+    auto documents = gen_documents(state.range(0));
     for (auto _ : state) {
-        std::list<document_ptr> docs;
-        for (int i = 0; i < state.range(0); ++i) {
-            docs.push_back(gen_doc(int(10000 * state.range(0) + i)));
+        for (const auto& document : documents) {
+            disk.save_document(database_name, collection_name, components::document::get_document_id(document), document);
         }
-        dispatcher->insert_many(session, database_name, collection_name, docs);
     }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(insert_many_by_document)->Args({10000, 1})->Args({10000, 0});
+
+void insert_many_write_batch(benchmark::State& state) {
+    const path_t path = "/tmp/benchmark/insert_many_write_batch";
+    std::filesystem::remove_all(path);
+    disk_t disk(path, state.range(1) != 0);
+    auto documents = gen_documents(state.range(0));
+    for (auto _ : state) {
+        disk.save_documents(database_name, collection_name, documents);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
 }
-BENCHMARK(insert_many)->Arg(1)->Arg(10)->Arg(20)->Arg(100)->Arg(500)->Arg(1000);
+BENCHMARK(insert_many_write_batch)->Args({10000, 1})->Args({10000, 0});
 
 
 int main(int argc, char** argv) {
@@ -23,7 +49,6 @@ int main(int argc, char** argv) {
     if (::benchmark::ReportUnrecognizedArguments(argc, argv)) {
         return 1;
     }
-    unique_spaces::get();
     ::benchmark::RunSpecifiedBenchmarks();
     ::benchmark::Shutdown();
     return 0;
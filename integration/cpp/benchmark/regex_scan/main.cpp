@@ -0,0 +1,50 @@
+#include <benchmark/benchmark.h>
+#include <regex>
+#include "../classes.hpp"
+
+constexpr bool wal_off = false;
+constexpr bool disk_off = false;
+
+// the plan used to build a std::regex for every checked document, kept here as the baseline
+void regex_per_document(benchmark::State& state, const std::string& pattern) {
+    std::vector<std::string> values;
+    for (int i = 1; i <= size_collection; ++i) {
+        values.push_back(std::to_string(i));
+    }
+    for (auto _ : state) {
+        std::size_t count = 0;
+        for (const auto& value : values) {
+            count += std::regex_match(value, std::regex(".*" + pattern + ".*")) ? 1 : 0;
+        }
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsProcessed(state.iterations() * size_collection);
+}
+
+void full_scan_regex(benchmark::State& state, const std::string& pattern) {
+    auto* dispatcher = wr_dispatcher<wal_off, disk_off>();
+    auto session = duck_charmer::session_id_t();
+    for (auto _ : state) {
+        auto* cursor = dispatcher->find(session, create_aggregate(collection_name_without_index, compare_type::regex, "countStr", std::string_view{pattern}));
+        benchmark::DoNotOptimize(cursor);
+        delete cursor;
+    }
+    state.SetItemsProcessed(state.iterations() * size_collection);
+}
+
+BENCHMARK_CAPTURE(regex_per_document, substring, std::string("99"));
+BENCHMARK_CAPTURE(regex_per_document, regex, std::string("9[0-9]9"));
+BENCHMARK_CAPTURE(full_scan_regex, substring, std::string("99"));
+BENCHMARK_CAPTURE(full_scan_regex, prefix, std::string("^99"));
+BENCHMARK_CAPTURE(full_scan_regex, regex, std::string("9[0-9]9"));
+
+int main(int argc, char** argv) {
+    ::benchmark::Initialize(&argc, argv);
+    if (::benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    init_collection<wal_off, disk_off>(collection_name_without_index);
+    ::benchmark::RunSpecifiedBenchmarks();
+    ::benchmark::Shutdown();
+    return 0;
+}
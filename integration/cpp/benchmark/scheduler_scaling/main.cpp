@@ -0,0 +1,120 @@
+#include <benchmark/benchmark.h>
+
+#include <thread>
+
+#include <components/expressions/compare_expression.hpp>
+#include <components/tests/generaty.hpp>
+#include <integration/cpp/base_spaces.hpp>
+
+using components::expressions::compare_type;
+using key = components::expressions::key_t;
+using id_par = core::parameter_id_t;
+
+static const database_name_t database_name = "TestDatabase";
+static const collection_name_t collection_name = "TestCollection";
+constexpr int count_documents = 1000;
+constexpr int count_operations = 100;
+
+class scaling_spaces final : public duck_charmer::base_spaces {
+public:
+    explicit scaling_spaces(const configuration::config& config)
+        : duck_charmer::base_spaces(config) {}
+
+    std::unique_ptr<duck_charmer::wrapper_dispatcher_t> make_client() {
+        return std::make_unique<duck_charmer::wrapper_dispatcher_t>(resource, manager_dispatcher_->address(), log_);
+    }
+};
+
+configuration::config scaling_config(std::size_t threads) {
+    auto config = configuration::config::default_config();
+    config.log.path = "/tmp/benchmark/scheduler_scaling";
+    config.log.level = log_t::level::off;
+    config.disk.on = false;
+    config.wal.on = false;
+    config.scheduler.query_threads = threads;
+    config.scheduler.storage_threads = 1;
+    return config;
+}
+
+// every client works with a collection of its own, so the collections can run in parallel
+struct scaling_bench_t {
+    explicit scaling_bench_t(std::size_t threads)
+        : spaces(scaling_config(threads)) {
+        auto session = duck_charmer::session_id_t();
+        spaces.dispatcher()->create_database(session, database_name);
+        for (std::size_t i = 0; i < threads; ++i) {
+            auto name = collection_name + std::to_string(i);
+            auto session_collection = duck_charmer::session_id_t();
+            spaces.dispatcher()->create_collection(session_collection, database_name, name);
+            std::pmr::vector<document_ptr> documents;
+            for (int num = 1; num <= count_documents; ++num) {
+                documents.push_back(gen_doc(num));
+            }
+            auto session_insert = duck_charmer::session_id_t();
+            spaces.dispatcher()->insert_many(session_insert, database_name, name, documents);
+            clients.push_back(spaces.make_client());
+        }
+    }
+
+    template<class F>
+    void run(F&& f) {
+        std::vector<std::thread> threads;
+        for (std::size_t i = 0; i < clients.size(); ++i) {
+            threads.emplace_back([&, i]() {
+                f(clients[i].get(), collection_name + std::to_string(i), i);
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    scaling_spaces spaces;
+    std::vector<std::unique_ptr<duck_charmer::wrapper_dispatcher_t>> clients;
+};
+
+void scaling_find(benchmark::State& state) {
+    scaling_bench_t bench(std::size_t(state.range(0)));
+    for (auto _ : state) {
+        bench.run([](duck_charmer::wrapper_dispatcher_t* client, const collection_name_t& name, std::size_t) {
+            for (int i = 0; i < count_operations; ++i) {
+                auto session = duck_charmer::session_id_t();
+                auto* ql = new components::ql::aggregate_statement{database_name, name};
+                auto expr = components::expressions::make_compare_expression(client->resource(), compare_type::eq, key{"count"}, id_par{1});
+                ql->append(components::ql::aggregate::operator_type::match, components::ql::aggregate::make_match(std::move(expr)));
+                ql->add_parameter(id_par{1}, count_documents - i);
+                benchmark::DoNotOptimize(client->find_one(session, ql));
+            }
+        });
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * count_operations);
+}
+BENCHMARK(scaling_find)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime();
+
+void scaling_insert(benchmark::State& state) {
+    scaling_bench_t bench(std::size_t(state.range(0)));
+    int iteration = 0;
+    for (auto _ : state) {
+        ++iteration;
+        bench.run([iteration](duck_charmer::wrapper_dispatcher_t* client, const collection_name_t& name, std::size_t) {
+            for (int i = 0; i < count_operations; ++i) {
+                auto session = duck_charmer::session_id_t();
+                auto document = gen_doc(count_documents + iteration * count_operations + i);
+                client->insert_one(session, database_name, name, document);
+            }
+        });
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * count_operations);
+}
+BENCHMARK(scaling_insert)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime();
+
+
+int main(int argc, char** argv) {
+    ::benchmark::Initialize(&argc, argv);
+    if (::benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    ::benchmark::RunSpecifiedBenchmarks();
+    ::benchmark::Shutdown();
+    return 0;
+}
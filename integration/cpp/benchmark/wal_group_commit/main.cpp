@@ -0,0 +1,84 @@
+#include <benchmark/benchmark.h>
+
+#include <actor-zeta.hpp>
+#include <core/non_thread_scheduler/scheduler_test.hpp>
+#include <components/tests/generaty.hpp>
+#include <services/wal/manager_wal_replicate.hpp>
+#include <services/wal/route.hpp>
+
+using namespace services::wal;
+using namespace components::ql;
+
+constexpr auto database_name = "TestDatabase";
+constexpr auto collection_name = "TestCollection";
+
+struct wal_spaces_t {
+    core::non_thread_scheduler::scheduler_test_t* scheduler{nullptr};
+    manager_wal_ptr manager;
+    wal_replicate_t* wal{nullptr};
+};
+
+wal_spaces_t create_wal(const configuration::config_wal& config) {
+    static auto log = initialization_logger("benchmark", "/tmp/docker_logs/");
+    log.set_level(log_t::level::off);
+    std::filesystem::remove_all(config.path);
+    std::filesystem::create_directories(config.path);
+    wal_spaces_t result;
+    result.scheduler = new core::non_thread_scheduler::scheduler_test_t(1, 1);
+    auto* resource = actor_zeta::detail::pmr::get_default_resource();
+    result.manager = actor_zeta::spawn_supervisor<manager_wal_replicate_t>(resource, result.scheduler, config, log);
+    void* buffer = result.manager->resource()->allocate(sizeof(wal_replicate_t), alignof(wal_replicate_t));
+    result.wal = new (buffer) wal_replicate_t(result.manager.get(), log, config);
+    return result;
+}
+
+// statements arrive one by one, the actor gets a scheduler slice between them
+void write_statements(wal_spaces_t& spaces, int64_t count, int& num) {
+    for (int64_t i = 0; i < count; ++i) {
+        insert_one_t data(database_name, collection_name, gen_doc(++num));
+        actor_zeta::send(spaces.wal->address(), actor_zeta::address_t::empty_address(), handler_id(route::insert_one),
+                         components::session::session_id_t(), actor_zeta::address_t::empty_address(), std::move(data));
+        spaces.scheduler->run_once();
+    }
+    spaces.scheduler->run();
+}
+
+// baseline: a group never outgrows zero bytes, so every record is written and fsynced on its own
+void wal_fsync_per_record(benchmark::State& state) {
+    configuration::config_wal config;
+    config.path = "/tmp/benchmark/wal_fsync_per_record";
+    config.group_commit = true;
+    config.group_commit_max_bytes = 0;
+    auto spaces = create_wal(config);
+    int num = 0;
+    for (auto _ : state) {
+        write_statements(spaces, state.range(0), num);
+    }
+    state.counters["commits"] = benchmark::Counter(double(num), benchmark::Counter::kIsRate);
+}
+BENCHMARK(wal_fsync_per_record)->Arg(1000);
+
+void wal_group_commit(benchmark::State& state) {
+    configuration::config_wal config;
+    config.path = "/tmp/benchmark/wal_group_commit";
+    config.group_commit = true;
+    config.group_commit_window = std::chrono::microseconds(state.range(1));
+    auto spaces = create_wal(config);
+    int num = 0;
+    for (auto _ : state) {
+        write_statements(spaces, state.range(0), num);
+    }
+    state.counters["commits"] = benchmark::Counter(double(num), benchmark::Counter::kIsRate);
+}
+BENCHMARK(wal_group_commit)->Args({1000, 0})->Args({1000, 10})->Args({1000, 100})->Args({1000, 1000});
+
+
+int main(int argc, char** argv) {
+    ::benchmark::Initialize(&argc, argv);
+    if (::benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    ::benchmark::RunSpecifiedBenchmarks();
+    ::benchmark::Shutdown();
+    return 0;
+}
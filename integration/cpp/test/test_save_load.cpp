@@ -188,3 +188,88 @@ TEST_CASE("python::test_save_load::disk+wal") {
     }
 
 }
+
+TEST_CASE("python::test_save_load::disk+wal+agents") {
+    auto config = test_create_config("/tmp/test_save_load/agents");
+    config.disk.agents = 3;
+
+    SECTION("initialization") {
+        test_clear_directory(config);
+        test_spaces space(config);
+        auto* dispatcher = space.dispatcher();
+        for (uint n_db = 1; n_db <= count_databases; ++n_db) {
+            auto db_name = database_name + "_" + std::to_string(n_db);
+            auto session_db = duck_charmer::session_id_t();
+            dispatcher->create_database(session_db, db_name);
+            for (uint n_col = 1; n_col <= count_collections; ++n_col) {
+                auto col_name = collection_name + "_" + std::to_string(n_col);
+                auto session_col = duck_charmer::session_id_t();
+                dispatcher->create_collection(session_col, db_name, col_name);
+                for (uint n_doc = 1; n_doc <= count_documents; ++n_doc) {
+                    auto doc = gen_doc(int(n_doc));
+                    doc->set("number", gen_doc_number(n_db, n_col, n_doc));
+                    auto session_doc = duck_charmer::session_id_t();
+                    dispatcher->insert_one(session_doc, db_name, col_name, doc);
+                }
+            }
+        }
+    }
+
+    SECTION("load") {
+        test_spaces space(config);
+        auto* dispatcher = space.dispatcher();
+        dispatcher->load();
+        for (uint n_db = 1; n_db <= count_databases; ++n_db) {
+            auto db_name = database_name + "_" + std::to_string(n_db);
+            for (uint n_col = 1; n_col <= count_collections; ++n_col) {
+                auto session = duck_charmer::session_id_t();
+                auto col_name = collection_name + "_" + std::to_string(n_col);
+                auto size = dispatcher->size(session, db_name, col_name);
+                REQUIRE(*size == count_documents);
+                for (uint n_doc = 1; n_doc <= count_documents; ++n_doc) {
+                    REQUIRE(find_doc(dispatcher, db_name, col_name, int(n_doc))->get_ulong("number") == gen_doc_number(n_db, n_col, n_doc));
+                }
+            }
+        }
+    }
+
+}
+
+TEST_CASE("python::test_save_load::disk+wal+agents::drop_collection") {
+    auto config = test_create_config("/tmp/test_save_load/agents_drop");
+    config.disk.agents = 3;
+    const auto db_name = database_name + "_1";
+    const auto dropped_name = collection_name + "_1";
+
+    SECTION("initialization") {
+        test_clear_directory(config);
+        test_spaces space(config);
+        auto* dispatcher = space.dispatcher();
+        auto session_db = duck_charmer::session_id_t();
+        dispatcher->create_database(session_db, db_name);
+        for (uint n_col = 1; n_col <= count_collections; ++n_col) {
+            auto col_name = collection_name + "_" + std::to_string(n_col);
+            auto session_col = duck_charmer::session_id_t();
+            dispatcher->create_collection(session_col, db_name, col_name);
+            for (uint n_doc = 1; n_doc <= count_documents; ++n_doc) {
+                auto session_doc = duck_charmer::session_id_t();
+                dispatcher->insert_one(session_doc, db_name, col_name, gen_doc(int(n_doc)));
+            }
+        }
+        auto session_drop = duck_charmer::session_id_t();
+        REQUIRE(dispatcher->drop_collection(session_drop, db_name, dropped_name).is_success());
+    }
+
+    SECTION("load") {
+        test_spaces space(config);
+        auto* dispatcher = space.dispatcher();
+        dispatcher->load();
+        for (uint n_col = 1; n_col <= count_collections; ++n_col) {
+            auto session = duck_charmer::session_id_t();
+            auto col_name = collection_name + "_" + std::to_string(n_col);
+            auto size = dispatcher->size(session, db_name, col_name);
+            REQUIRE(*size == (col_name == dropped_name ? 0 : count_documents));
+        }
+    }
+
+}
@@ -28,6 +28,7 @@ namespace duck_charmer {
         add_handler(collection::handler_id(collection::route::delete_finish), &wrapper_dispatcher_t::delete_finish);
         add_handler(collection::handler_id(collection::route::update_finish), &wrapper_dispatcher_t::update_finish);
         add_handler(collection::handler_id(collection::route::size_finish), &wrapper_dispatcher_t::size_finish);
+        add_handler(collection::handler_id(collection::route::memory_size_finish), &wrapper_dispatcher_t::memory_size_finish);
         add_handler(collection::handler_id(collection::route::create_index_finish), &wrapper_dispatcher_t::create_index_finish);
         add_handler(collection::handler_id(collection::route::drop_index_finish), &wrapper_dispatcher_t::drop_index_finish);
     }
@@ -218,6 +219,20 @@ namespace duck_charmer {
         return std::get<result_size>(intermediate_store_);
     }
 
+    auto wrapper_dispatcher_t::memory_size(session_id_t &session, const database_name_t &database, const collection_name_t &collection) -> result_memory_size {
+        trace(log_, "wrapper_dispatcher_t::memory_size session: {}, collection name : {} ", session.data(), collection);
+        init();
+        actor_zeta::send(
+            manager_dispatcher_,
+            address(),
+            collection::handler_id(collection::route::memory_size),
+            session,
+            database,
+            collection);
+        wait();
+        return std::get<result_memory_size>(intermediate_store_);
+    }
+
     auto wrapper_dispatcher_t::create_index(session_id_t &session, components::ql::create_index_t index) -> result_create_index {
         trace(log_, "wrapper_dispatcher_t::create_index session: {}, index: {}", session.data(), index.name());
         init();
@@ -351,6 +366,12 @@ namespace duck_charmer {
         notify();
     }
 
+    auto wrapper_dispatcher_t::memory_size_finish(session_id_t &session, result_memory_size result) -> void {
+        intermediate_store_ = result;
+        input_session_ = session;
+        notify();
+    }
+
     auto wrapper_dispatcher_t::create_index_finish(session_id_t &session, result_create_index result) -> void {
         intermediate_store_ = result;
         input_session_ = session;
@@ -44,6 +44,7 @@ namespace duck_charmer {
         auto update_one(session_id_t &session, components::ql::aggregate_statement_raw_ptr condition, document_ptr update, bool upsert) -> result_update&;
         auto update_many(session_id_t &session, components::ql::aggregate_statement_raw_ptr condition, document_ptr update, bool upsert) -> result_update&;
         auto size(session_id_t &session, const database_name_t &database, const collection_name_t &collection) -> result_size;
+        auto memory_size(session_id_t &session, const database_name_t &database, const collection_name_t &collection) -> result_memory_size;
         auto create_index(session_id_t &session, components::ql::create_index_t index) -> result_create_index;
         auto drop_index(session_id_t &session, components::ql::drop_index_t drop_index) -> result_drop_index;
         auto execute_ql(session_id_t& session, components::ql::variant_statement_t& query) -> result_t;
@@ -66,6 +67,7 @@ namespace duck_charmer {
         auto delete_finish(session_id_t &session, result_delete result) -> void;
         auto update_finish(session_id_t &session, result_update result) -> void;
         auto size_finish(session_id_t &session, result_size result) -> void;
+        auto memory_size_finish(session_id_t &session, result_memory_size result) -> void;
         auto create_index_finish(session_id_t &session, result_create_index result) -> void;
         auto drop_index_finish(session_id_t &session, result_drop_index result) -> void;
 
@@ -89,6 +91,7 @@ namespace duck_charmer {
             components::cursor::cursor_t*,
             result_find_one,
             result_size,
+            result_memory_size,
             result_delete,
             result_update,
             result_drop_collection,
@@ -187,9 +187,11 @@ void parse_find_condition_(std::pmr::memory_resource *resource, compare_expressi
             real_key = key_word;
         }
     }
+    // the list of $any and $all is the one array value they compare against
+    auto is_list_value = type == compare_type::any || type == compare_type::all;
     if (py::isinstance<py::dict>(condition)) {
         parse_find_condition_dict_(resource, parent_condition, condition, real_key, aggregate);
-    } else if (py::isinstance<py::list>(condition) || py::isinstance<py::tuple>(condition)) {
+    } else if ((py::isinstance<py::list>(condition) || py::isinstance<py::tuple>(condition)) && !is_list_value) {
         parse_find_condition_array_(resource, parent_condition, condition, real_key, aggregate);
     } else {
         auto value = aggregate->add_parameter(to_(condition).detach());
@@ -18,7 +18,8 @@ namespace services::collection {
         , database_name_(database->name()) //todo for run test [default: database->name()]
         , database_(database ? database->address() : actor_zeta::address_t::empty_address()) //todo for run test [default: database->address()]
         , mdisk_(std::move(mdisk))
-        , context_(std::make_unique<context_collection_t>(new std::pmr::monotonic_buffer_resource(), log.clone()))
+        , resource_(core::pmr::pool_resource_t::make())
+        , context_(std::make_unique<context_collection_t>(resource_.get(), log.clone()))
         , cursor_storage_(context_->resource()) {
         add_handler(handler_id(route::create_documents), &collection_t::create_documents);
         add_handler(handler_id(route::insert_documents), &collection_t::insert_documents);
@@ -27,6 +28,7 @@ namespace services::collection {
         add_handler(handler_id(route::delete_documents), &collection_t::delete_documents);
         add_handler(handler_id(route::update_documents), &collection_t::update_documents);
         add_handler(handler_id(route::size), &collection_t::size);
+        add_handler(handler_id(route::memory_size), &collection_t::memory_size);
         add_handler(handler_id(route::drop_collection), &collection_t::drop);
         add_handler(handler_id(route::close_cursor), &collection_t::close_cursor);
         add_handler(handler_id(route::create_index), &collection_t::create_index);
@@ -59,6 +61,15 @@ namespace services::collection {
         actor_zeta::send(dispatcher, address(), handler_id(route::size_finish), session, result);
     }
 
+    auto collection_t::memory_size(session_id_t& session) -> void {
+        trace(log(), "collection {}::memory_size", name_);
+        auto dispatcher = current_message()->sender();
+        auto result = dropped_
+                          ? result_memory_size()
+                          : result_memory_size(resource_->statistic());
+        actor_zeta::send(dispatcher, address(), handler_id(route::memory_size_finish), session, result);
+    }
+
     auto collection_t::insert_documents(
             const components::session::session_id_t& session,
             const components::logical_plan::node_ptr& logic_plan,
@@ -68,23 +79,27 @@ namespace services::collection {
         if (dropped_) {
             actor_zeta::send(dispatcher, address(), handler_id(route::insert_finish), session, nullptr);
         } else {
-            auto plan = planner::create_plan(view(), logic_plan, components::ql::limit_t::unlimit());
+            auto plan = planner::create_plan(view(), logic_plan, components::ql::limit_t::unlimit(), &parameters);
             if (!plan) {
                 actor_zeta::send(dispatcher, address(), handler_id(route::insert_finish), session, nullptr);
             } else {
                 components::pipeline::context_t pipeline_context{session, address(), std::move(parameters)};
                 plan->on_execute(&pipeline_context);
                 if (plan->is_executed()) {
+                    // encoded once here: the disk agents and the wal write the bytes on their own threads,
+                    // while updates change the stored documents in place
+                    auto packed_documents = components::document::pack_documents(
+                        plan->output()
+                        ? plan->output()->documents()
+                        : std::pmr::vector<document_ptr>{context_->resource()});
                     actor_zeta::send(mdisk_, address(), disk::handler_id(disk::route::write_documents),
-                                     session, std::string(database_name_), std::string(name_),
-                                     plan->output()
-                                     ? plan->output()->documents()
-                                     : std::pmr::vector<document_ptr>{context_->resource()});
+                                     session, std::string(database_name_), std::string(name_), packed_documents);
                     actor_zeta::send(dispatcher, address(), handler_id(route::insert_finish), session,
                                      result_insert{
                                          plan->modified()
                                          ? std::move(plan->modified()->documents())
-                                         : std::pmr::vector<document_id_t>{context_->resource()}
+                                         : std::pmr::vector<document_id_t>{context_->resource()},
+                                         packed_documents
                                      });
                 } else {
                     sessions::make_session(sessions_, session, sessions::suspend_plan_t{
@@ -106,7 +121,7 @@ namespace services::collection {
         if (dropped_) {
             actor_zeta::send(dispatcher, address(), handler_id(route::find_finish), session, nullptr);
         } else {
-            auto plan = planner::create_plan(view(), logic_plan, components::ql::limit_t::unlimit());
+            auto plan = planner::create_plan(view(), logic_plan, components::ql::limit_t::unlimit(), &parameters);
             if (!plan) {
                 actor_zeta::send(dispatcher, address(), handler_id(route::find_finish), session, nullptr);
             } else {
@@ -136,7 +151,7 @@ namespace services::collection {
         if (dropped_) {
             actor_zeta::send(dispatcher, address(), handler_id(route::find_one_finish), session, nullptr);
         } else {
-            auto plan = planner::create_plan(view(), logic_plan, components::ql::limit_t::limit_one());
+            auto plan = planner::create_plan(view(), logic_plan, components::ql::limit_t::limit_one(), &parameters);
             if (!plan) {
                 actor_zeta::send(dispatcher, address(), handler_id(route::find_one_finish), session, nullptr);
             } else {
@@ -164,7 +179,7 @@ namespace services::collection {
         if (dropped_) {
             actor_zeta::send(dispatcher, address(), handler_id(route::delete_finish), session, result_delete(context_->resource()));
         } else {
-            auto plan = planner::create_plan(view(), logic_plan, components::ql::limit_t::limit_one());
+            auto plan = planner::create_plan(view(), logic_plan, components::ql::limit_t::limit_one(), &parameters);
             if (!plan) {
                 actor_zeta::send(dispatcher, address(), handler_id(route::delete_finish), session, result_delete(context_->resource()));
             } else {
@@ -195,7 +210,7 @@ namespace services::collection {
         if (dropped_) {
             actor_zeta::send(dispatcher, address(), handler_id(route::update_finish), session, result_update(context_->resource()));
         } else {
-            auto plan = planner::create_plan(view(), logic_plan, components::ql::limit_t::unlimit());
+            auto plan = planner::create_plan(view(), logic_plan, components::ql::limit_t::unlimit(), &parameters);
             if (!plan) {
                 actor_zeta::send(dispatcher, address(), handler_id(route::update_finish), session, result_update(context_->resource()));
             } else {
@@ -273,6 +288,10 @@ namespace services::collection {
         return size_();
     }
 
+    core::pmr::pool_resource_t::statistic_t collection_t::memory_size_test() const {
+        return resource_->statistic();
+    }
+
 #endif
 
 } // namespace services::collection
@@ -5,8 +5,10 @@
 
 #include <core/btree/btree.hpp>
 #include <core/pmr.hpp>
+#include <core/pool_resource.hpp>
 
 #include <components/cursor/cursor.hpp>
+#include <components/document/core/heap_pool.hpp>
 #include <components/document/document.hpp>
 #include <components/document/document_view.hpp>
 #include <components/index/index_engine.hpp>
@@ -40,7 +42,8 @@ namespace services::collection {
             , log_(log)
             , index_engine_(core::pmr::make_unique<components::index::index_engine_t>(resource_))
             , statistic_(resource_)
-            , storage_(resource_) {
+            , storage_(resource_)
+            , heap_pool_(::document::impl::heap_pool_t::make()) {
             assert(resource != nullptr);
         }
 
@@ -60,6 +63,10 @@ namespace services::collection {
             return resource_;
         }
 
+        ::document::impl::heap_pool_t* heap_pool() const noexcept {
+            return heap_pool_.get();
+        }
+
         log_t& log() noexcept {
             return log_;
         }
@@ -77,6 +84,11 @@ namespace services::collection {
         */
         components::statistic::statistic_t statistic_;
         storage_t storage_;
+        /**
+        *  heap values of the documents built by the plans of the collection;
+        *  they are released on other threads and may outlive the collection, so the pool does not draw on resource_
+        */
+        ::document::impl::heap_pool_ptr heap_pool_;
     };
 
     class collection_t final : public actor_zeta::basic_async_actor {
@@ -85,6 +97,7 @@ namespace services::collection {
         ~collection_t();
         auto create_documents(session_id_t& session, std::pmr::vector<document_ptr>& documents) -> void;
         auto size(session_id_t& session) -> void;
+        auto memory_size(session_id_t& session) -> void;
 
         auto insert_documents(
                 const components::session::session_id_t& session,
@@ -115,10 +128,10 @@ namespace services::collection {
         void close_cursor(session_id_t& session);
 
         void create_index(const session_id_t& session, components::ql::create_index_t& index);
-        void create_index_finish(const session_id_t& session, const std::string& name, const actor_zeta::address_t& index_address);
+        void create_index_finish(const session_id_t& session, const std::string& name, const actor_zeta::address_t& index_address, bool is_new);
         void drop_index(const session_id_t& session, components::ql::drop_index_t& index);
         void index_modify_finish(const session_id_t& session);
-        void index_find_finish(const session_id_t& session, const std::pmr::vector<document_id_t>& result);
+        void index_find_finish(const session_id_t& session, const std::pmr::vector<document_id_t>& result, bool is_last);
 
         context_collection_t* view() const;
 
@@ -128,6 +141,9 @@ namespace services::collection {
         std::size_t size_() const;
         bool drop_();
 
+        template<class Index, class... Args>
+        void create_index_(const session_id_t& session, components::ql::create_index_t& index, const components::ql::keys_base_storage_t& keys, Args&&... args);
+
         log_t& log() noexcept;
 
         const std::string name_;
@@ -135,6 +151,8 @@ namespace services::collection {
         actor_zeta::address_t database_;
         actor_zeta::address_t mdisk_;
 
+        // storage, indexes, cursors and operator outputs of the collection, freed blocks are reused
+        core::pmr::pool_resource_ptr resource_;
         std::unique_ptr<context_collection_t> context_;
         std::pmr::unordered_map<session_id_t, std::unique_ptr<components::cursor::sub_cursor_t>> cursor_storage_;
         sessions::sessions_storage_t sessions_;
@@ -143,6 +161,7 @@ namespace services::collection {
 #ifdef DEV_MODE
     public:
         std::size_t size_test() const;
+        core::pmr::pool_resource_t::statistic_t memory_size_test() const;
 #endif
     };
 
@@ -1,14 +1,23 @@
 #include "collection.hpp"
 
 #include <components/index/disk/route.hpp>
+#include <components/index/composite_field_index.hpp>
+#include <components/index/hash_index.hpp>
+#include <components/index/multikey_index.hpp>
 #include <components/index/single_field_index.hpp>
+#include <components/index/wildcard_index.hpp>
+#include <services/collection/operators/predicates/predicate.hpp>
 #include <services/disk/index_disk.hpp>
 
 using components::ql::create_index_t;
 using components::ql::index_type;
 
 using components::index::make_index;
+using components::index::composite_field_index_t;
+using components::index::hash_index_t;
+using components::index::multikey_index_t;
 using components::index::single_field_index_t;
+using components::index::wildcard_index_t;
 
 namespace services::collection {
 
@@ -39,44 +48,93 @@ namespace services::collection {
         return result;
     }
 
+    // sparse and partial options of the statement; the partial filter, a predicate or an $and of them,
+    // is checked by the predicates of a match against every document on its way into the index
+    void set_index_options(context_collection_t* context, uint32_t id_index, const create_index_t& index) {
+        auto* target = components::index::search_index(context->index_engine(), id_index);
+        target->set_sparse(index.sparse_);
+        target->set_compare_type(index.index_compare_);
+        if (index.partial_filter_) {
+            struct filter_t {
+                components::expressions::compare_expression_ptr expr;
+                components::ql::storage_parameters parameters;
+                std::vector<operators::predicates::predicate_ptr> predicates;
+            };
+            auto filter = std::make_shared<filter_t>(filter_t{index.partial_filter_, index.partial_parameters_, {}});
+            if (filter->expr->type() == components::expressions::compare_type::union_and) {
+                for (const auto& child : filter->expr->children()) {
+                    filter->predicates.push_back(operators::predicates::create_predicate(context, child));
+                }
+            } else {
+                filter->predicates.push_back(operators::predicates::create_predicate(context, filter->expr));
+            }
+            target->set_partial_filter(filter->expr, filter->parameters, [filter](const components::document::document_ptr& document) {
+                return std::all_of(filter->predicates.begin(), filter->predicates.end(), [&](const operators::predicates::predicate_ptr& predicate) {
+                    return predicate->check(document, &filter->parameters);
+                });
+            });
+        }
+    }
+
+    template<class Index, class... Args>
+    void collection_t::create_index_(const session_id_t& session, create_index_t& index, const components::ql::keys_base_storage_t& keys, Args&&... args) {
+        auto id_index = make_index<Index>(context_->index_engine(), index.name(), keys, std::forward<Args>(args)...);
+        set_index_options(view(), id_index, index);
+        sessions::make_session(sessions_, session, index.name(), sessions::create_index_t{current_message()->sender(), id_index});
+        actor_zeta::send(mdisk_, address(), index::handler_id(index::route::create), session, index);
+    }
+
     void collection_t::create_index(const session_id_t& session, create_index_t& index) {
         debug(log(), "collection::create_index : {} {} {}", name_, name_index_type(index.index_type_), keys_index(index.keys_)); //todo: maybe delete
         if (dropped_) {
             actor_zeta::send(current_message()->sender(), address(), handler_id(route::create_index_finish), session, result_create_index(false));
         } else {
             switch (index.index_type_) {
-
-                case index_type::single: {
-                    auto id_index = make_index<single_field_index_t>(context_->index_engine(), index.name(), index.keys_);
-                    sessions::make_session(sessions_, session, index.name(), sessions::create_index_t{current_message()->sender(), id_index});
-                    actor_zeta::send(mdisk_, address(), index::handler_id(index::route::create), session, index);
+                case index_type::single:
+                    create_index_<single_field_index_t>(session, index, index.keys_);
                     break;
-                }
-
-                case index_type::composite: {
+                case index_type::composite:
+                    create_index_<composite_field_index_t>(session, index, index.keys_);
                     break;
-                }
-
-                case index_type::multikey: {
+                case index_type::multikey:
+                    create_index_<multikey_index_t>(session, index, index.keys_);
                     break;
-                }
-
-                case index_type::hashed: {
+                case index_type::hashed:
+                    create_index_<hash_index_t>(session, index, index.keys_);
                     break;
-                }
-
                 case index_type::wildcard: {
+                    // whatever the keys of the statement, the planner finds a wildcard index by its own key
+                    components::ql::keys_base_storage_t keys(context_->resource());
+                    keys.emplace_back(wildcard_index_t::key);
+                    create_index_<wildcard_index_t>(session, index, keys, index.include_paths_, index.exclude_paths_);
                     break;
                 }
             }
         }
     }
 
-    void collection_t::create_index_finish(const session_id_t& session, const std::string& name, const actor_zeta::address_t& index_address) {
+    void collection_t::create_index_finish(const session_id_t& session, const std::string& name, const actor_zeta::address_t& index_address, bool is_new) {
         debug(log(), "collection::create_index_finish");
         auto &create_index = sessions::find(sessions_, session, name).get<sessions::create_index_t>();
         components::index::set_disk_agent(context_->index_engine(), create_index.id_index, index_address);
         components::index::insert(context_->index_engine(), create_index.id_index, context_->storage());
+        auto* index = components::index::search_index(context_->index_engine(), create_index.id_index);
+        if (is_new && index->is_disk()) {
+            // an empty disk index, new or dropped for a former format, gets the keys of all the documents;
+            // the batch goes under its own session, the statement may still wait for other indexes
+            services::index::batch_t batch(context_->resource());
+            for (const auto& [id, document] : context_->storage()) {
+                auto key = index->entry(document);
+                if (!key.empty()) {
+                    for (const auto& stored_key : index->stored_keys(key)) {
+                        batch.push_back(services::index::make_delta(services::index::delta_type::insert, stored_key, id, index->compare_type()));
+                    }
+                }
+            }
+            if (!batch.empty()) {
+                actor_zeta::send(index_address, address(), index::handler_id(index::route::batch), session_id_t(), std::move(batch));
+            }
+        }
         actor_zeta::send(create_index.client, address(), handler_id(route::create_index_finish), session, name, result_create_index(true));
         sessions::remove(sessions_, session, name);
     }
@@ -104,10 +162,13 @@ namespace services::collection {
         sessions::remove(sessions_, session);
     }
 
-    void collection_t::index_find_finish(const session_id_t& session, const std::pmr::vector<document_id_t>& result) {
+    void collection_t::index_find_finish(const session_id_t& session, const std::pmr::vector<document_id_t>& result, bool is_last) {
         debug(log(), "collection::index_find_result: {}", result.size());
-        components::index::sync_index_from_disk(context_->index_engine(), current_message()->sender(), result, context_->storage());
         auto &suspend_plan = sessions::find(sessions_, session).get<sessions::suspend_plan_t>();
+        suspend_plan.plan->on_receive_ids(result);
+        if (!is_last) {
+            return;
+        }
         auto res = cursor_storage_.emplace(session, std::make_unique<components::cursor::sub_cursor_t>(context_->resource(), address()));
         suspend_plan.plan->on_execute(&suspend_plan.pipeline_context);
         if (suspend_plan.plan->is_executed()) {
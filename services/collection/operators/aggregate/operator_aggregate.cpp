@@ -16,4 +16,31 @@ namespace services::collection::operators::aggregate {
         return document::wrapper_value_t(document_view_t(output_->documents().at(0)).get_value(key_impl()));
     }
 
+    void operator_aggregate_t::accumulate(accumulator_t& accumulator, const document_ptr& document) const {
+        accumulate_impl(accumulator, document);
+    }
+
+    void operator_aggregate_t::set_value(const accumulator_t& accumulator, document_ptr& document, const std::string& name) const {
+        set_value_impl(accumulator, document, name);
+    }
+
+    void accumulate_sum(accumulator_t& accumulator, const document::wrapper_value_t& value) {
+        if (!value) {
+            return;
+        }
+        if (value->is_double()) {
+            if (!accumulator.is_double) {
+                accumulator.is_double = true;
+                accumulator.sum_double = double(accumulator.sum_int);
+            }
+            accumulator.sum_double += value->as_double();
+        } else if (value->is_int()) {
+            if (accumulator.is_double) {
+                accumulator.sum_double += double(value->as_int());
+            } else {
+                accumulator.sum_int += value->as_int();
+            }
+        }
+    }
+
 } // namespace services::collection::operators::aggregate
@@ -5,10 +5,22 @@
 
 namespace services::collection::operators::aggregate {
 
+    // running state of one aggregate over one group, updated document by document
+    struct accumulator_t {
+        document::wrapper_value_t value{nullptr};
+        int64_t sum_int{0};
+        double sum_double{0.0};
+        bool is_double{false};
+        std::size_t count{0};
+    };
+
     class operator_aggregate_t : public read_only_operator_t {
     public:
         document::wrapper_value_t value() const;
 
+        void accumulate(accumulator_t& accumulator, const components::document::document_ptr& document) const;
+        void set_value(const accumulator_t& accumulator, components::document::document_ptr& document, const std::string& name) const;
+
     protected:
         explicit operator_aggregate_t(context_collection_t* collection);
 
@@ -17,8 +29,12 @@ namespace services::collection::operators::aggregate {
 
         virtual components::document::document_ptr aggregate_impl() = 0;
         virtual std::string key_impl() const = 0;
+        virtual void accumulate_impl(accumulator_t& accumulator, const components::document::document_ptr& document) const = 0;
+        virtual void set_value_impl(const accumulator_t& accumulator, components::document::document_ptr& document, const std::string& name) const = 0;
     };
 
+    void accumulate_sum(accumulator_t& accumulator, const document::wrapper_value_t& value);
+
     using operator_aggregate_ptr = std::unique_ptr<operator_aggregate_t>;
 
 } // namespace services::operators::aggregate
\ No newline at end of file
@@ -7,7 +7,7 @@ namespace services::collection::operators::aggregate {
 
     operator_avg_t::operator_avg_t(context_collection_t *context, components::index::key_t key)
         : operator_aggregate_t(context)
-        , key_(std::move(key)) {
+        , path_(key.as_string()) {
     }
 
     document_ptr operator_avg_t::aggregate_impl() {
@@ -16,7 +16,7 @@ namespace services::collection::operators::aggregate {
             if (!documents.empty()) {
                 document::wrapper_value_t sum_(nullptr);
                 std::for_each(documents.cbegin(), documents.cend(), [&](const document_ptr& doc) {
-                    sum_ = sum(sum_, get_value_from_document(doc, key_));
+                    sum_ = sum(sum_, get_value_from_document(doc, path_));
                 });
                 return components::document::make_document(key_result_, sum_->as_double() / double(documents.size()));
             }
@@ -28,4 +28,14 @@ namespace services::collection::operators::aggregate {
         return key_result_;
     }
 
+    void operator_avg_t::accumulate_impl(accumulator_t& accumulator, const document_ptr& document) const {
+        ++accumulator.count;
+        accumulate_sum(accumulator, get_value_from_document(document, path_));
+    }
+
+    void operator_avg_t::set_value_impl(const accumulator_t& accumulator, document_ptr& document, const std::string& name) const {
+        auto sum = accumulator.is_double ? accumulator.sum_double : double(accumulator.sum_int);
+        document->set(name, accumulator.count ? sum / double(accumulator.count) : 0.0);
+    }
+
 } // namespace services::collection::operators::aggregate
@@ -20,4 +20,12 @@ namespace services::collection::operators::aggregate {
         return key_result_;
     }
 
+    void operator_count_t::accumulate_impl(accumulator_t& accumulator, const document_ptr&) const {
+        ++accumulator.count;
+    }
+
+    void operator_count_t::set_value_impl(const accumulator_t& accumulator, document_ptr& document, const std::string& name) const {
+        document->set(name, uint64_t(accumulator.count));
+    }
+
 } // namespace services::collection::operators::aggregate
\ No newline at end of file
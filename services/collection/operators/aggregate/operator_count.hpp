@@ -12,6 +12,8 @@ namespace services::collection::operators::aggregate {
     private:
         components::document::document_ptr aggregate_impl() final;
         std::string key_impl() const final;
+        void accumulate_impl(accumulator_t& accumulator, const components::document::document_ptr& document) const final;
+        void set_value_impl(const accumulator_t& accumulator, components::document::document_ptr& document, const std::string& name) const final;
     };
 
 } // namespace services::operators::aggregate
\ No newline at end of file
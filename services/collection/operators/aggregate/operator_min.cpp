@@ -7,17 +7,17 @@ namespace services::collection::operators::aggregate {
 
     operator_min_t::operator_min_t(context_collection_t *context, components::index::key_t key)
         : operator_aggregate_t(context)
-        , key_(std::move(key)) {
+        , path_(key.as_string()) {
     }
 
     document_ptr operator_min_t::aggregate_impl() {
         if (left_ && left_->output()) {
             const auto &documents = left_->output()->documents();
             auto min = std::min_element(documents.cbegin(), documents.cend(), [&](const document_ptr &doc1, const document_ptr &doc2) {
-                return get_value_from_document(doc1, key_) < get_value_from_document(doc2, key_);
+                return get_value_from_document(doc1, path_) < get_value_from_document(doc2, path_);
             });
             if (min != documents.cend()) {
-                return components::document::make_document(key_result_, *get_value_from_document(*min, key_));
+                return components::document::make_document(key_result_, *get_value_from_document(*min, path_));
             }
         }
         return components::document::make_document(key_result_, 0);
@@ -27,4 +27,19 @@ namespace services::collection::operators::aggregate {
         return key_result_;
     }
 
+    void operator_min_t::accumulate_impl(accumulator_t& accumulator, const document_ptr& document) const {
+        auto value = get_value_from_document(document, path_);
+        if (value && (!accumulator.value || value < accumulator.value)) {
+            accumulator.value = value;
+        }
+    }
+
+    void operator_min_t::set_value_impl(const accumulator_t& accumulator, document_ptr& document, const std::string& name) const {
+        if (accumulator.value) {
+            document->set(name, *accumulator.value);
+        } else {
+            document->set(name, 0);
+        }
+    }
+
 } // namespace services::collection::operators::aggregate
@@ -11,10 +11,12 @@ namespace services::collection::operators::aggregate {
         explicit operator_min_t(context_collection_t *collection, components::index::key_t key);
 
     private:
-        components::index::key_t key_;
+        const components::document::field_path_t path_;
 
         components::document::document_ptr aggregate_impl() final;
         std::string key_impl() const final;
+        void accumulate_impl(accumulator_t& accumulator, const components::document::document_ptr& document) const final;
+        void set_value_impl(const accumulator_t& accumulator, components::document::document_ptr& document, const std::string& name) const final;
     };
 
 } // namespace services::operators::aggregate
\ No newline at end of file
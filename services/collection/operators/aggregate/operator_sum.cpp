@@ -7,7 +7,7 @@ namespace services::collection::operators::aggregate {
 
     operator_sum_t::operator_sum_t(context_collection_t *context, components::index::key_t key)
         : operator_aggregate_t(context)
-        , key_(std::move(key)) {
+        , path_(key.as_string()) {
     }
 
     document_ptr operator_sum_t::aggregate_impl() {
@@ -15,7 +15,7 @@ namespace services::collection::operators::aggregate {
             const auto &documents = left_->output()->documents();
             document::wrapper_value_t sum_(nullptr);
             std::for_each(documents.cbegin(), documents.cend(), [&](const document_ptr &doc) {
-                sum_ = sum(sum_, get_value_from_document(doc, key_));
+                sum_ = sum(sum_, get_value_from_document(doc, path_));
             });
             return components::document::make_document(key_result_, *sum_);
         }
@@ -26,4 +26,16 @@ namespace services::collection::operators::aggregate {
         return key_result_;
     }
 
+    void operator_sum_t::accumulate_impl(accumulator_t& accumulator, const document_ptr& document) const {
+        accumulate_sum(accumulator, get_value_from_document(document, path_));
+    }
+
+    void operator_sum_t::set_value_impl(const accumulator_t& accumulator, document_ptr& document, const std::string& name) const {
+        if (accumulator.is_double) {
+            document->set(name, accumulator.sum_double);
+        } else {
+            document->set(name, accumulator.sum_int);
+        }
+    }
+
 } // namespace services::collection::operators::aggregate
@@ -8,11 +8,11 @@ namespace services::collection::operators::get {
 
     simple_value_t::simple_value_t(const components::expressions::key_t &key)
         : operator_get_t()
-        , key_(key) {
+        , path_(key.as_string()) {
     }
 
     document::wrapper_value_t simple_value_t::get_value_impl(const components::document::document_ptr& document) {
-        return get_value_from_document(document, key_);
+        return get_value_from_document(document, path_);
     }
 
 } // namespace services::collection::operators::get
@@ -9,7 +9,7 @@ namespace services::collection::operators::get {
         static operator_get_ptr create(const components::expressions::key_t &key);
 
     private:
-        const components::expressions::key_t key_;
+        const components::document::field_path_t path_;
 
         explicit simple_value_t(const components::expressions::key_t &key);
 
@@ -1,4 +1,5 @@
 #include "operator_and.hpp"
+#include <unordered_set>
 #include <services/collection/collection.hpp>
 
 namespace services::collection::operators::merge {
@@ -7,25 +8,34 @@ namespace services::collection::operators::merge {
         : operator_merge_t(context, limit) {
     }
 
+    bool operator_and_t::is_skip_right_impl() const {
+        return is_empty(left_);
+    }
+
     void operator_and_t::on_merge_impl(components::pipeline::context_t*) {
-        //todo: optimize merge
         int count = 0;
         if (!limit_.check(count)) {
             return; //limit = 0
         }
-        if (left_ && right_ && left_->output() && right_->output()) {
-            output_ = make_operator_data(context_->resource());
-            const auto &right_documents = right_->output()->documents();
-            for (const auto &left_document : left_->output()->documents()) {
-                auto it = std::find_if(right_documents.cbegin(), right_documents.cend(), [&left_document](const document_ptr &doc) {
-                    return get_document_id(doc) == get_document_id(left_document);
-                });
-                if (it != right_documents.cend()) {
-                    output_->append(left_document);
-                    ++count;
-                    if (!limit_.check(count)) {
-                        return;
-                    }
+        output_ = make_operator_data(context_->resource());
+        if (!right_) {
+            append_all(left_, count);
+            return;
+        }
+        if (is_empty(left_) || is_empty(right_)) {
+            return;
+        }
+        const auto &right_documents = right_->output()->documents();
+        std::pmr::unordered_set<document_id_t, document_id_t::hash_t> right_ids(right_documents.size(), context_->resource());
+        for (const auto &document : right_documents) {
+            right_ids.insert(get_document_id(document));
+        }
+        for (const auto &left_document : left_->output()->documents()) {
+            if (right_ids.count(get_document_id(left_document))) {
+                output_->append(left_document);
+                ++count;
+                if (!limit_.check(count)) {
+                    return;
                 }
             }
         }
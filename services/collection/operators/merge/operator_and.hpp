@@ -10,6 +10,7 @@ namespace services::collection::operators::merge {
 
     private:
         void on_merge_impl(components::pipeline::context_t* pipeline_context) final;
+        bool is_skip_right_impl() const final;
     };
 
 } // namespace services::collection::operators::merge
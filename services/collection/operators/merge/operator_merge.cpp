@@ -14,6 +14,23 @@ namespace services::collection::operators::merge {
         on_merge_impl(pipeline_context);
     }
 
+    bool operator_merge_t::is_empty(const operator_ptr& op) {
+        return !op || !op->output() || op->output()->documents().empty();
+    }
+
+    void operator_merge_t::append_all(const operator_ptr& op, int& count) {
+        if (is_empty(op)) {
+            return;
+        }
+        for (const auto &document : op->output()->documents()) {
+            if (!limit_.check(count)) {
+                return;
+            }
+            output_->append(document);
+            ++count;
+        }
+    }
+
     bool is_operator_merge(const components::expressions::compare_expression_ptr& expr) {
         return expr->is_union() && !expr->children().empty();
     }
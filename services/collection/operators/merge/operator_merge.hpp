@@ -13,6 +13,9 @@ namespace services::collection::operators::merge {
     protected:
         components::ql::limit_t limit_;
 
+        static bool is_empty(const operator_ptr& op);
+        void append_all(const operator_ptr& op, int& count);
+
     private:
         void on_execute_impl(components::pipeline::context_t* pipeline_context) final;
         virtual void on_merge_impl(components::pipeline::context_t* pipeline_context) = 0;
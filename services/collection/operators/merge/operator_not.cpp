@@ -1,4 +1,5 @@
 #include "operator_not.hpp"
+#include <unordered_set>
 #include <services/collection/collection.hpp>
 
 namespace services::collection::operators::merge {
@@ -8,7 +9,6 @@ namespace services::collection::operators::merge {
     }
 
     void operator_not_t::on_merge_impl(components::pipeline::context_t*) {
-        //todo: optimize merge
         int count = 0;
         if (!limit_.check(count)) {
             return; //limit = 0
@@ -16,11 +16,12 @@ namespace services::collection::operators::merge {
         if (left_ && left_->output()) {
             output_ = make_operator_data(context_->resource());
             const auto &left_documents = left_->output()->documents();
+            std::pmr::unordered_set<document_id_t, document_id_t::hash_t> ids(left_documents.size(), context_->resource());
+            for (const auto &document : left_documents) {
+                ids.insert(get_document_id(document));
+            }
             for (const auto &document : context_->storage()) {
-                auto it = std::find_if(left_documents.cbegin(), left_documents.cend(), [&document](const document_ptr &doc) {
-                    return get_document_id(doc) == document.first;
-                });
-                if (it == left_documents.cend()) {
+                if (!ids.count(document.first)) {
                     output_->append(document.second);
                     ++count;
                     if (!limit_.check(count)) {
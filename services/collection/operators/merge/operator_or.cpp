@@ -1,4 +1,5 @@
 #include "operator_or.hpp"
+#include <unordered_set>
 #include <services/collection/collection.hpp>
 
 namespace services::collection::operators::merge {
@@ -8,32 +9,37 @@ namespace services::collection::operators::merge {
     }
 
     void operator_or_t::on_merge_impl(components::pipeline::context_t*) {
-        //todo: optimize merge
         int count = 0;
         if (!limit_.check(count)) {
             return; //limit = 0
         }
-        if (left_ && right_ && left_->output() && right_->output()) {
-            output_ = make_operator_data(context_->resource());
-            for (const auto &document : left_->output()->documents()) {
+        output_ = make_operator_data(context_->resource());
+        if (is_empty(right_)) {
+            append_all(left_, count);
+            return;
+        }
+        if (is_empty(left_)) {
+            append_all(right_, count);
+            return;
+        }
+        const auto &left_documents = left_->output()->documents();
+        std::pmr::unordered_set<document_id_t, document_id_t::hash_t> ids(left_documents.size(), context_->resource());
+        for (const auto &document : left_documents) {
+            ids.insert(get_document_id(document));
+            output_->append(document);
+            ++count;
+            if (!limit_.check(count)) {
+                return;
+            }
+        }
+        for (const auto &document : right_->output()->documents()) {
+            if (ids.insert(get_document_id(document)).second) {
                 output_->append(document);
                 ++count;
                 if (!limit_.check(count)) {
                     return;
                 }
             }
-            for (const auto &document : right_->output()->documents()) {
-                auto it = std::find_if(output_->documents().cbegin(), output_->documents().cend(), [&document](const document_ptr &doc) {
-                    return get_document_id(doc) == get_document_id(document);
-                });
-                if (it == output_->documents().cend()) {
-                    output_->append(document);
-                    ++count;
-                    if (!limit_.check(count)) {
-                        return;
-                    }
-                }
-            }
         }
     }
 
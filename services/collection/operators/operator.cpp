@@ -13,16 +13,18 @@ namespace services::collection::operators {
     }
 
     void operator_t::on_execute(components::pipeline::context_t* pipeline_context) {
+        ::document::impl::heap_allocation_scope_t heap_scope(context_ ? context_->heap_pool() : nullptr);
         if (state_ == operator_state::created || state_ == operator_state::running) {
             on_prepare_impl();
             state_ = operator_state::running;
             if (left_) {
                 left_->on_execute(pipeline_context);
             }
-            if (right_ && is_success(left_)) {
+            bool skip_right = right_ && is_success(left_) && is_skip_right_impl();
+            if (right_ && is_success(left_) && !skip_right) {
                 right_->on_execute(pipeline_context);
             }
-            if (is_success(left_) && is_success(right_)) {
+            if (is_success(left_) && (skip_right || is_success(right_))) {
                 on_execute_impl(pipeline_context);
                 if (!is_wait_sync_disk()) {
                     state_ = operator_state::executed;
@@ -38,6 +40,20 @@ namespace services::collection::operators {
         on_execute(pipeline_context);
     }
 
+    // a disk index streams the ids of its scan in chunks to the operator waiting for them
+    void operator_t::on_receive_ids(const std::pmr::vector<components::document::document_id_t>& ids) {
+        if (is_wait_sync_disk()) {
+            on_receive_ids_impl(ids);
+            return;
+        }
+        if (left_) {
+            left_->on_receive_ids(ids);
+        }
+        if (right_) {
+            right_->on_receive_ids(ids);
+        }
+    }
+
     void operator_t::async_wait() {
         state_ = operator_state::waiting;
     }
@@ -85,9 +101,16 @@ namespace services::collection::operators {
     void operator_t::on_resume_impl(components::pipeline::context_t*) {
     }
 
+    void operator_t::on_receive_ids_impl(const std::pmr::vector<components::document::document_id_t>&) {
+    }
+
     void operator_t::on_prepare_impl() {
     }
 
+    bool operator_t::is_skip_right_impl() const {
+        return false;
+    }
+
 
     read_only_operator_t::read_only_operator_t(context_collection_t* collection, operator_type type)
         : operator_t(collection, type) {
@@ -100,7 +123,14 @@ namespace services::collection::operators {
     }
 
     ::document::wrapper_value_t get_value_from_document(const components::document::document_ptr &doc, const components::expressions::key_t &key) {
+        if (!doc) {
+            return ::document::wrapper_value_t(static_cast<const ::document::impl::value_t*>(nullptr));
+        }
         return ::document::wrapper_value_t(components::document::document_view_t(doc).get_value(key.as_string()));
     }
 
+    ::document::wrapper_value_t get_value_from_document(const components::document::document_ptr &doc, const components::document::field_path_t &path) {
+        return ::document::wrapper_value_t(path.get(doc));
+    }
+
 } // namespace services::collection::operators
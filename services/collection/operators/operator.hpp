@@ -1,5 +1,6 @@
 #pragma once
 
+#include <components/document/field_path.hpp>
 #include <components/pipeline/context.hpp>
 #include <services/collection/operators/operator_data.hpp>
 #include <services/collection/operators/operator_write_data.hpp>
@@ -43,6 +44,7 @@ namespace services::collection::operators {
 
         void on_execute(components::pipeline::context_t* pipeline_context);
         void on_resume(components::pipeline::context_t* pipeline_context);
+        void on_receive_ids(const std::pmr::vector<components::document::document_id_t>& ids);
         void async_wait();
 
         bool is_executed() const;
@@ -67,7 +69,9 @@ namespace services::collection::operators {
     private:
         virtual void on_execute_impl(components::pipeline::context_t* pipeline_context) = 0;
         virtual void on_resume_impl(components::pipeline::context_t* pipeline_context);
+        virtual void on_receive_ids_impl(const std::pmr::vector<components::document::document_id_t>& ids);
         virtual void on_prepare_impl();
+        virtual bool is_skip_right_impl() const;
 
         const operator_type type_;
         operator_state state_ {operator_state::created};
@@ -100,5 +104,6 @@ namespace services::collection::operators {
     using operator_ptr = operator_t::ptr;
 
     ::document::wrapper_value_t get_value_from_document(const components::document::document_ptr &doc, const components::expressions::key_t &key);
+    ::document::wrapper_value_t get_value_from_document(const components::document::document_ptr &doc, const components::document::field_path_t &path);
 
 } // namespace services::collection::operators
@@ -17,6 +17,7 @@ namespace services::collection::operators {
                     context_->index_engine()->delete_document(document, pipeline_context);
                 }
             }
+            context_->index_engine()->flush(pipeline_context);
         }
     }
 
@@ -1,14 +1,94 @@
 #include "operator_group.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
 #include <services/collection/collection.hpp>
-#include <services/collection/operators/operator_empty.hpp>
 
 namespace services::collection::operators {
 
+    namespace {
+
+        std::size_t hash_combine(std::size_t seed, std::size_t value) {
+            return seed ^ (value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2));
+        }
+
+        // numbers group by value whatever their representation: integral floats count as the integer they hold,
+        // so 1, 1u and 1.0 fall into one group
+        struct number_key_t {
+            enum class kind_t : uint8_t {
+                integer,
+                big_unsigned,
+                floating
+            };
+            kind_t kind;
+            uint64_t bits;
+
+            bool operator==(const number_key_t& other) const {
+                return kind == other.kind && bits == other.bits;
+            }
+        };
+
+        number_key_t number_key(const ::document::impl::value_t* value) {
+            using kind_t = number_key_t::kind_t;
+            if (!value->is_int()) {
+                auto number = value->as_double();
+                if (std::trunc(number) == number) {
+                    if (number >= -0x1p63 && number < 0x1p63) {
+                        return {kind_t::integer, static_cast<uint64_t>(static_cast<int64_t>(number))};
+                    }
+                    if (number >= 0x1p63 && number < 0x1p64) {
+                        return {kind_t::big_unsigned, static_cast<uint64_t>(number)};
+                    }
+                }
+                uint64_t bits;
+                std::memcpy(&bits, &number, sizeof(bits));
+                return {kind_t::floating, bits};
+            }
+            if (value->is_unsigned() && value->as_unsigned() > uint64_t(std::numeric_limits<int64_t>::max())) {
+                return {kind_t::big_unsigned, value->as_unsigned()};
+            }
+            return {kind_t::integer, static_cast<uint64_t>(value->as_int())};
+        }
+
+        std::size_t hash_value(const document::wrapper_value_t& value) {
+            using ::document::impl::value_type;
+            auto type = value->type();
+            std::size_t hash = std::size_t(type);
+            switch (type) {
+                case value_type::boolean:
+                    return hash_combine(hash, std::size_t(value->as_bool()));
+                case value_type::number: {
+                    auto key = number_key(*value);
+                    return hash_combine(hash_combine(hash, std::size_t(key.kind)), std::hash<uint64_t>()(key.bits));
+                }
+                case value_type::string:
+                    return hash_combine(hash, std::hash<std::string_view>()(value->as_string()));
+                case value_type::array:
+                case value_type::dict:
+                    return hash_combine(hash, std::hash<std::string>()(to_string(*value)));
+                default:
+                    return hash;
+            }
+        }
+
+        bool is_equal_value(const document::wrapper_value_t& value1, const document::wrapper_value_t& value2) {
+            using ::document::impl::value_type;
+            if (value1->type() == value_type::number && value2->type() == value_type::number) {
+                return number_key(*value1) == number_key(*value2);
+            }
+            return value1 == value2;
+        }
+
+    } // namespace
+
     operator_group_t::operator_group_t(context_collection_t* context)
         : read_write_operator_t(context, operator_type::aggregate)
         , keys_(context->resource())
         , values_(context->resource())
-        , input_documents_(context->resource()) {}
+        , groups_(context->resource())
+        , group_keys_(context->resource())
+        , accumulators_(context->resource()) {}
 
     void operator_group_t::add_key(const std::string &name, get::operator_get_ptr &&getter) {
         keys_.push_back({name, std::move(getter)});
@@ -18,55 +98,71 @@ namespace services::collection::operators {
         values_.push_back({name, std::move(aggregator)});
     }
 
-    void operator_group_t::on_execute_impl(components::pipeline::context_t* pipeline_context) {
+    void operator_group_t::on_execute_impl(components::pipeline::context_t*) {
         if (left_ && left_->output()) {
             output_ = make_operator_data(context_->resource());
             create_list_documents();
-            calc_aggregate_values(pipeline_context);
+            calc_aggregate_values();
+            groups_.clear();
+            group_keys_.clear();
+            accumulators_.clear();
         }
     }
 
     void operator_group_t::create_list_documents() {
+        std::pmr::vector<document::wrapper_value_t> key_values(context_->resource());
+        key_values.reserve(keys_.size());
         for (const auto& doc : left_->output()->documents()) {
-            auto new_doc = components::document::make_document();
+            key_values.clear();
+            std::size_t hash = 0;
             bool is_valid = true;
             for (const auto& key : keys_) {
                 auto value = key.getter->value(doc);
-                if (value) {
-                    new_doc->set(key.name, *value);
-                } else {
+                if (!value) {
                     is_valid = false;
                     break;
                 }
+                hash = hash_combine(hash, hash_value(value));
+                key_values.push_back(value);
             }
             if (is_valid) {
-                bool is_new = true;
-                for (std::size_t i = 0; i < output_->documents().size(); ++i) {
-                    if (is_equals_documents(new_doc, output_->documents().at(i))) {
-                        input_documents_.at(i)->append(doc);
-                        is_new = false;
-                        break;
-                    }
-                }
-                if (is_new) {
-                    output_->append(new_doc);
-                    auto input_doc = make_operator_data(context_->resource());
-                    input_doc->append(doc);
-                    input_documents_.push_back(std::move(input_doc));
+                auto group = find_or_create_group_(hash, key_values);
+                auto* accumulators = accumulators_.data() + group * values_.size();
+                for (std::size_t i = 0; i < values_.size(); ++i) {
+                    values_[i].aggregator->accumulate(accumulators[i], doc);
                 }
             }
         }
     }
 
-    void operator_group_t::calc_aggregate_values(components::pipeline::context_t* pipeline_context) {
-        for (const auto &value : values_) {
-            auto &aggregator = value.aggregator;
-            for (std::size_t i = 0; i < output_->documents().size(); ++i) {
-                auto &document = output_->documents().at(i);
-                aggregator->clear(); //todo: need copy aggregator
-                aggregator->set_children(std::make_unique<operator_empty_t>(context_, input_documents_.at(i)->copy()));
-                aggregator->on_execute(pipeline_context);
-                document->set(value.name, *aggregator->value());
+    std::size_t operator_group_t::find_or_create_group_(std::size_t hash, const std::pmr::vector<document::wrapper_value_t>& key_values) {
+        auto range = groups_.equal_range(hash);
+        for (auto it = range.first; it != range.second; ++it) {
+            auto group_key = group_keys_.begin() + std::ptrdiff_t(it->second * keys_.size());
+            if (std::equal(key_values.begin(), key_values.end(), group_key, is_equal_value)) {
+                return it->second;
+            }
+        }
+        auto group = output_->size();
+        auto new_doc = components::document::make_document();
+        for (std::size_t i = 0; i < keys_.size(); ++i) {
+            new_doc->set(keys_[i].name, *key_values[i]);
+        }
+        output_->append(new_doc);
+        group_keys_.insert(group_keys_.end(), key_values.begin(), key_values.end());
+        accumulators_.resize(accumulators_.size() + values_.size());
+        groups_.emplace(hash, group);
+        return group;
+    }
+
+    void operator_group_t::calc_aggregate_values() {
+        if (values_.empty()) {
+            return;
+        }
+        for (std::size_t group = 0; group < output_->documents().size(); ++group) {
+            auto &document = output_->documents().at(group);
+            for (std::size_t i = 0; i < values_.size(); ++i) {
+                values_[i].aggregator->set_value(accumulators_[group * values_.size() + i], document, values_[i].name);
             }
         }
     }
@@ -3,6 +3,8 @@
 #include <services/collection/operators/operator.hpp>
 #include <services/collection/operators/get/operator_get.hpp>
 #include <services/collection/operators/aggregate/operator_aggregate.hpp>
+#include <memory_resource>
+#include <unordered_map>
 
 namespace services::collection::operators {
 
@@ -26,12 +28,15 @@ namespace services::collection::operators {
     private:
         std::pmr::vector<group_key_t> keys_;
         std::pmr::vector<group_value_t> values_;
-        std::pmr::vector<operator_data_ptr> input_documents_;
+        std::pmr::unordered_multimap<std::size_t, std::size_t> groups_;  // key hash -> group index
+        std::pmr::vector<document::wrapper_value_t> group_keys_;         // keys_.size() values per group
+        std::pmr::vector<aggregate::accumulator_t> accumulators_;        // values_.size() states per group
 
         void on_execute_impl(components::pipeline::context_t* pipeline_context) final;
 
         void create_list_documents();
-        void calc_aggregate_values(components::pipeline::context_t* pipeline_context);
+        void calc_aggregate_values();
+        std::size_t find_or_create_group_(std::size_t hash, const std::pmr::vector<document::wrapper_value_t>& key_values);
     };
 
 } // namespace services::collection::operators
\ No newline at end of file
@@ -27,6 +27,7 @@ namespace services::collection::operators {
             output_->append(document);
             modified_->append(id);
         }
+        context_->index_engine()->flush(pipeline_context);
     }
 
 } // namespace services::collection::operators
@@ -1,10 +1,50 @@
 #include "operator_sort.hpp"
+#include <algorithm>
+#include <numeric>
+#include <thread>
 #include <services/collection/collection.hpp>
 
 namespace services::collection::operators {
 
-    operator_sort_t::operator_sort_t(context_collection_t* context)
-        : read_only_operator_t(context, operator_type::sort) {
+    namespace {
+
+        // below this size spawning threads costs more than it saves
+        constexpr std::size_t parallel_sort_threshold = 1 << 16;
+        constexpr std::size_t max_sort_threads = 8;
+
+        template<class Iterator, class Compare>
+        void parallel_sort(Iterator begin, Iterator end, Compare compare) {
+            auto size = std::size_t(end - begin);
+            auto count_threads = std::min<std::size_t>(std::max(1u, std::thread::hardware_concurrency()), max_sort_threads);
+            if (size < parallel_sort_threshold || count_threads < 2) {
+                std::sort(begin, end, compare);
+                return;
+            }
+            std::vector<Iterator> bounds;
+            for (std::size_t i = 0; i <= count_threads; ++i) {
+                bounds.push_back(begin + std::ptrdiff_t(size * i / count_threads));
+            }
+            std::vector<std::thread> threads;
+            for (std::size_t i = 0; i < count_threads; ++i) {
+                threads.emplace_back([&bounds, &compare, i]() {
+                    std::sort(bounds[i], bounds[i + 1], compare);
+                });
+            }
+            for (auto& thread : threads) {
+                thread.join();
+            }
+            for (std::size_t step = 1; step < count_threads; step *= 2) {
+                for (std::size_t i = 0; i + step < count_threads; i += 2 * step) {
+                    std::inplace_merge(bounds[i], bounds[i + step], bounds[std::min(i + 2 * step, count_threads)], compare);
+                }
+            }
+        }
+
+    } // namespace
+
+    operator_sort_t::operator_sort_t(context_collection_t* context, components::ql::limit_t limit)
+        : read_only_operator_t(context, operator_type::sort)
+        , limit_(limit) {
     }
 
     void operator_sort_t::add(const std::string& key, operator_sort_t::order order_) {
@@ -20,11 +60,30 @@ namespace services::collection::operators {
     void operator_sort_t::on_execute_impl(components::pipeline::context_t*) {
         if (left_ && left_->output()) {
             output_ = make_operator_data(context_->resource());
-            for (const auto& document : left_->output()->documents()) {
-                output_->append(document);
+            const auto& documents = left_->output()->documents();
+            auto count_keys = sorter_.size();
+            std::pmr::vector<services::storage::sort::const_value_ptr> keys(documents.size() * count_keys, context_->resource());
+            for (std::size_t i = 0; i < documents.size(); ++i) {
+                sorter_.extract(documents[i], keys.data() + i * count_keys);
+            }
+            // ties are broken by input position, so the order is stable and strictly weak
+            auto compare = [this, &keys, count_keys](std::size_t index1, std::size_t index2) {
+                auto res = sorter_.compare(keys.data() + index1 * count_keys, keys.data() + index2 * count_keys);
+                return res == components::document::compare_t::equals ? index1 < index2 : res == components::document::compare_t::less;
+            };
+            std::pmr::vector<std::size_t> order(documents.size(), context_->resource());
+            std::iota(order.begin(), order.end(), std::size_t(0));
+            auto count = order.size();
+            if (limit_.limit() >= 0 && std::size_t(limit_.limit()) < order.size()) {
+                count = std::size_t(limit_.limit());
+                std::partial_sort(order.begin(), order.begin() + std::ptrdiff_t(count), order.end(), compare);
+            } else {
+                parallel_sort(order.begin(), order.end(), compare);
+            }
+            output_->documents().reserve(count);
+            for (std::size_t i = 0; i < count; ++i) {
+                output_->append(documents[order[i]]);
             }
-            auto &documents = output_->documents();
-            std::sort(documents.begin(), documents.end(), sorter_);
         }
     }
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <components/ql/aggregate/limit.hpp>
 #include <services/collection/operators/operator.hpp>
 #include <services/collection/sort.hpp>
 
@@ -9,13 +10,14 @@ namespace services::collection::operators {
     public:
         using order = services::storage::sort::order;
 
-        explicit operator_sort_t(context_collection_t* context);
+        explicit operator_sort_t(context_collection_t* context, components::ql::limit_t limit = components::ql::limit_t::unlimit());
 
         void add(const std::string& key, order order_ = order::ascending);
         void add(const std::vector<std::string>& keys, order order_ = order::ascending);
 
     private:
         services::storage::sort::sorter_t sorter_;
+        components::ql::limit_t limit_;
 
         void on_execute_impl(components::pipeline::context_t* pipeline_context) final;
     };
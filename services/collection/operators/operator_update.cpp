@@ -32,6 +32,7 @@ namespace services::collection::operators {
                     context_->index_engine()->insert_document(document, pipeline_context);
                 }
             }
+            context_->index_engine()->flush(pipeline_context);
         }
     }
 
@@ -0,0 +1,71 @@
+#include "regex_predicate.hpp"
+#include <cstring>
+#include <services/collection/operators/operator.hpp>
+
+namespace services::collection::operators::predicates {
+
+    bool is_regex_literal(std::string_view pattern) {
+        return pattern.find_first_of("\\^$.|?*+()[]{}") == std::string_view::npos;
+    }
+
+    regex_predicate::regex_predicate(context_collection_t* context, components::expressions::compare_expression_ptr expr)
+        : predicate(context)
+        , expr_(std::move(expr))
+        , path_(expr_->key().as_string()) {}
+
+    bool regex_predicate::check_impl(const components::document::document_ptr& document,
+                                     const components::ql::storage_parameters* parameters) {
+        auto it = parameters->find(expr_->value());
+        if (it == parameters->end()) {
+            return false;
+        }
+        auto pattern = it->second->as_string();
+        if (!compiled_ || pattern != pattern_) {
+            compile_(pattern);
+        }
+        auto value = get_value_from_document(document, path_);
+        return value && value->type() == document::impl::value_type::string && match_(value->as_string());
+    }
+
+    void regex_predicate::compile_(std::string_view pattern) {
+        pattern_ = std::string(pattern);
+        compiled_ = true;
+        auto anchored_begin = !pattern.empty() && pattern.front() == '^';
+        auto anchored_end = pattern.size() > std::size_t(anchored_begin) && pattern.back() == '$'
+                            && (pattern.size() < 2 || pattern[pattern.size() - 2] != '\\');
+        auto body = pattern.substr(anchored_begin ? 1 : 0);
+        body = body.substr(0, body.size() - (anchored_end ? 1 : 0));
+        if (is_regex_literal(body)) {
+            literal_ = std::string(body);
+            if (anchored_begin && anchored_end) {
+                mode_ = match_mode::exact;
+            } else if (anchored_begin) {
+                mode_ = match_mode::prefix;
+            } else if (anchored_end) {
+                mode_ = match_mode::suffix;
+            } else {
+                mode_ = match_mode::substring;
+            }
+            return;
+        }
+        mode_ = match_mode::regex;
+        regex_ = std::regex(pattern_, std::regex::ECMAScript | std::regex::optimize);
+    }
+
+    bool regex_predicate::match_(std::string_view value) const {
+        switch (mode_) {
+            case match_mode::substring:
+                return literal_.empty() || ::memmem(value.data(), value.size(), literal_.data(), literal_.size()) != nullptr;
+            case match_mode::prefix:
+                return value.substr(0, literal_.size()) == literal_;
+            case match_mode::suffix:
+                return value.size() >= literal_.size() && value.substr(value.size() - literal_.size()) == literal_;
+            case match_mode::exact:
+                return value == literal_;
+            case match_mode::regex:
+                return std::regex_search(value.begin(), value.end(), regex_);
+        }
+        return false;
+    }
+
+} // namespace services::collection::operators::predicates
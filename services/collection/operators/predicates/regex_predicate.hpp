@@ -0,0 +1,42 @@
+#pragma once
+
+#include <regex>
+#include <string>
+#include <components/document/field_path.hpp>
+#include "predicate.hpp"
+
+namespace services::collection::operators::predicates {
+
+    // The pattern is compiled once per plan and recompiled only when the
+    // parameter bound to expr->value() changes between executions.
+    class regex_predicate : public predicate {
+    public:
+        regex_predicate(context_collection_t* context, components::expressions::compare_expression_ptr expr);
+
+    private:
+        enum class match_mode {
+            substring,
+            prefix,
+            suffix,
+            exact,
+            regex
+        };
+
+        bool check_impl(const components::document::document_ptr& document,
+                        const components::ql::storage_parameters* parameters) final;
+
+        void compile_(std::string_view pattern);
+        bool match_(std::string_view value) const;
+
+        components::expressions::compare_expression_ptr expr_;
+        const components::document::field_path_t path_;
+        bool compiled_{false};
+        std::string pattern_;
+        match_mode mode_{match_mode::regex};
+        std::string literal_;
+        std::regex regex_;
+    };
+
+    bool is_regex_literal(std::string_view pattern);
+
+} // namespace services::collection::operators::predicates
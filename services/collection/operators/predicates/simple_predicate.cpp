@@ -1,9 +1,28 @@
 #include "simple_predicate.hpp"
-#include <regex>
+#include "regex_predicate.hpp"
+#include <algorithm>
+#include <components/document/core/array.hpp>
 #include <services/collection/operators/operator.hpp>
 
 namespace services::collection::operators::predicates {
 
+    // the elements of an array field, or the field itself when it holds a scalar
+    std::vector<::document::wrapper_value_t> elements(const ::document::wrapper_value_t& value) {
+        std::vector<::document::wrapper_value_t> result;
+        if (value && value->type() == ::document::impl::value_type::array) {
+            for (auto it = value->as_array()->begin(); it; ++it) {
+                result.emplace_back(it.value());
+            }
+        } else if (value) {
+            result.push_back(value);
+        }
+        return result;
+    }
+
+    bool contains(const std::vector<::document::wrapper_value_t>& values, const ::document::wrapper_value_t& value) {
+        return std::find(values.begin(), values.end(), value) != values.end();
+    }
+
     simple_predicate::simple_predicate(context_collection_t* context,
                                        std::function<bool(const components::document::document_ptr&,
                                                           const components::ql::storage_parameters*)> func)
@@ -19,93 +38,113 @@ namespace services::collection::operators::predicates {
                                           const components::expressions::compare_expression_ptr& expr) {
         using components::expressions::compare_type;
 
+        // resolved once for the plan, every document is then read through it
+        const components::document::field_path_t path(expr->key().as_string());
         switch (expr->type()) {
             case compare_type::eq:
                 return std::make_unique<simple_predicate>(context,
-                                                          [&expr](const components::document::document_ptr& document,
+                                                          [&expr, path](const components::document::document_ptr& document,
                                                                   const components::ql::storage_parameters* parameters) {
                                                               auto it = parameters->find(expr->value());
                                                               if (it == parameters->end()) {
                                                                   return false;
                                                               } else {
-                                                                  auto value = get_value_from_document(document, expr->key());
+                                                                  auto value = get_value_from_document(document, path);
                                                                   return value && value == it->second;
                                                               }
                                                           });
             case compare_type::ne:
                 return std::make_unique<simple_predicate>(context,
-                                                          [&expr](const components::document::document_ptr& document,
+                                                          [&expr, path](const components::document::document_ptr& document,
                                                                   const components::ql::storage_parameters* parameters) {
                                                               auto it = parameters->find(expr->value());
                                                               if (it == parameters->end()) {
                                                                   return false;
                                                               } else {
-                                                                  auto value = get_value_from_document(document, expr->key());
+                                                                  auto value = get_value_from_document(document, path);
                                                                   return value && value != it->second;
                                                               }
                                                           });
             case compare_type::gt:
                 return std::make_unique<simple_predicate>(context,
-                                                          [&expr](const components::document::document_ptr& document,
+                                                          [&expr, path](const components::document::document_ptr& document,
                                                                   const components::ql::storage_parameters* parameters) {
                                                               auto it = parameters->find(expr->value());
                                                               if (it == parameters->end()) {
                                                                   return false;
                                                               } else {
-                                                                  auto value = get_value_from_document(document, expr->key());
+                                                                  auto value = get_value_from_document(document, path);
                                                                   return value && value > it->second;
                                                               }
                                                           });
             case compare_type::gte:
                 return std::make_unique<simple_predicate>(context,
-                                                          [&expr](const components::document::document_ptr& document,
+                                                          [&expr, path](const components::document::document_ptr& document,
                                                                   const components::ql::storage_parameters* parameters) {
                                                               auto it = parameters->find(expr->value());
                                                               if (it == parameters->end()) {
                                                                   return false;
                                                               } else {
-                                                                  auto value = get_value_from_document(document, expr->key());
+                                                                  auto value = get_value_from_document(document, path);
                                                                   return value && value >= it->second;
                                                               }
                                                           });
             case compare_type::lt:
                 return std::make_unique<simple_predicate>(context,
-                                                          [&expr](const components::document::document_ptr& document,
+                                                          [&expr, path](const components::document::document_ptr& document,
                                                                   const components::ql::storage_parameters* parameters) {
                                                               auto it = parameters->find(expr->value());
                                                               if (it == parameters->end()) {
                                                                   return false;
                                                               } else {
-                                                                  auto value = get_value_from_document(document, expr->key());
+                                                                  auto value = get_value_from_document(document, path);
                                                                   return value && value < it->second;
                                                               }
                                                           });
             case compare_type::lte:
                 return std::make_unique<simple_predicate>(context,
-                                                          [&expr](const components::document::document_ptr& document,
+                                                          [&expr, path](const components::document::document_ptr& document,
                                                                   const components::ql::storage_parameters* parameters) {
                                                               auto it = parameters->find(expr->value());
                                                               if (it == parameters->end()) {
                                                                   return false;
                                                               } else {
-                                                                  auto value = get_value_from_document(document, expr->key());
+                                                                  auto value = get_value_from_document(document, path);
                                                                   return value && value <= it->second;
                                                               }
                                                           });
-            case compare_type::regex:
+            case compare_type::any:
                 return std::make_unique<simple_predicate>(context,
-                                                          [&expr](const components::document::document_ptr& document,
+                                                          [&expr, path](const components::document::document_ptr& document,
                                                                   const components::ql::storage_parameters* parameters) {
                                                               auto it = parameters->find(expr->value());
                                                               if (it == parameters->end()) {
                                                                   return false;
                                                               } else {
-                                                                  auto value = get_value_from_document(document, expr->key());
-                                                                  return value && value->type() == document::impl::value_type::string &&
-                                                                         std::regex_match(value->as_string().data(),
-                                                                                          std::regex(fmt::format(".*{}.*", it->second->as_string())));
+                                                                  auto values = elements(get_value_from_document(document, path));
+                                                                  auto params = elements(it->second);
+                                                                  return std::any_of(params.begin(), params.end(), [&values](const ::document::wrapper_value_t& param) {
+                                                                      return contains(values, param);
+                                                                  });
                                                               }
                                                           });
+            case compare_type::all:
+                return std::make_unique<simple_predicate>(context,
+                                                          [&expr, path](const components::document::document_ptr& document,
+                                                                  const components::ql::storage_parameters* parameters) {
+                                                              auto it = parameters->find(expr->value());
+                                                              if (it == parameters->end()) {
+                                                                  return false;
+                                                              } else {
+                                                                  auto values = elements(get_value_from_document(document, path));
+                                                                  auto params = elements(it->second);
+                                                                  return !params.empty() && std::all_of(params.begin(), params.end(), [&values](const ::document::wrapper_value_t& param) {
+                                                                      return contains(values, param);
+                                                                  });
+                                                              }
+                                                          });
+            case compare_type::regex:
+                return std::make_unique<regex_predicate>(context, expr);
             case compare_type::all_true:
                 return std::make_unique<simple_predicate>(context, [](const components::document::document_ptr&,
                                                                       const components::ql::storage_parameters*) {
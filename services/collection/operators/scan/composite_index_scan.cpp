@@ -0,0 +1,103 @@
+#include "composite_index_scan.hpp"
+#include <components/index/disk/route.hpp>
+#include <services/collection/collection.hpp>
+#include <services/collection/operators/scan/index_scan.hpp>
+
+namespace services::collection::operators {
+
+    using components::expressions::compare_type;
+    using components::index::composite_value_t;
+
+    composite_value_t make_composite_key(const std::vector<components::expressions::compare_expression_ptr>& exprs,
+                               const components::ql::storage_parameters* parameters,
+                               std::pmr::memory_resource* resource) {
+        composite_value_t values(resource);
+        values.reserve(exprs.size());
+        for (const auto& expr : exprs) {
+            values.emplace_back(components::ql::get_parameter(parameters, expr->value()));
+        }
+        return values;
+    }
+
+    void search_by_composite_index(components::index::index_t* index,
+                                   const std::vector<components::expressions::compare_expression_ptr>& exprs,
+                                   const components::ql::limit_t& limit,
+                                   const components::ql::storage_parameters* parameters,
+                                   operator_data_ptr& result) {
+        auto key = make_composite_key(exprs, parameters, index->resource());
+        auto type = exprs.back()->type();
+        if (type != compare_type::eq) {
+            key.pop_back();
+        }
+        auto range = key.empty()
+                         ? std::make_pair(index->cbegin(), index->cend())
+                         : index->find(key);
+        if (type != compare_type::eq) {
+            key.emplace_back(components::ql::get_parameter(parameters, exprs.back()->value()));
+            switch (type) {
+                case compare_type::gt:
+                    range.first = index->upper_bound(key).first;
+                    break;
+                case compare_type::gte:
+                    range.first = index->lower_bound(key).second;
+                    break;
+                case compare_type::lt:
+                    range.second = index->lower_bound(key).second;
+                    break;
+                case compare_type::lte:
+                    range.second = index->upper_bound(key).first;
+                    break;
+                default:
+                    break;
+            }
+        }
+        int count = 0;
+        for (auto it = range.first; it != range.second; ++it) {
+            if (!limit.check(count)) {
+                return;
+            }
+            result->append(it->doc);
+            ++count;
+        }
+    }
+
+    composite_index_scan::composite_index_scan(context_collection_t* context,
+                                               components::ql::keys_base_storage_t keys,
+                                               std::vector<components::expressions::compare_expression_ptr> exprs,
+                                               components::ql::limit_t limit)
+        : read_only_operator_t(context, operator_type::match)
+        , keys_(std::move(keys))
+        , exprs_(std::move(exprs))
+        , limit_(limit) {
+        assert(!exprs_.empty());
+    }
+
+    void composite_index_scan::on_execute_impl(components::pipeline::context_t* pipeline_context) {
+        trace(context_->log(), "composite_index_scan by {} fields", exprs_.size());
+        if (!limit_.check(0)) {
+            return; //limit = 0
+        }
+        output_ = make_operator_data(context_->resource());
+        auto* index = components::index::search_index(context_->index_engine(), keys_);
+        if (index && index->is_disk()) {
+            trace(context_->log(), "composite_index_scan: send query into disk");
+            // the equalities are the prefix of the disk scan, the last predicate bounds it within that prefix
+            auto key = make_composite_key(exprs_, &pipeline_context->parameters, context_->resource());
+            pipeline_context->send(index->disk_agent(), index::handler_id(index::route::find), key, exprs_.back()->type(),
+                                   disk_limit(limit_, components::expressions::sort_order::asc));
+            async_wait();
+        } else if (index) {
+            trace(context_->log(), "composite_index_scan: prepare result");
+            search_by_composite_index(index, exprs_, limit_, &pipeline_context->parameters, output_);
+        }
+    }
+
+    void composite_index_scan::on_receive_ids_impl(const std::pmr::vector<components::document::document_id_t>& ids) {
+        append_by_ids(context_, ids, limit_, output_);
+    }
+
+    void composite_index_scan::on_resume_impl(components::pipeline::context_t*) {
+        trace(context_->log(), "resume composite_index_scan by {} fields", exprs_.size());
+    }
+
+} // namespace services::collection::operators
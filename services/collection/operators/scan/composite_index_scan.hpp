@@ -0,0 +1,30 @@
+#pragma once
+
+#include <components/expressions/compare_expression.hpp>
+#include <components/ql/aggregate/limit.hpp>
+#include <components/ql/index.hpp>
+#include <services/collection/operators/operator.hpp>
+
+namespace services::collection::operators {
+
+    // scan of a compound index by equality predicates on its leading keys,
+    // optionally followed by one range predicate on the next key;
+    // predicates are given in the order of the index keys
+    class composite_index_scan final : public read_only_operator_t {
+    public:
+        composite_index_scan(context_collection_t* collection,
+                             components::ql::keys_base_storage_t keys,
+                             std::vector<components::expressions::compare_expression_ptr> exprs,
+                             components::ql::limit_t limit);
+
+    private:
+        void on_execute_impl(components::pipeline::context_t* pipeline_context) final;
+        void on_resume_impl(components::pipeline::context_t* pipeline_context) final;
+        void on_receive_ids_impl(const std::pmr::vector<components::document::document_id_t>& ids) final;
+
+        const components::ql::keys_base_storage_t keys_;
+        const std::vector<components::expressions::compare_expression_ptr> exprs_;
+        const components::ql::limit_t limit_;
+    };
+
+} // namespace services::operators
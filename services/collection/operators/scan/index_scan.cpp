@@ -1,4 +1,8 @@
 #include "index_scan.hpp"
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <components/document/core/array.hpp>
 #include <components/index/disk/route.hpp>
 #include <services/collection/collection.hpp>
 
@@ -31,13 +35,79 @@ namespace services::collection::operators {
         }
     }
 
+    // $any and $all take an array of values: the documents stored under any or under all of its
+    // distinct values, each document once; a multikey index stores a document once per value
+    void search_elements_by_index(components::index::index_t* index,
+                                  const components::expressions::compare_expression_ptr& expr,
+                                  const components::ql::limit_t& limit,
+                                  const components::ql::storage_parameters* parameters,
+                                  operator_data_ptr& result) {
+        using components::expressions::compare_type;
+        const auto& parameter = components::ql::get_parameter(parameters, expr->value());
+        std::vector<components::index::value_t> values;
+        if (parameter && parameter->type() == ::document::impl::value_type::array) {
+            for (auto it = parameter->as_array()->begin(); it; ++it) {
+                values.emplace_back(it.value());
+            }
+        } else if (parameter) {
+            values.push_back(parameter);
+        }
+        std::sort(values.begin(), values.end());
+        values.erase(std::unique(values.begin(), values.end()), values.end());
+        std::map<components::document::document_id_t, std::pair<components::document::document_ptr, std::size_t>> found;
+        std::vector<components::document::document_id_t> ids;
+        for (const auto& value : values) {
+            auto range = index->find(value);
+            for (auto it = range.first; it != range.second; ++it) {
+                auto& [doc, matches] = found[it->id];
+                if (matches++ == 0) {
+                    doc = it->doc;
+                    ids.push_back(it->id);
+                }
+            }
+        }
+        int count = 0;
+        for (const auto& id : ids) {
+            const auto& [doc, matches] = found[id];
+            if (expr->type() == compare_type::all && matches != values.size()) {
+                continue;
+            }
+            if (!limit.check(count)) {
+                return;
+            }
+            result->append(doc);
+            ++count;
+        }
+    }
+
+    // the ranges of search_range_by_index are ascending and follow one another,
+    // so walking them backwards yields the documents in descending key order
     void search_by_index(components::index::index_t* index,
                          const components::expressions::compare_expression_ptr& expr,
                          const components::ql::limit_t& limit,
+                         components::expressions::sort_order order,
                          const components::ql::storage_parameters* parameters,
                          operator_data_ptr& result) {
+        using components::expressions::compare_type;
+        if (expr->type() == compare_type::any || expr->type() == compare_type::all) {
+            search_elements_by_index(index, expr, limit, parameters, result);
+            return;
+        }
         auto ranges = search_range_by_index(index, expr, parameters);
         int count = 0;
+        if (order == components::expressions::sort_order::desc) {
+            for (auto range = ranges.rbegin(); range != ranges.rend(); ++range) {
+                for (auto it = range->second; it != range->first;) {
+                    --it;
+                    if (!limit.check(count)) {
+                        return;
+                    }
+                    result->append(it->doc);
+                    ++count;
+                }
+            }
+            return;
+        }
         for (const auto& range : ranges) {
             for (auto it = range.first; it != range.second; ++it) {
                 if (!limit.check(count)) {
@@ -49,42 +119,78 @@ namespace services::collection::operators {
         }
     }
 
-    index_scan::index_scan(context_collection_t* context, components::expressions::compare_expression_ptr expr, components::ql::limit_t limit)
+    // the disk reads only as many ids as the limit needs, but a descending scan
+    // takes its documents from the end of the range, so there it reads all of them
+    std::size_t disk_limit(const components::ql::limit_t& limit, components::expressions::sort_order order) {
+        if (limit.limit() < 0 || order == components::expressions::sort_order::desc) {
+            return std::numeric_limits<std::size_t>::max();
+        }
+        return static_cast<std::size_t>(limit.limit());
+    }
+
+    // the documents of the ids a disk index streamed, as many as the limit allows
+    void append_by_ids(context_collection_t* context,
+                       const std::pmr::vector<components::document::document_id_t>& ids,
+                       const components::ql::limit_t& limit,
+                       operator_data_ptr& result) {
+        auto& storage = context->storage();
+        for (const auto& id : ids) {
+            if (!limit.check(static_cast<int>(result->size()))) {
+                return;
+            }
+            auto it = storage.find(id);
+            if (it != storage.end()) {
+                result->append(it->second);
+            }
+        }
+    }
+
+    index_scan::index_scan(context_collection_t* context,
+                           components::expressions::compare_expression_ptr expr,
+                           components::ql::limit_t limit,
+                           components::expressions::sort_order order)
         : read_only_operator_t(context, operator_type::match)
         , expr_(std::move(expr))
-        , limit_(limit) {
+        , limit_(limit)
+        , order_(order) {
     }
 
     void index_scan::on_execute_impl(components::pipeline::context_t* pipeline_context) {
         trace(context_->log(), "index_scan by field \"{}\"", expr_->key().as_string());
+        if (!limit_.check(0)) {
+            return; //limit = 0
+        }
+        output_ = make_operator_data(context_->resource());
         auto* index = components::index::search_index(context_->index_engine(), {expr_->key()});
         if (index && index->is_disk()) {
             trace(context_->log(), "index_scan: send query into disk");
-            auto value = components::ql::get_parameter(&pipeline_context->parameters, expr_->value());
-            pipeline_context->send(index->disk_agent(), index::handler_id(index::route::find), value, expr_->type());
+            components::index::composite_value_t values(context_->resource());
+            values.emplace_back(components::ql::get_parameter(&pipeline_context->parameters, expr_->value()));
+            pipeline_context->send(index->disk_agent(), index::handler_id(index::route::find), values, expr_->type(), disk_limit(limit_, order_));
             async_wait();
-        } else {
+        } else if (index) {
             trace(context_->log(), "index_scan: prepare result");
-            if (!limit_.check(0)) {
-                return; //limit = 0
-            }
-            output_ = make_operator_data(context_->resource());
-            if (index) {
-                search_by_index(index, expr_, limit_, &pipeline_context->parameters, output_);
-            }
+            search_by_index(index, expr_, limit_, order_, &pipeline_context->parameters, output_);
         }
     }
 
-    void index_scan::on_resume_impl(components::pipeline::context_t* pipeline_context) {
-        trace(context_->log(), "resume index_scan by field \"{}\"", expr_->key().as_string());
-        auto* index = components::index::search_index(context_->index_engine(), {expr_->key()});
-        trace(context_->log(), "index_scan: prepare result");
-        if (!limit_.check(0)) {
-            return; //limit = 0
+    void index_scan::on_receive_ids_impl(const std::pmr::vector<components::document::document_id_t>& ids) {
+        if (order_ == components::expressions::sort_order::desc) {
+            append_by_ids(context_, ids, components::ql::limit_t::unlimit(), output_);
+        } else {
+            append_by_ids(context_, ids, limit_, output_);
         }
-        output_ = make_operator_data(context_->resource());
-        if (index) {
-            search_by_index(index, expr_, limit_, &pipeline_context->parameters, output_);
+    }
+
+    // the disk streams the ids in ascending key order, a descending scan takes them from the end
+    void index_scan::on_resume_impl(components::pipeline::context_t*) {
+        trace(context_->log(), "resume index_scan by field \"{}\"", expr_->key().as_string());
+        if (order_ == components::expressions::sort_order::desc) {
+            auto& documents = output_->documents();
+            std::reverse(documents.begin(), documents.end());
+            if (limit_.limit() >= 0 && documents.size() > static_cast<std::size_t>(limit_.limit())) {
+                documents.resize(static_cast<std::size_t>(limit_.limit()));
+            }
         }
     }
 
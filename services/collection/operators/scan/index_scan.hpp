@@ -1,20 +1,32 @@
 #pragma once
 
+#include <components/expressions/compare_expression.hpp>
 #include <components/ql/aggregate/limit.hpp>
 #include <services/collection/operators/operator.hpp>
 
 namespace services::collection::operators {
 
+    std::size_t disk_limit(const components::ql::limit_t& limit, components::expressions::sort_order order);
+    void append_by_ids(context_collection_t* context,
+                       const std::pmr::vector<components::document::document_id_t>& ids,
+                       const components::ql::limit_t& limit,
+                       operator_data_ptr& result);
+
     class index_scan final : public read_only_operator_t {
     public:
-        index_scan(context_collection_t* collection, components::expressions::compare_expression_ptr expr, components::ql::limit_t limit);
+        index_scan(context_collection_t* collection,
+                   components::expressions::compare_expression_ptr expr,
+                   components::ql::limit_t limit,
+                   components::expressions::sort_order order = components::expressions::sort_order::asc);
 
     private:
         void on_execute_impl(components::pipeline::context_t* pipeline_context) final;
         void on_resume_impl(components::pipeline::context_t* pipeline_context) final;
+        void on_receive_ids_impl(const std::pmr::vector<components::document::document_id_t>& ids) final;
 
         const components::expressions::compare_expression_ptr expr_;
         const components::ql::limit_t limit_;
+        const components::expressions::sort_order order_;
     };
 
 } // namespace services::operators
@@ -6,19 +6,48 @@ namespace services::collection::operators {
 
     primary_key_scan::primary_key_scan(context_collection_t* context)
         : read_only_operator_t(context, operator_type::match)
-        , ids_(context->resource()) {
+        , ids_(context->resource())
+        , limit_(components::ql::limit_t::unlimit()) {
+    }
+
+    primary_key_scan::primary_key_scan(context_collection_t* context,
+                                       std::vector<components::expressions::compare_expression_ptr> exprs,
+                                       components::ql::limit_t limit)
+        : read_only_operator_t(context, operator_type::match)
+        , ids_(context->resource())
+        , exprs_(std::move(exprs))
+        , limit_(limit) {
     }
 
     void primary_key_scan::append(document_id_t id) {
         ids_.push_back(id);
     }
 
-    void primary_key_scan::on_execute_impl(components::pipeline::context_t*) {
+    void primary_key_scan::on_execute_impl(components::pipeline::context_t* pipeline_context) {
         output_ = make_operator_data(context_->resource());
-        for (const auto &id : ids_) {
+        std::pmr::vector<document_id_t> ids(ids_, context_->resource());
+        if (pipeline_context) {
+            for (const auto& expr : exprs_) {
+                const auto& value = components::ql::get_parameter(&pipeline_context->parameters, expr->value());
+                if (value && value->type() == ::document::impl::value_type::string && document_id_t::is_valid(value->as_string())) {
+                    ids.emplace_back(value->as_string());
+                }
+            }
+        }
+        if (!exprs_.empty()) {
+            // the ids are looked up in storage order and each document is returned once, as a full scan would do
+            std::sort(ids.begin(), ids.end());
+            ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+        }
+        int count = 0;
+        for (const auto &id : ids) {
+            if (!limit_.check(count)) {
+                return;
+            }
             auto it = context_->storage().find(id);
             if (it != context_->storage().end()) {
                 output_->append(it->second);
+                ++count;
             }
         }
     }
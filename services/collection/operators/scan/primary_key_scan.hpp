@@ -1,6 +1,8 @@
 #pragma once
 
 #include <components/document/document_id.hpp>
+#include <components/expressions/compare_expression.hpp>
+#include <components/ql/aggregate/limit.hpp>
 #include <services/collection/operators/operator.hpp>
 
 namespace services::collection::operators {
@@ -9,12 +11,19 @@ namespace services::collection::operators {
     public:
         explicit primary_key_scan(context_collection_t* context);
 
+        // lookups by the ids bound to the parameters of eq predicates on _id
+        primary_key_scan(context_collection_t* context,
+                         std::vector<components::expressions::compare_expression_ptr> exprs,
+                         components::ql::limit_t limit);
+
         void append(components::document::document_id_t id);
 
     private:
         std::pmr::vector<components::document::document_id_t> ids_;
+        const std::vector<components::expressions::compare_expression_ptr> exprs_;
+        const components::ql::limit_t limit_;
 
         void on_execute_impl(components::pipeline::context_t* pipeline_context) final;
     };
 
-} // namespace services::operators
\ No newline at end of file
+} // namespace services::operators
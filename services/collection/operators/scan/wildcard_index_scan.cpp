@@ -0,0 +1,88 @@
+#include "wildcard_index_scan.hpp"
+#include <components/index/disk/route.hpp>
+#include <services/collection/collection.hpp>
+#include <services/collection/operators/scan/index_scan.hpp>
+
+namespace services::collection::operators {
+
+    using components::expressions::compare_type;
+    using components::index::composite_value_t;
+    using range = components::index::index_t::range;
+
+    // the entries of the path bound every range, the key (path, value) splits them
+    std::vector<range> search_range_by_wildcard_index(components::index::index_t* index,
+                                                      const composite_value_t& key,
+                                                      compare_type type) {
+        auto path = index->find(composite_value_t(key.begin(), key.end() - 1, key.get_allocator()));
+        switch (type) {
+            case compare_type::eq:
+                return {index->find(key)};
+            case compare_type::ne:
+                return {{path.first, index->lower_bound(key).second}, {index->upper_bound(key).first, path.second}};
+            case compare_type::gt:
+                return {{index->upper_bound(key).first, path.second}};
+            case compare_type::gte:
+                return {{index->lower_bound(key).second, path.second}};
+            case compare_type::lt:
+                return {{path.first, index->lower_bound(key).second}};
+            case compare_type::lte:
+                return {{path.first, index->upper_bound(key).first}};
+            default:
+                return {};
+        }
+    }
+
+    wildcard_index_scan::wildcard_index_scan(context_collection_t* context,
+                                             components::ql::keys_base_storage_t keys,
+                                             components::expressions::compare_expression_ptr expr,
+                                             components::ql::limit_t limit)
+        : read_only_operator_t(context, operator_type::match)
+        , keys_(std::move(keys))
+        , expr_(std::move(expr))
+        , limit_(limit)
+        , path_(::document::impl::new_value(std::string_view(expr_->key().as_string()))) {
+    }
+
+    void wildcard_index_scan::on_execute_impl(components::pipeline::context_t* pipeline_context) {
+        trace(context_->log(), "wildcard_index_scan by field \"{}\"", expr_->key().as_string());
+        if (!limit_.check(0)) {
+            return; //limit = 0
+        }
+        output_ = make_operator_data(context_->resource());
+        auto* index = components::index::search_index(context_->index_engine(), keys_);
+        if (!index) {
+            return;
+        }
+        composite_value_t key(context_->resource());
+        key.emplace_back(path_.get());
+        key.emplace_back(components::ql::get_parameter(&pipeline_context->parameters, expr_->value()));
+        if (index->is_disk()) {
+            trace(context_->log(), "wildcard_index_scan: send query into disk");
+            // the path is the equality prefix of the disk scan
+            pipeline_context->send(index->disk_agent(), index::handler_id(index::route::find), key, expr_->type(),
+                                   disk_limit(limit_, components::expressions::sort_order::asc));
+            async_wait();
+            return;
+        }
+        trace(context_->log(), "wildcard_index_scan: prepare result");
+        int count = 0;
+        for (const auto& range : search_range_by_wildcard_index(index, key, expr_->type())) {
+            for (auto it = range.first; it != range.second; ++it) {
+                if (!limit_.check(count)) {
+                    return;
+                }
+                output_->append(it->doc);
+                ++count;
+            }
+        }
+    }
+
+    void wildcard_index_scan::on_receive_ids_impl(const std::pmr::vector<components::document::document_id_t>& ids) {
+        append_by_ids(context_, ids, limit_, output_);
+    }
+
+    void wildcard_index_scan::on_resume_impl(components::pipeline::context_t*) {
+        trace(context_->log(), "resume wildcard_index_scan by field \"{}\"", expr_->key().as_string());
+    }
+
+} // namespace services::collection::operators
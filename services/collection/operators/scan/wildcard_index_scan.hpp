@@ -0,0 +1,29 @@
+#pragma once
+
+#include <components/expressions/compare_expression.hpp>
+#include <components/ql/aggregate/limit.hpp>
+#include <components/ql/index.hpp>
+#include <services/collection/operators/operator.hpp>
+
+namespace services::collection::operators {
+
+    // scan of the entries of one path of a wildcard index by an equality, inequality or range predicate
+    class wildcard_index_scan final : public read_only_operator_t {
+    public:
+        wildcard_index_scan(context_collection_t* collection,
+                            components::ql::keys_base_storage_t keys,
+                            components::expressions::compare_expression_ptr expr,
+                            components::ql::limit_t limit);
+
+    private:
+        void on_execute_impl(components::pipeline::context_t* pipeline_context) final;
+        void on_resume_impl(components::pipeline::context_t* pipeline_context) final;
+        void on_receive_ids_impl(const std::pmr::vector<components::document::document_id_t>& ids) final;
+
+        const components::ql::keys_base_storage_t keys_;
+        const components::expressions::compare_expression_ptr expr_;
+        const components::ql::limit_t limit_;
+        const ::document::retained_const_t<::document::impl::value_t> path_;
+    };
+
+} // namespace services::operators
@@ -4,6 +4,7 @@
 #include "impl/create_plan_delete.hpp"
 #include "impl/create_plan_insert.hpp"
 #include "impl/create_plan_match.hpp"
+#include "impl/create_plan_sort.hpp"
 #include "impl/create_plan_update.hpp"
 
 namespace services::collection::planner {
@@ -13,22 +14,23 @@ namespace services::collection::planner {
     operators::operator_ptr create_plan(
             context_collection_t* context,
             const components::logical_plan::node_ptr& node,
-            components::ql::limit_t limit) {
+            components::ql::limit_t limit,
+            const components::ql::storage_parameters* parameters) {
         switch (node->type()) {
             case node_type::aggregate_t:
-                return impl::create_plan_aggregate(context, node, std::move(limit));
+                return impl::create_plan_aggregate(context, node, std::move(limit), parameters);
             case node_type::delete_t:
-                return impl::create_plan_delete(context, node);
+                return impl::create_plan_delete(context, node, parameters);
             case node_type::insert_t:
                 return impl::create_plan_insert(context, node);
             case node_type::match_t:
-                return impl::create_plan_match(context, node, std::move(limit));
+                return impl::create_plan_match(context, node, std::move(limit), parameters);
             case node_type::group_t:
                 break;
             case node_type::sort_t:
-                break;
+                return impl::create_plan_sort(context, node, std::move(limit));
             case node_type::update_t:
-                return impl::create_plan_update(context, node);
+                return impl::create_plan_update(context, node, parameters);
             default:
                 break;
         }
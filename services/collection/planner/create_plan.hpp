@@ -8,6 +8,7 @@ namespace services::collection::planner {
 
     operators::operator_ptr create_plan(context_collection_t* context,
             const components::logical_plan::node_ptr& node,
-            components::ql::limit_t limit);
+            components::ql::limit_t limit,
+            const components::ql::storage_parameters* parameters = nullptr);
 
 }
@@ -1,31 +1,86 @@
 #include "create_plan_match.hpp"
+#include <components/logical_plan/node_limit.hpp>
 #include <services/collection/operators/aggregation.hpp>
+#include <services/collection/operators/scan/transfer_scan.hpp>
 #include <services/collection/planner/create_plan.hpp>
 
 namespace services::collection::planner::impl {
 
     using components::logical_plan::node_type;
 
+    components::ql::limit_t min_limit(const components::ql::limit_t& limit1, const components::ql::limit_t& limit2) {
+        if (limit1.limit() < 0) {
+            return limit2;
+        }
+        if (limit2.limit() < 0) {
+            return limit1;
+        }
+        return limit1.limit() < limit2.limit() ? limit1 : limit2;
+    }
+
     operators::operator_ptr create_plan_aggregate(
             context_collection_t* context,
             const components::logical_plan::node_ptr& node,
-            components::ql::limit_t limit) {
-        auto op = std::make_unique<operators::aggregation>(context);
+            components::ql::limit_t limit,
+            const components::ql::storage_parameters* parameters) {
+        // aggregation always runs match -> group -> sort; a $limit applies to the output of the stage it follows,
+        // so only one right after the $sort turns it into a top-k, and the caller's limit goes to the last stage
+        components::logical_plan::node_ptr match = nullptr;
+        components::logical_plan::node_ptr group = nullptr;
+        components::logical_plan::node_ptr sort = nullptr;
+        auto match_limit = components::ql::limit_t::unlimit();
+        auto group_limit = components::ql::limit_t::unlimit();
+        auto sort_limit = components::ql::limit_t::unlimit();
+        components::ql::limit_t* stage_limit = &match_limit;
         for (const components::logical_plan::node_ptr& child : node->children()) {
             switch (child->type()) {
             case node_type::match_t:
-                op->set_match(create_plan(context, child, limit));
+                match = child;
                 break;
             case node_type::group_t:
-                op->set_group(create_plan(context, child, limit));
+                group = child;
+                stage_limit = &group_limit;
                 break;
             case node_type::sort_t:
-                op->set_sort(create_plan(context, child, limit));
+                sort = child;
+                stage_limit = &sort_limit;
+                break;
+            case node_type::limit_t:
+                *stage_limit = min_limit(*stage_limit, static_cast<const components::logical_plan::node_limit_t*>(child.get())->limit());
                 break;
             default:
                 break;
             }
         }
+        if (sort) {
+            sort_limit = min_limit(sort_limit, limit);
+        } else if (group) {
+            group_limit = min_limit(group_limit, limit);
+        } else {
+            match_limit = min_limit(match_limit, limit);
+        }
+        auto op = std::make_unique<operators::aggregation>(context);
+        if (match && sort && !group && match_limit.limit() < 0) {
+            // an index on the sort key already yields the matched documents in order
+            auto ordered_match = create_plan_match_in_index_order(context, match, sort, sort_limit, parameters);
+            if (ordered_match) {
+                op->set_match(std::move(ordered_match));
+                return std::move(op);
+            }
+        }
+        operators::operator_ptr sort_plan = sort ? create_plan(context, sort, sort_limit) : nullptr;
+        operators::operator_ptr group_plan = group ? create_plan(context, group, group_limit) : nullptr;
+        if (!group_plan) {
+            // without a group the matched documents are its output
+            match_limit = min_limit(match_limit, group_limit);
+        }
+        if (match) {
+            op->set_match(create_plan(context, match, match_limit, parameters));
+        } else if (match_limit.limit() >= 0 || (!sort_plan && !group_plan)) {
+            op->set_match(std::make_unique<operators::transfer_scan>(context, match_limit));
+        }
+        op->set_group(std::move(group_plan));
+        op->set_sort(std::move(sort_plan));
         return std::move(op);
     }
 
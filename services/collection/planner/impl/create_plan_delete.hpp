@@ -7,6 +7,7 @@ namespace services::collection::planner::impl {
 
     operators::operator_ptr create_plan_delete(
             context_collection_t* context,
-            const components::logical_plan::node_ptr& node);
+            const components::logical_plan::node_ptr& node,
+            const components::ql::storage_parameters* parameters);
 
 }
@@ -1,9 +1,13 @@
 #include "create_plan_match.hpp"
 #include <components/expressions/compare_expression.hpp>
+#include <components/expressions/sort_expression.hpp>
+#include <components/index/wildcard_index.hpp>
+#include <services/collection/operators/scan/composite_index_scan.hpp>
 #include <services/collection/operators/scan/full_scan.hpp>
 #include <services/collection/operators/scan/index_scan.hpp>
 #include <services/collection/operators/scan/primary_key_scan.hpp>
 #include <services/collection/operators/scan/transfer_scan.hpp>
+#include <services/collection/operators/scan/wildcard_index_scan.hpp>
 #include <services/collection/operators/merge/operator_merge.hpp>
 
 namespace services::collection::planner::impl {
@@ -18,32 +22,288 @@ namespace services::collection::planner::impl {
                compare == compare_type::lte;
     }
 
+    // a multikey index holds the elements of arrays rather than whole arrays, so it answers only
+    // the predicates on elements: the documents containing any or all of an array of values.
+    // eq compares whole values, as every other index does, and is left to a full scan
+    bool is_can_index_find_by_predicate(const components::index::index_t* index,
+                                        const components::expressions::compare_expression_ptr& expr) {
+        using components::expressions::compare_type;
+        if (index->type() == components::ql::index_type::hashed) {
+            return expr->type() == compare_type::eq || expr->type() == compare_type::ne;
+        }
+        if (index->type() == components::ql::index_type::multikey) {
+            return expr->type() == compare_type::any || expr->type() == compare_type::all;
+        }
+        return is_can_index_find_by_predicate(expr->type());
+    }
+
     bool is_can_primary_key_find_by_predicate(components::expressions::compare_type compare) {
         using components::expressions::compare_type;
         return compare == compare_type::eq;
     }
 
+    // eq predicates on _id, either alone or as the branches of an $or (the $in form of a list of ids)
+    std::vector<components::expressions::compare_expression_ptr> primary_key_predicates(
+        const components::expressions::compare_expression_ptr& expr) {
+        auto is_primary_key = [](const components::expressions::compare_expression_ptr& expr) {
+            return !expr->is_union() && is_can_primary_key_find_by_predicate(expr->type()) && expr->key().as_string() == "_id";
+        };
+        if (is_primary_key(expr)) {
+            return {expr};
+        }
+        if (expr->type() == components::expressions::compare_type::union_or && !expr->children().empty() &&
+            std::all_of(expr->children().begin(), expr->children().end(), is_primary_key)) {
+            return std::vector<components::expressions::compare_expression_ptr>(expr->children().begin(), expr->children().end());
+        }
+        return {};
+    }
+
+    using predicates_t = std::vector<components::expressions::compare_expression_ptr>;
+
+    const components::ql::expr_value_t* find_parameter(const components::ql::storage_parameters* parameters, core::parameter_id_t id) {
+        auto it = parameters->find(id);
+        return it == parameters->end() ? nullptr : &it->second;
+    }
+
+    // whether a stored null satisfies a simple predicate: only then may the match need a null a sparse index left out
+    bool is_matching_null(components::expressions::compare_type compare, const components::ql::expr_value_t& value) {
+        using components::expressions::compare_type;
+        const components::ql::expr_value_t null{::document::impl::value_t::null_value};
+        switch (compare) {
+            case compare_type::eq:
+                return null == value;
+            case compare_type::gt:
+                return null > value;
+            case compare_type::gte:
+                return null >= value;
+            case compare_type::lt:
+                return null < value;
+            case compare_type::lte:
+                return null <= value;
+            default:
+                return true;
+        }
+    }
+
+    // every document matching the query predicate also matches the filter predicate on the same key
+    bool is_implied(const components::expressions::compare_expression_ptr& query, const components::ql::expr_value_t& query_value,
+                    const components::expressions::compare_expression_ptr& filter, const components::ql::expr_value_t& filter_value) {
+        using components::expressions::compare_type;
+        if (query->is_union() || !(query->key() == filter->key())) {
+            return false;
+        }
+        if (query->type() == filter->type() && query_value == filter_value) {
+            return true;
+        }
+        auto type = query->type();
+        switch (filter->type()) {
+            case compare_type::ne:
+                return type == compare_type::eq && query_value != filter_value;
+            case compare_type::gt:
+                return ((type == compare_type::eq || type == compare_type::gte) && query_value > filter_value) ||
+                       (type == compare_type::gt && query_value >= filter_value);
+            case compare_type::gte:
+                return (type == compare_type::eq || type == compare_type::gt || type == compare_type::gte) && query_value >= filter_value;
+            case compare_type::lt:
+                return ((type == compare_type::eq || type == compare_type::lte) && query_value < filter_value) ||
+                       (type == compare_type::lt && query_value <= filter_value);
+            case compare_type::lte:
+                return (type == compare_type::eq || type == compare_type::lt || type == compare_type::lte) && query_value <= filter_value;
+            default:
+                return false;
+        }
+    }
+
+    // a sparse or partial index holds a part of the documents, so it may answer a predicate only when
+    // the conjuncts of the match guarantee every matching document has an entry in it
+    bool is_index_complete(components::index::index_t* index,
+                           const predicates_t& conjuncts,
+                           const components::ql::storage_parameters* parameters) {
+        using components::expressions::compare_type;
+        if (!index->is_sparse() && !index->is_partial()) {
+            return true;
+        }
+        if (!parameters) {
+            return false;
+        }
+        if (index->is_sparse()) {
+            auto keys = index->keys();
+            for (auto key = keys.first; key != keys.second; ++key) {
+                auto is_not_null = std::any_of(conjuncts.begin(), conjuncts.end(), [&](const components::expressions::compare_expression_ptr& conjunct) {
+                    if (conjunct->is_union() || !(conjunct->key() == *key)) {
+                        return false;
+                    }
+                    const auto* value = find_parameter(parameters, conjunct->value());
+                    return value && !is_matching_null(conjunct->type(), *value);
+                });
+                if (!is_not_null) {
+                    return false;
+                }
+            }
+        }
+        if (index->is_partial()) {
+            const auto& filter = index->partial_filter();
+            predicates_t filters;
+            if (filter->type() == compare_type::union_and) {
+                filters.assign(filter->children().begin(), filter->children().end());
+            } else if (!filter->is_union()) {
+                filters.push_back(filter);
+            } else {
+                return false;
+            }
+            for (const auto& predicate : filters) {
+                const auto* filter_value = find_parameter(&index->partial_parameters(), predicate->value());
+                auto is_filter_implied = filter_value && std::any_of(conjuncts.begin(), conjuncts.end(), [&](const components::expressions::compare_expression_ptr& conjunct) {
+                    const auto* value = find_parameter(parameters, conjunct->value());
+                    return value && is_implied(conjunct, *value, predicate, *filter_value);
+                });
+                if (!is_filter_implied) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    bool is_range_predicate(components::expressions::compare_type compare) {
+        using components::expressions::compare_type;
+        return compare == compare_type::gt ||
+               compare == compare_type::lt ||
+               compare == compare_type::gte ||
+               compare == compare_type::lte;
+    }
+
+    // $and covered by a prefix of a compound index: equalities on its leading keys
+    // and at most one range on the key that follows them, or nullptr
+    operators::operator_ptr create_plan_match_by_composite_index(
+        context_collection_t* context,
+        const components::expressions::compare_expression_ptr& expr,
+        components::ql::limit_t limit,
+        const components::ql::storage_parameters* parameters) {
+        using components::expressions::compare_type;
+        const auto& children = expr->children();
+        if (children.size() < 2) {
+            return nullptr;
+        }
+        for (const auto& child : children) {
+            if (child->is_union() || !(child->type() == compare_type::eq || is_range_predicate(child->type()))) {
+                return nullptr;
+            }
+        }
+        for (const auto& leading : children) {
+            if (leading->type() != compare_type::eq) {
+                continue;
+            }
+            for (auto* index : components::index::search_indexes_by_prefix(context->index_engine(), leading->key())) {
+                if (index->type() != components::ql::index_type::composite ||
+                    !is_index_complete(index, predicates_t(children.begin(), children.end()), parameters)) {
+                    continue;
+                }
+                std::vector<components::expressions::compare_expression_ptr> exprs;
+                auto keys = index->keys();
+                for (auto key = keys.first; key != keys.second; ++key) {
+                    auto child = std::find_if(children.begin(), children.end(), [&key](const components::expressions::compare_expression_ptr& child) {
+                        return child->key() == *key;
+                    });
+                    if (child == children.end()) {
+                        break;
+                    }
+                    exprs.push_back(*child);
+                    if ((*child)->type() != compare_type::eq) {
+                        break;
+                    }
+                }
+                if (exprs.size() == children.size()) {
+                    return std::make_unique<operators::composite_index_scan>(
+                        context,
+                        components::ql::keys_base_storage_t(keys.first, keys.second, context->resource()),
+                        std::move(exprs),
+                        limit);
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    // a wildcard index answers a predicate on a scalar on any path it indexes unless some document held
+    // an array at or above the path: it stores the elements of an array where a predicate compares the whole value
+    operators::operator_ptr create_plan_match_by_wildcard_index(
+        context_collection_t* context,
+        const components::expressions::compare_expression_ptr& expr,
+        components::ql::limit_t limit,
+        const components::ql::storage_parameters* parameters,
+        const predicates_t& conjuncts) {
+        using components::expressions::compare_type;
+        using ::document::impl::value_type;
+        if (!parameters || !(expr->type() == compare_type::eq || expr->type() == compare_type::ne || is_range_predicate(expr->type()))) {
+            return nullptr;
+        }
+        const auto* value = find_parameter(parameters, expr->value());
+        if (!value || !*value || (*value)->type() == value_type::array || (*value)->type() == value_type::dict) {
+            return nullptr;
+        }
+        const auto& path = expr->key().as_string();
+        for (auto* index : components::index::search_indexes_by_prefix(context->index_engine(), components::index::key_t(components::index::wildcard_index_t::key))) {
+            if (index->type() != components::ql::index_type::wildcard) {
+                continue;
+            }
+            const auto* wildcard = static_cast<const components::index::wildcard_index_t*>(index);
+            if (wildcard->is_indexed_path(path) && !wildcard->is_under_array(path) &&
+                wildcard->is_scalar_path(path) && is_index_complete(index, conjuncts, parameters)) {
+                auto keys = index->keys();
+                return std::make_unique<operators::wildcard_index_scan>(
+                    context,
+                    components::ql::keys_base_storage_t(keys.first, keys.second, context->resource()),
+                    expr,
+                    limit);
+            }
+        }
+        return nullptr;
+    }
+
+    // conjuncts are the predicates the match is and-ed with, they may let a sparse or partial index answer expr
     operators::operator_ptr create_plan_match_(
         context_collection_t* context,
         const components::expressions::compare_expression_ptr& expr,
-        components::ql::limit_t limit) {
+        components::ql::limit_t limit,
+        const components::ql::storage_parameters* parameters,
+        predicates_t conjuncts = {}) {
+        if (auto exprs = primary_key_predicates(expr); !exprs.empty()) {
+            return std::make_unique<operators::primary_key_scan>(context, std::move(exprs), limit);
+        }
+        if (expr->type() == components::expressions::compare_type::union_and) {
+            conjuncts.insert(conjuncts.end(), expr->children().begin(), expr->children().end());
+            if (auto op = create_plan_match_by_composite_index(context, expr, limit, parameters); op) {
+                return op;
+            }
+        } else if (expr->is_union()) {
+            conjuncts.clear();
+        }
         if (operators::merge::is_operator_merge(expr)) {
-            auto op = operators::merge::create_operator_merge(context, expr, limit);
-            operators::operator_ptr left = nullptr;
-            operators::operator_ptr right = nullptr;
-            left = create_plan_match_(context, expr->children().at(0), components::ql::limit_t::unlimit());
-            if (expr->children().size() > 1) { //todo: make if size > 2
-                right = create_plan_match_(context, expr->children().at(1), components::ql::limit_t::unlimit());
-            }
-            op->set_children(std::move(left), std::move(right));
-            return op;
+            const auto& children = expr->children();
+            auto left = create_plan_match_(context, children.at(0), components::ql::limit_t::unlimit(), parameters, conjuncts);
+            if (children.size() == 1 || expr->type() == components::expressions::compare_type::union_not) {
+                auto op = operators::merge::create_operator_merge(context, expr, limit);
+                op->set_children(std::move(left));
+                return op;
+            }
+            // n children are folded into a left-deep chain of binary merges, only the root applies the limit
+            for (std::size_t i = 1; i < children.size(); ++i) {
+                auto is_root = i + 1 == children.size();
+                auto op = operators::merge::create_operator_merge(context, expr, is_root ? limit : components::ql::limit_t::unlimit());
+                op->set_children(std::move(left), create_plan_match_(context, children.at(i), components::ql::limit_t::unlimit(), parameters, conjuncts));
+                left = std::move(op);
+            }
+            return left;
         }
-        //if (is_can_primary_key_find_by_predicate(expr->type()) && expr->key().as_string() == "_id") {
-            //return std::make_unique<operators::primary_key_scan>(context);
-        //}
-        if (is_can_index_find_by_predicate(expr->type()) && search_index(context->index_engine(), {expr->key()})) {
+        conjuncts.push_back(expr);
+        auto* index = search_index(context->index_engine(), {expr->key()});
+        if (index && is_can_index_find_by_predicate(index, expr) && is_index_complete(index, conjuncts, parameters)) {
             return std::make_unique<operators::index_scan>(context, expr, limit);
         }
+        if (auto op = create_plan_match_by_wildcard_index(context, expr, limit, parameters, conjuncts); op) {
+            return op;
+        }
         auto predicate = operators::predicates::create_predicate(context, expr);
         return std::make_unique<operators::full_scan>(context, std::move(predicate), limit);
     }
@@ -51,13 +311,35 @@ namespace services::collection::planner::impl {
     operators::operator_ptr create_plan_match(
             context_collection_t* context,
             const components::logical_plan::node_ptr& node,
-            components::ql::limit_t limit) {
+            components::ql::limit_t limit,
+            const components::ql::storage_parameters* parameters) {
         if (node->expressions().empty()) {
             return std::make_unique<operators::transfer_scan>(context, limit);
         } else { //todo: other kinds scan
             auto expr = reinterpret_cast<const components::expressions::compare_expression_ptr*>(&node->expressions()[0]);
-            return create_plan_match_(context, *expr, limit);
+            return create_plan_match_(context, *expr, limit, parameters);
+        }
+    }
+
+    operators::operator_ptr create_plan_match_in_index_order(
+            context_collection_t* context,
+            const components::logical_plan::node_ptr& match_node,
+            const components::logical_plan::node_ptr& sort_node,
+            components::ql::limit_t limit,
+            const components::ql::storage_parameters* parameters) {
+        if (match_node->expressions().size() != 1 || sort_node->expressions().size() != 1) {
+            return nullptr;
+        }
+        const auto& expr = reinterpret_cast<const components::expressions::compare_expression_ptr&>(match_node->expressions()[0]);
+        const auto* sort_expr = static_cast<const components::expressions::sort_expression_t*>(sort_node->expressions()[0].get());
+        if (expr->is_union() || !is_can_index_find_by_predicate(expr->type()) || !(expr->key() == sort_expr->key())) {
+            return nullptr;
+        }
+        auto* index = search_index(context->index_engine(), {expr->key()});
+        if (!index || index->type() != components::ql::index_type::single || !is_index_complete(index, {expr}, parameters)) {
+            return nullptr;
         }
+        return std::make_unique<operators::index_scan>(context, expr, limit, sort_expr->order());
     }
 
 }
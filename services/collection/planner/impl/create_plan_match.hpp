@@ -6,8 +6,18 @@
 
 namespace services::collection::planner::impl {
 
+    // parameters of the statement are needed to use sparse and partial indexes, without them only full indexes are used
     operators::operator_ptr create_plan_match(context_collection_t* context,
             const components::logical_plan::node_ptr& node,
-            components::ql::limit_t limit);
+            components::ql::limit_t limit,
+            const components::ql::storage_parameters* parameters = nullptr);
+
+    // index_scan that already yields documents in the order requested by sort_node, or nullptr
+    // when the match is not a single indexed predicate on the only sort key
+    operators::operator_ptr create_plan_match_in_index_order(context_collection_t* context,
+            const components::logical_plan::node_ptr& match_node,
+            const components::logical_plan::node_ptr& sort_node,
+            components::ql::limit_t limit,
+            const components::ql::storage_parameters* parameters = nullptr);
 
 }
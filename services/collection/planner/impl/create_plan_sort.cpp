@@ -0,0 +1,22 @@
+#include "create_plan_sort.hpp"
+#include <components/expressions/sort_expression.hpp>
+#include <services/collection/operators/operator_sort.hpp>
+
+namespace services::collection::planner::impl {
+
+    operators::operator_ptr create_plan_sort(
+            context_collection_t* context,
+            const components::logical_plan::node_ptr& node,
+            components::ql::limit_t limit) {
+        auto op = std::make_unique<operators::operator_sort_t>(context, limit);
+        for (const auto& expr : node->expressions()) {
+            auto* sort_expr = static_cast<const components::expressions::sort_expression_t*>(expr.get());
+            op->add(sort_expr->key().as_string(),
+                    sort_expr->order() == components::expressions::sort_order::desc
+                        ? operators::operator_sort_t::order::descending
+                        : operators::operator_sort_t::order::ascending);
+        }
+        return op;
+    }
+
+}
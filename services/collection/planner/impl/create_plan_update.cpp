@@ -8,7 +8,8 @@ namespace services::collection::planner::impl {
 
     operators::operator_ptr create_plan_update(
             context_collection_t* context,
-            const components::logical_plan::node_ptr& node) {
+            const components::logical_plan::node_ptr& node,
+            const components::ql::storage_parameters* parameters) {
         const auto *node_update = static_cast<const components::logical_plan::node_update_t*>(node.get());
 
         components::logical_plan::node_ptr node_match = nullptr;
@@ -22,7 +23,7 @@ namespace services::collection::planner::impl {
         }
 
         auto plan = std::make_unique<operators::operator_update>(context, node_update->update(), node_update->upsert());
-        plan->set_children(create_plan_match(context, node_match, static_cast<components::logical_plan::node_limit_t*>(node_limit.get())->limit()));
+        plan->set_children(create_plan_match(context, node_match, static_cast<components::logical_plan::node_limit_t*>(node_limit.get())->limit(), parameters));
 
         return plan;
     }
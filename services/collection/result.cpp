@@ -8,10 +8,19 @@ result_insert::result_insert(result_t&& inserted_ids)
     : inserted_ids_(std::move(inserted_ids)) {
 }
 
+result_insert::result_insert(result_t&& inserted_ids, components::document::packed_documents_ptr packed_documents)
+    : inserted_ids_(std::move(inserted_ids))
+    , packed_documents_(std::move(packed_documents)) {
+}
+
 const result_insert::result_t& result_insert::inserted_ids() const {
     return inserted_ids_;
 }
 
+const components::document::packed_documents_ptr& result_insert::packed_documents() const {
+    return packed_documents_;
+}
+
 bool result_insert::empty() const {
     return inserted_ids_.empty();
 }
@@ -58,6 +67,18 @@ result_size::result_t result_size::operator*() const {
 }
 
 
+result_memory_size::result_memory_size(const result_t& statistic)
+    : statistic_(statistic) {}
+
+const result_memory_size::result_t& result_memory_size::operator*() const {
+    return statistic_;
+}
+
+const result_memory_size::result_t* result_memory_size::operator->() const {
+    return &statistic_;
+}
+
+
 result_drop_collection::result_drop_collection(result_drop_collection::result_t success)
     : success_(success) {}
 
@@ -3,9 +3,11 @@
 #include <memory_resource>
 #include <variant>
 #include <vector>
+#include <core/pool_resource.hpp>
 #include <components/cursor/cursor.hpp>
 #include <components/document/document_view.hpp>
 #include <components/document/document_id.hpp>
+#include <components/document/msgpack/packed_documents.hpp>
 
 class null_result {
 public:
@@ -18,11 +20,15 @@ public:
 
     explicit result_insert(std::pmr::memory_resource *resource);
     explicit result_insert(result_t&& inserted_ids);
+    result_insert(result_t&& inserted_ids, components::document::packed_documents_ptr packed_documents);
     const result_t& inserted_ids() const;
+    // the inserted documents as the collection encoded them for the disk, the wal writes them too
+    const components::document::packed_documents_ptr& packed_documents() const;
     bool empty() const;
 
 private:
     result_t inserted_ids_;
+    components::document::packed_documents_ptr packed_documents_;
     //TODO: except or error_code
 };
 
@@ -70,6 +76,20 @@ private:
 };
 
 
+class result_memory_size {
+public:
+    using result_t = core::pmr::pool_resource_t::statistic_t;
+
+    result_memory_size() = default;
+    explicit result_memory_size(const result_t& statistic);
+    const result_t& operator*() const;
+    const result_t* operator->() const;
+
+private:
+    result_t statistic_;
+};
+
+
 class result_drop_collection {
 public:
     using result_t = bool;
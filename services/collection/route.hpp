@@ -16,6 +16,7 @@ namespace services::collection {
         drop_collection,
         create_index,
         drop_index,
+        memory_size,
 
         create_documents_finish,
         insert_finish,
@@ -26,7 +27,8 @@ namespace services::collection {
         size_finish,
         drop_collection_finish,
         create_index_finish,
-        drop_index_finish
+        drop_index_finish,
+        memory_size_finish
     };
 
     constexpr uint64_t handler_id(route type) {
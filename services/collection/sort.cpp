@@ -1,16 +1,175 @@
 #include "sort.hpp"
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#include <components/document/core/array.hpp>
+#include <components/document/core/dict.hpp>
 
 namespace services::storage::sort {
 
+    namespace {
+
+        using ::document::impl::value_type;
+
+        template<class T>
+        compare_t compare_as(T v1, T v2) {
+            if (v1 < v2) return compare_t::less;
+            if (v1 > v2) return compare_t::more;
+            return compare_t::equals;
+        }
+
+        compare_t reverse(compare_t res) {
+            return static_cast<compare_t>(-static_cast<int>(res));
+        }
+
+        int type_rank(value_type type) {
+            switch (type) {
+                case value_type::null: return 0;
+                case value_type::number: return 1;
+                case value_type::string: return 2;
+                case value_type::dict: return 3;
+                case value_type::array: return 4;
+                case value_type::data: return 5;
+                case value_type::boolean: return 6;
+                default: return 7;
+            }
+        }
+
+        // a finite double against an integer, exactly: the integral part first and the fraction breaks the tie
+        template<class INT>
+        compare_t compare_double_int(double number, INT integer) {
+            constexpr double lower = std::is_signed_v<INT> ? -0x1p63 : 0.0;
+            constexpr double upper = std::is_signed_v<INT> ? 0x1p63 : 0x1p64;
+            if (number < lower) return compare_t::less;
+            if (number >= upper) return compare_t::more;
+            auto integral = std::trunc(number);
+            auto res = compare_as(static_cast<INT>(integral), integer);
+            if (res != compare_t::equals) return res;
+            return compare_as(number, integral);
+        }
+
+        compare_t compare_numbers(const_value_ptr value1, const_value_ptr value2) {
+            if (!value1->is_int() || !value2->is_int()) {
+                if (value1->is_int()) {
+                    return reverse(compare_numbers(value2, value1));
+                }
+                auto number1 = value1->as_double();
+                // NaN goes before every other number and equals itself
+                if (std::isnan(number1)) {
+                    return value2->is_int() || !std::isnan(value2->as_double()) ? compare_t::less : compare_t::equals;
+                }
+                if (!value2->is_int()) {
+                    auto number2 = value2->as_double();
+                    return std::isnan(number2) ? compare_t::more : compare_as(number1, number2);
+                }
+                return value2->is_unsigned() ? compare_double_int(number1, value2->as_unsigned())
+                                             : compare_double_int(number1, value2->as_int());
+            }
+            auto is_big1 = value1->is_unsigned() && value1->as_unsigned() > uint64_t(std::numeric_limits<int64_t>::max());
+            auto is_big2 = value2->is_unsigned() && value2->as_unsigned() > uint64_t(std::numeric_limits<int64_t>::max());
+            if (is_big1 || is_big2) {
+                if (is_big1 && is_big2) return compare_as(value1->as_unsigned(), value2->as_unsigned());
+                return is_big1 ? compare_t::more : compare_t::less;
+            }
+            return compare_as(value1->as_int(), value2->as_int());
+        }
+
+        compare_t apply_order(compare_t res, order order_) {
+            return order_ == order::ascending ? res : reverse(res);
+        }
+
+    } // namespace
+
+    compare_t compare_values(const_value_ptr value1, const_value_ptr value2) {
+        if (value1 && !value2) return compare_t::less;
+        if (!value1 && value2) return compare_t::more;
+        if (!value1 && !value2) return compare_t::equals;
+        auto type1 = value1->type();
+        auto type2 = value2->type();
+        if (type1 != type2) {
+            return compare_as(type_rank(type1), type_rank(type2));
+        }
+        switch (type1) {
+            case value_type::boolean:
+                return compare_as(value1->as_bool(), value2->as_bool());
+            case value_type::number:
+                return compare_numbers(value1, value2);
+            case value_type::string:
+                return compare_as(value1->as_string(), value2->as_string());
+            case value_type::data:
+                return compare_as(value1->as_data(), value2->as_data());
+            case value_type::array: {
+                auto it1 = value1->as_array()->begin();
+                auto it2 = value2->as_array()->begin();
+                for (; it1 && it2; ++it1, ++it2) {
+                    auto res = compare_values(it1.value(), it2.value());
+                    if (res != compare_t::equals) return res;
+                }
+                return compare_as(bool(it1), bool(it2));
+            }
+            case value_type::dict: {
+                auto it1 = value1->as_dict()->begin();
+                auto it2 = value2->as_dict()->begin();
+                for (; it1 && it2; ++it1, ++it2) {
+                    auto res = compare_as(it1.key_string(), it2.key_string());
+                    if (res == compare_t::equals) {
+                        res = compare_values(it1.value(), it2.value());
+                    }
+                    if (res != compare_t::equals) return res;
+                }
+                return compare_as(bool(it1), bool(it2));
+            }
+            default:
+                return compare_t::equals;
+        }
+    }
+
     sorter_t::sorter_t(const std::string& key, order order_) {
         add(key, order_);
     }
 
     void sorter_t::add(const std::string& key, order order_) {
-        functions_.emplace_back([key, order_](const document_view_t* doc1, const document_view_t* doc2) {
-            auto k_order = static_cast<int>(order_ == order::ascending ? compare_t::more : compare_t::less);
-            return static_cast<compare_t>(k_order * static_cast<int>(doc1->compare(*doc2, key)));
-        });
+        keys_.emplace_back(key, order_);
+    }
+
+    bool sorter_t::operator()(const document_view_t* doc1, const document_view_t* doc2) const {
+        for (const auto& key : keys_) {
+            auto res = compare_values(key.first.get(doc1->get_value()), key.first.get(doc2->get_value()));
+            if (res != compare_t::equals) {
+                return apply_order(res, key.second) == compare_t::less;
+            }
+        }
+        return false;
+    }
+
+    bool sorter_t::operator()(const document_ptr& doc1, const document_ptr& doc2) const {
+        for (const auto& key : keys_) {
+            auto res = compare_values(key.first.get(doc1), key.first.get(doc2));
+            if (res != compare_t::equals) {
+                return apply_order(res, key.second) == compare_t::less;
+            }
+        }
+        return false;
+    }
+
+    std::size_t sorter_t::size() const {
+        return keys_.size();
+    }
+
+    void sorter_t::extract(const document_ptr& document, const_value_ptr* keys) const {
+        for (const auto& key : keys_) {
+            *keys++ = key.first.get(document);
+        }
+    }
+
+    compare_t sorter_t::compare(const const_value_ptr* keys1, const const_value_ptr* keys2) const {
+        for (const auto& key : keys_) {
+            auto res = compare_values(*keys1++, *keys2++);
+            if (res != compare_t::equals) {
+                return apply_order(res, key.second);
+            }
+        }
+        return compare_t::equals;
     }
 
-} // namespace services::storage::sort
\ No newline at end of file
+} // namespace services::storage::sort
@@ -1,6 +1,6 @@
 #pragma once
 #include <document/document_view.hpp>
-#include <functional>
+#include <document/field_path.hpp>
 #include <memory>
 
 using ::components::document::document_view_t;
@@ -15,33 +15,29 @@ namespace services::storage::sort {
         ascending = 1
     };
 
-    class sorter_t {
-        using function_t = std::function<compare_t(const document_view_t*, const document_view_t*)>;
+    using const_value_ptr = document_view_t::const_value_ptr;
+
+    // a total order over values: a missing value goes last, values of different types go by a fixed rank of their types
+    // (null, number, string, dict, array, data, boolean), numbers by value whatever their representation
+    compare_t compare_values(const_value_ptr value1, const_value_ptr value2);
 
+    class sorter_t {
     public:
         explicit sorter_t() = default;
         explicit sorter_t(const std::string& key, order order_ = order::ascending);
 
         void add(const std::string& key, order order_ = order::ascending);
-        bool operator()(const document_view_t* doc1, const document_view_t* doc2) const {
-            for (const auto &f : functions_) {
-                auto res = f(doc1, doc2);
-                if (res < compare_t::equals) {
-                    return true;
-                } else if (res > compare_t::equals) {
-                    return false;
-                }
-            }
-            return true;
-        }
-        bool operator()(const document_ptr &doc1, const document_ptr &doc2) const {
-            const document_view_t view1(doc1);
-            const document_view_t view2(doc2);
-            return operator()(&view1, &view2);
-        }
+        bool operator()(const document_view_t* doc1, const document_view_t* doc2) const;
+        bool operator()(const document_ptr &doc1, const document_ptr &doc2) const;
+
+        std::size_t size() const;
+
+        // sort keys are read once per document through their paths resolved by add, and compared by value afterwards
+        void extract(const document_ptr& document, const_value_ptr* keys) const;
+        compare_t compare(const const_value_ptr* keys1, const const_value_ptr* keys2) const;
 
     private:
-        std::vector<function_t> functions_;
+        std::vector<std::pair<components::document::field_path_t, order>> keys_;
     };
 
 } // namespace services::storage::sort
@@ -6,6 +6,8 @@
 #include <services/collection/operators/aggregate/operator_count.hpp>
 #include <services/collection/operators/aggregate/operator_sum.hpp>
 #include <services/collection/operators/aggregate/operator_avg.hpp>
+#include <services/collection/operators/aggregate/operator_min.hpp>
+#include <services/collection/operators/aggregate/operator_max.hpp>
 #include "test_operator_generaty.hpp"
 
 using namespace components;
@@ -50,6 +52,35 @@ TEST_CASE("operator::group::base") {
     }
 }
 
+TEST_CASE("operator::group::numbers") {
+    auto collection = create_collection();
+    std::pmr::vector<document_ptr> documents(collection->resource);
+    for (int i = 1; i <= 6; ++i) {
+        documents.emplace_back(gen_doc(i));
+    }
+    documents.at(0)->set("number", int64_t(1));
+    documents.at(1)->set("number", uint64_t(1));
+    documents.at(2)->set("number", 1.0);
+    documents.at(3)->set("number", 1.5);
+    documents.at(4)->set("number", int64_t(-2));
+    documents.at(5)->set("number", -2.0);
+    operator_insert insert(d(collection)->view(), std::move(documents));
+    insert.on_execute(nullptr);
+
+    operator_group_t group(d(collection)->view());
+    group.set_children(std::make_unique<transfer_scan>(d(collection)->view(), components::ql::limit_t::unlimit()));
+    group.add_key("number", get::simple_value_t::create(key("number")));
+    group.add_value("count", std::make_unique<aggregate::operator_count_t>(d(collection)->view()));
+    group.on_execute(nullptr);
+    REQUIRE(group.output()->size() == 3);
+    std::vector<int64_t> counts;
+    for (const auto& document : group.output()->documents()) {
+        counts.push_back(document_view_t(document).get_long("count"));
+    }
+    std::sort(counts.begin(), counts.end());
+    REQUIRE(counts == std::vector<int64_t>{1, 2, 3});
+}
+
 TEST_CASE("operator::group::sort") {
     auto collection = init_collection();
 
@@ -112,3 +143,34 @@ TEST_CASE("operator::group::all") {
         REQUIRE(std::fabs(view1.get_double("avg") - 52.14) < 0.01);
     }
 }
+
+TEST_CASE("operator::group::min_max") {
+    auto collection = init_collection();
+
+    SECTION("min_max::countBool") {
+        auto group = std::make_unique<operator_group_t>(d(collection)->view());
+        group->set_children(std::make_unique<transfer_scan>(d(collection)->view(), components::ql::limit_t::unlimit()));
+        group->add_key("countBool", get::simple_value_t::create(key("countBool")));
+        group->add_value("count", std::make_unique<aggregate::operator_count_t>(d(collection)->view()));
+        group->add_value("min", std::make_unique<aggregate::operator_min_t>(d(collection)->view(), key("count")));
+        group->add_value("max", std::make_unique<aggregate::operator_max_t>(d(collection)->view(), key("count")));
+
+        auto sort = std::make_unique<operator_sort_t>(d(collection)->view());
+        sort->set_children(std::move(group));
+        sort->add({"countBool"});
+        sort->on_execute(nullptr);
+        REQUIRE(sort->output()->size() == 2);
+
+        document_view_t view_false(sort->output()->documents().at(0));
+        REQUIRE(view_false.get_bool("countBool") == false);
+        REQUIRE(view_false.get_long("count") == 50);
+        REQUIRE(view_false.get_long("min") == 2);
+        REQUIRE(view_false.get_long("max") == 100);
+
+        document_view_t view_true(sort->output()->documents().at(1));
+        REQUIRE(view_true.get_bool("countBool") == true);
+        REQUIRE(view_true.get_long("count") == 50);
+        REQUIRE(view_true.get_long("min") == 1);
+        REQUIRE(view_true.get_long("max") == 99);
+    }
+}
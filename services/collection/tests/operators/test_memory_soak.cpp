@@ -0,0 +1,67 @@
+#include <catch2/catch.hpp>
+#include <components/expressions/compare_expression.hpp>
+#include <services/collection/operators/scan/full_scan.hpp>
+#include <services/collection/operators/operator_delete.hpp>
+#include <services/collection/operators/operator_insert.hpp>
+#include <services/collection/operators/predicates/predicate.hpp>
+#include "test_operator_generaty.hpp"
+
+using namespace components::expressions;
+using namespace services::collection::operators;
+using key = components::expressions::key_t;
+using components::ql::add_parameter;
+
+namespace {
+
+    constexpr int count_documents = 1000;
+
+    void insert_round(context_ptr& collection, int round) {
+        std::pmr::vector<document_ptr> documents(collection->resource);
+        documents.reserve(count_documents);
+        for (int i = 1; i <= count_documents; ++i) {
+            documents.emplace_back(gen_doc(round * count_documents + i));
+        }
+        operator_insert insert(d(collection)->view(), std::move(documents));
+        insert.on_execute(nullptr);
+    }
+
+    void delete_round(context_ptr& collection, int round) {
+        auto cond = make_compare_expression(d(collection)->view()->resource(),
+                                            compare_type::gt,
+                                            key("count"),
+                                            core::parameter_id_t(1));
+        operator_delete delete_(d(collection)->view());
+        delete_.set_children(std::make_unique<full_scan>(d(collection)->view(),
+                                                         predicates::create_predicate(d(collection)->view(), cond),
+                                                         components::ql::limit_t::unlimit()));
+        components::ql::storage_parameters parameters;
+        add_parameter(parameters, core::parameter_id_t(1), round * count_documents);
+        components::pipeline::context_t pipeline_context(std::move(parameters));
+        delete_.on_execute(&pipeline_context);
+    }
+
+} // namespace
+
+// insert/delete churn on a long-lived collection: once the pool has grown to the working set,
+// freed blocks are reused and the memory the collection holds stays flat
+TEST_CASE("collection::memory::churn") {
+    auto collection = create_collection();
+    constexpr int warm_up_rounds = 5;
+    constexpr int rounds = 50;
+    core::pmr::pool_resource_t::statistic_t warm;
+    for (int round = 0; round < rounds; ++round) {
+        insert_round(collection, round);
+        REQUIRE(d(collection)->size_test() == count_documents);
+        delete_round(collection, round);
+        REQUIRE(d(collection)->size_test() == 0);
+        if (round + 1 == warm_up_rounds) {
+            warm = d(collection)->memory_size_test();
+        }
+    }
+    auto last = d(collection)->memory_size_test();
+    REQUIRE(warm.reserved_bytes > 0);
+    REQUIRE(last.reserved_bytes <= warm.reserved_bytes + warm.reserved_bytes / 2);
+    REQUIRE(last.bytes_in_use <= warm.bytes_in_use + warm.bytes_in_use / 2);
+    REQUIRE(last.peak_bytes_in_use >= last.bytes_in_use);
+    REQUIRE(last.deallocations > warm.deallocations);
+}
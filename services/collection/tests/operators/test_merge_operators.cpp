@@ -128,3 +128,54 @@ TEST_CASE("operator_merge::complex") {
     op->on_execute(&pipeline_context);
     REQUIRE(op->output()->size() == 10);
 }
+
+TEST_CASE("operator_merge::and::short_circuit") {
+    auto collection = init_collection();
+    auto cond1 = make_compare_expression(d(collection)->view()->resource(),
+                                         compare_type::gt,
+                                         key("count"),
+                                         core::parameter_id_t(1));
+    auto cond2 = make_compare_expression(d(collection)->view()->resource(),
+                                         compare_type::lte,
+                                         key("count"),
+                                         core::parameter_id_t(2));
+    operator_and_t op_and(d(collection)->view(), components::ql::limit_t::unlimit());
+    op_and.set_children(std::make_unique<full_scan>(d(collection)->view(),
+                                                    predicates::create_predicate(d(collection)->view(), cond1),
+                                                    components::ql::limit_t::unlimit()),
+                        std::make_unique<full_scan>(d(collection)->view(),
+                                                    predicates::create_predicate(d(collection)->view(), cond2),
+                                                    components::ql::limit_t::unlimit()));
+    components::ql::storage_parameters parameters;
+    add_parameter(parameters, core::parameter_id_t(1), 100);
+    add_parameter(parameters, core::parameter_id_t(2), 60);
+    components::pipeline::context_t pipeline_context(std::move(parameters));
+    op_and.on_execute(&pipeline_context);
+    REQUIRE(op_and.is_executed());
+    REQUIRE(op_and.output()->size() == 0);
+}
+
+TEST_CASE("operator_merge::or::empty_side") {
+    auto collection = init_collection();
+    auto cond1 = make_compare_expression(d(collection)->view()->resource(),
+                                         compare_type::gt,
+                                         key("count"),
+                                         core::parameter_id_t(1));
+    auto cond2 = make_compare_expression(d(collection)->view()->resource(),
+                                         compare_type::lte,
+                                         key("count"),
+                                         core::parameter_id_t(2));
+    operator_or_t op_or(d(collection)->view(), components::ql::limit_t::unlimit());
+    op_or.set_children(std::make_unique<full_scan>(d(collection)->view(),
+                                                   predicates::create_predicate(d(collection)->view(), cond1),
+                                                   components::ql::limit_t::unlimit()),
+                       std::make_unique<full_scan>(d(collection)->view(),
+                                                   predicates::create_predicate(d(collection)->view(), cond2),
+                                                   components::ql::limit_t::unlimit()));
+    components::ql::storage_parameters parameters;
+    add_parameter(parameters, core::parameter_id_t(1), 100);
+    add_parameter(parameters, core::parameter_id_t(2), 60);
+    components::pipeline::context_t pipeline_context(std::move(parameters));
+    op_or.on_execute(&pipeline_context);
+    REQUIRE(op_or.output()->size() == 60);
+}
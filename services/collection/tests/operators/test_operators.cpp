@@ -113,6 +113,47 @@ TEST_CASE("operator::full_scan") {
         REQUIRE(scan.output()->size() == 90);
     }
 
+    SECTION("find::regex") {
+        auto cond = make_compare_expression(d(collection)->view()->resource(),
+                                            compare_type::regex,
+                                            key("countStr"),
+                                            core::parameter_id_t(1));
+        auto scan_count = [&](std::string_view pattern) {
+            full_scan scan(d(collection)->view(),
+                           predicates::create_predicate(d(collection)->view(), cond),
+                           components::ql::limit_t::unlimit());
+            components::ql::storage_parameters parameters;
+            add_parameter(parameters, core::parameter_id_t(1), pattern);
+            components::pipeline::context_t pipeline_context(std::move(parameters));
+            scan.on_execute(&pipeline_context);
+            return scan.output()->size();
+        };
+        REQUIRE(scan_count("9") == 19);
+        REQUIRE(scan_count("^9") == 11);
+        REQUIRE(scan_count("0$") == 10);
+        REQUIRE(scan_count("^10$") == 1);
+        REQUIRE(scan_count("^[1-2]0$") == 2);
+        REQUIRE(scan_count("1.0") == 1);
+    }
+
+    SECTION("find::regex::change_parameter") {
+        auto cond = make_compare_expression(d(collection)->view()->resource(),
+                                            compare_type::regex,
+                                            key("countStr"),
+                                            core::parameter_id_t(1));
+        auto predicate = predicates::create_predicate(d(collection)->view(), cond);
+        auto document = gen_doc(42);
+        auto check = [&](std::string_view pattern) {
+            components::ql::storage_parameters parameters;
+            add_parameter(parameters, core::parameter_id_t(1), pattern);
+            return predicate->check(document, &parameters);
+        };
+        REQUIRE(check("^4"));
+        REQUIRE_FALSE(check("^2"));
+        REQUIRE(check("[0-9]2"));
+        REQUIRE(check("42"));
+    }
+
     SECTION("find_one") {
         auto cond = make_compare_expression(d(collection)->view()->resource(),
                                             compare_type::gt,
@@ -412,6 +453,26 @@ TEST_CASE("operator::index_scan") {
         scan.on_execute(&pipeline_context);
         REQUIRE(scan.output()->size() == 3);
     }
+
+    SECTION("find::order") {
+        auto cond = make_compare_expression(d(collection)->view()->resource(),
+                                            compare_type::ne,
+                                            key("count"),
+                                            core::parameter_id_t(1));
+        auto check = [&](sort_order order, components::ql::limit_t limit, const std::vector<int64_t>& expected) {
+            index_scan scan(d(collection)->view(), cond, limit, order);
+            components::ql::storage_parameters parameters;
+            add_parameter(parameters, core::parameter_id_t(1), 99);
+            components::pipeline::context_t pipeline_context(std::move(parameters));
+            scan.on_execute(&pipeline_context);
+            REQUIRE(scan.output()->size() == expected.size());
+            for (std::size_t i = 0; i < expected.size(); ++i) {
+                REQUIRE(components::document::document_view_t(scan.output()->documents().at(i)).get_long("count") == expected.at(i));
+            }
+        };
+        check(sort_order::asc, components::ql::limit_t(3), {1, 2, 3});
+        check(sort_order::desc, components::ql::limit_t(3), {100, 98, 97});
+    }
 }
 
 
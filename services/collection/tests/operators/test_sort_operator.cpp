@@ -0,0 +1,71 @@
+#include <catch2/catch.hpp>
+#include <services/collection/operators/operator_sort.hpp>
+#include <services/collection/operators/scan/transfer_scan.hpp>
+#include "test_operator_generaty.hpp"
+
+using namespace components;
+using namespace services::collection::operators;
+
+TEST_CASE("operator::sort") {
+    auto collection = init_collection();
+
+    SECTION("sort::desc") {
+        auto sort = std::make_unique<operator_sort_t>(d(collection)->view());
+        sort->set_children(std::make_unique<transfer_scan>(d(collection)->view(), components::ql::limit_t::unlimit()));
+        sort->add("count", operator_sort_t::order::descending);
+        sort->on_execute(nullptr);
+        REQUIRE(sort->output()->size() == 100);
+        for (int i = 0; i < 100; ++i) {
+            REQUIRE(document_view_t(sort->output()->documents().at(std::size_t(i))).get_long("count") == 100 - i);
+        }
+    }
+
+    SECTION("sort::top_k") {
+        auto sort = std::make_unique<operator_sort_t>(d(collection)->view(), components::ql::limit_t(5));
+        sort->set_children(std::make_unique<transfer_scan>(d(collection)->view(), components::ql::limit_t::unlimit()));
+        sort->add("countBool");
+        sort->add("count", operator_sort_t::order::descending);
+        sort->on_execute(nullptr);
+        REQUIRE(sort->output()->size() == 5);
+        for (int i = 0; i < 5; ++i) {
+            REQUIRE(document_view_t(sort->output()->documents().at(std::size_t(i))).get_long("count") == 100 - 2 * i);
+        }
+    }
+
+    SECTION("sort::limit_more_than_size") {
+        auto sort = std::make_unique<operator_sort_t>(d(collection)->view(), components::ql::limit_t(1000));
+        sort->set_children(std::make_unique<transfer_scan>(d(collection)->view(), components::ql::limit_t::unlimit()));
+        sort->add("countStr");
+        sort->on_execute(nullptr);
+        REQUIRE(sort->output()->size() == 100);
+        REQUIRE(document_view_t(sort->output()->documents().front()).get_string("countStr") == "1");
+        REQUIRE(document_view_t(sort->output()->documents().back()).get_string("countStr") == "99");
+    }
+}
+
+TEST_CASE("operator::sort::compare_values") {
+    using components::document::compare_t;
+    using services::storage::sort::compare_values;
+    auto doc = components::document::document_from_json(
+        R"({"int": 1, "double": 1.5, "one": 1.0, "negative": -2, "string": "1", "bool": true, "null": null,)"
+        R"( "array": [1, 2], "short_array": [1], "dict": {"a": 1}})");
+    document_view_t view(doc);
+    auto value = [&view](const char* key) { return view.get_value(key); };
+
+    REQUIRE(compare_values(value("int"), value("one")) == compare_t::equals);
+    REQUIRE(compare_values(value("int"), value("double")) == compare_t::less);
+    REQUIRE(compare_values(value("double"), value("int")) == compare_t::more);
+    REQUIRE(compare_values(value("negative"), value("int")) == compare_t::less);
+
+    // different types go by their rank, whatever the order they are asked in
+    REQUIRE(compare_values(value("null"), value("int")) == compare_t::less);
+    REQUIRE(compare_values(value("int"), value("string")) == compare_t::less);
+    REQUIRE(compare_values(value("string"), value("int")) == compare_t::more);
+    REQUIRE(compare_values(value("string"), value("dict")) == compare_t::less);
+    REQUIRE(compare_values(value("dict"), value("array")) == compare_t::less);
+    REQUIRE(compare_values(value("array"), value("bool")) == compare_t::less);
+    REQUIRE(compare_values(value("bool"), value("missing")) == compare_t::less);
+
+    REQUIRE(compare_values(value("short_array"), value("array")) == compare_t::less);
+    REQUIRE(compare_values(value("array"), value("array")) == compare_t::equals);
+}
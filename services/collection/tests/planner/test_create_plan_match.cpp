@@ -1,6 +1,20 @@
 #include <catch2/catch.hpp>
 #include <components/expressions/compare_expression.hpp>
+#include <components/index/composite_field_index.hpp>
+#include <components/index/hash_index.hpp>
+#include <components/index/multikey_index.hpp>
+#include <components/index/single_field_index.hpp>
+#include <components/index/wildcard_index.hpp>
+#include <components/logical_plan/node_aggregate.hpp>
+#include <components/logical_plan/node_limit.hpp>
 #include <components/logical_plan/node_match.hpp>
+#include <components/logical_plan/node_sort.hpp>
+#include <services/collection/operators/merge/operator_and.hpp>
+#include <services/collection/operators/scan/composite_index_scan.hpp>
+#include <services/collection/operators/scan/full_scan.hpp>
+#include <services/collection/operators/scan/index_scan.hpp>
+#include <services/collection/operators/scan/primary_key_scan.hpp>
+#include <services/collection/operators/scan/wildcard_index_scan.hpp>
 #include <services/collection/planner/create_plan.hpp>
 #include <services/collection/tests/operators/test_operator_generaty.hpp>
 #include <actor-zeta.hpp>
@@ -17,6 +31,61 @@ collection_full_name_t get_name() {
     return {database_name, collection_name};
 }
 
+// the values become the parameters #1, #2, ... in their order
+template<class... Values>
+components::ql::storage_parameters make_parameters(Values... values) {
+    components::ql::storage_parameters parameters;
+    uint16_t id = 0;
+    (components::ql::add_parameter(parameters, core::parameter_id_t(++id), values), ...);
+    return parameters;
+}
+
+const document::impl::value_t* make_array(const std::vector<int>& values) {
+    auto array = document::impl::array_t::new_array();
+    for (auto value : values) {
+        array->append(value);
+    }
+    return array.detach();
+}
+
+// plans the match of expr, checks the plan is an Operator and returns the number of documents it finds;
+// with is_planned_with_parameters false the planner does not see the values of the parameters
+template<class Operator>
+std::size_t execute_match(context_ptr& collection,
+                          const compare_expression_ptr& expr,
+                          components::ql::limit_t limit,
+                          components::ql::storage_parameters parameters,
+                          bool is_planned_with_parameters = true) {
+    auto* resource = actor_zeta::detail::pmr::get_default_resource();
+    auto match = components::ql::aggregate::make_match(expr);
+    auto node_match = make_node_match(resource, get_name(), match);
+    auto plan = create_plan(d(collection)->view(), node_match, limit, is_planned_with_parameters ? &parameters : nullptr);
+    REQUIRE(dynamic_cast<Operator*>(plan.get()) != nullptr);
+    components::pipeline::context_t pipeline_context(std::move(parameters));
+    plan->on_execute(&pipeline_context);
+    REQUIRE(plan->output() != nullptr);
+    return plan->output()->size();
+}
+
+// the number of documents a full scan of the predicate finds, whatever the planner would choose
+std::size_t execute_full_scan(context_ptr& collection,
+                              const compare_expression_ptr& expr,
+                              components::ql::storage_parameters parameters) {
+    services::collection::operators::full_scan scan(d(collection)->view(),
+                                                    services::collection::operators::predicates::create_predicate(d(collection)->view(), expr),
+                                                    components::ql::limit_t::unlimit());
+    components::pipeline::context_t pipeline_context(std::move(parameters));
+    scan.on_execute(&pipeline_context);
+    return scan.output()->size();
+}
+
+using services::collection::operators::composite_index_scan;
+using services::collection::operators::full_scan;
+using services::collection::operators::index_scan;
+using services::collection::operators::merge::operator_and_t;
+using services::collection::operators::primary_key_scan;
+using services::collection::operators::wildcard_index_scan;
+
 TEST_CASE("create_plan::match") {
     auto collection = init_collection();
     auto* resource = actor_zeta::detail::pmr::get_default_resource();
@@ -34,3 +103,288 @@ TEST_CASE("create_plan::match") {
         //REQUIRE(node_match->to_string() == R"_($match: {"key": {$eq: #1}})_");
     }
 }
+
+TEST_CASE("create_plan::match::n_ary") {
+    auto collection = init_collection();
+    auto* resource = actor_zeta::detail::pmr::get_default_resource();
+    auto make_union = [&](compare_type type) {
+        auto expr = make_compare_union_expression(resource, type);
+        expr->append_child(make_compare_expression(resource, compare_type::gt, key("count"), core::parameter_id_t(1)));
+        expr->append_child(make_compare_expression(resource, compare_type::lte, key("count"), core::parameter_id_t(2)));
+        expr->append_child(make_compare_expression(resource, compare_type::ne, key("count"), core::parameter_id_t(3)));
+        return expr;
+    };
+    auto execute = [&](const compare_expression_ptr& expr) {
+        auto match = components::ql::aggregate::make_match(expr);
+        auto node_match = make_node_match(resource, get_name(), match);
+        auto plan = create_plan(d(collection)->view(), node_match, components::ql::limit_t::unlimit());
+        components::ql::storage_parameters parameters;
+        components::ql::add_parameter(parameters, core::parameter_id_t(1), 10);
+        components::ql::add_parameter(parameters, core::parameter_id_t(2), 20);
+        components::ql::add_parameter(parameters, core::parameter_id_t(3), 15);
+        components::pipeline::context_t pipeline_context(std::move(parameters));
+        plan->on_execute(&pipeline_context);
+        return plan->output()->size();
+    };
+    REQUIRE(execute(make_union(compare_type::union_and)) == 9);
+    REQUIRE(execute(make_union(compare_type::union_or)) == 100);
+}
+
+TEST_CASE("create_plan::aggregate::sort_limit") {
+    auto collection = init_collection();
+    auto* resource = actor_zeta::detail::pmr::get_default_resource();
+    components::ql::aggregate::sort_t sort;
+    components::ql::aggregate::append_sort(sort, key("count"), sort_order::desc);
+    node_ptr node = new node_aggregate_t(resource, get_name());
+    node->append_child(make_node_sort(resource, get_name(), sort));
+    node->append_child(make_node_limit(resource, get_name(), components::ql::limit_t(3)));
+    auto plan = create_plan(d(collection)->view(), node, components::ql::limit_t::unlimit());
+    plan->on_execute(nullptr);
+    REQUIRE(plan->output()->size() == 3);
+    REQUIRE(document_view_t(plan->output()->documents().at(0)).get_long("count") == 100);
+    REQUIRE(document_view_t(plan->output()->documents().at(2)).get_long("count") == 98);
+}
+
+TEST_CASE("create_plan::aggregate::limit_before_sort") {
+    auto collection = init_collection();
+    auto* resource = actor_zeta::detail::pmr::get_default_resource();
+    components::ql::aggregate::sort_t sort;
+    components::ql::aggregate::append_sort(sort, key("count"), sort_order::desc);
+    node_ptr node = new node_aggregate_t(resource, get_name());
+    node->append_child(make_node_limit(resource, get_name(), components::ql::limit_t(3)));
+    node->append_child(make_node_sort(resource, get_name(), sort));
+    node->append_child(make_node_limit(resource, get_name(), components::ql::limit_t(2)));
+    auto plan = create_plan(d(collection)->view(), node, components::ql::limit_t::unlimit());
+    plan->on_execute(nullptr);
+    // the first limit takes three documents in storage order, only the second one cuts the sorted output
+    REQUIRE(plan->output()->size() == 2);
+    auto first = document_view_t(plan->output()->documents().at(0)).get_long("count");
+    auto second = document_view_t(plan->output()->documents().at(1)).get_long("count");
+    REQUIRE(first < 100);
+    REQUIRE(first > second);
+}
+
+TEST_CASE("create_plan::aggregate::index_order") {
+    auto collection = create_collection();
+    auto* resource = actor_zeta::detail::pmr::get_default_resource();
+    components::index::keys_base_storage_t keys(collection->resource);
+    keys.emplace_back("count");
+    components::index::make_index<components::index::single_field_index_t>(d(collection)->view()->index_engine(), "single_count", keys);
+    fill_collection(collection);
+
+    auto match = components::ql::aggregate::make_match(make_compare_expression(resource, compare_type::gt, key("count"), core::parameter_id_t(1)));
+    components::ql::aggregate::sort_t sort;
+    components::ql::aggregate::append_sort(sort, key("count"), sort_order::desc);
+    node_ptr node = new node_aggregate_t(resource, get_name());
+    node->append_child(make_node_match(resource, get_name(), match));
+    node->append_child(make_node_sort(resource, get_name(), sort));
+    node->append_child(make_node_limit(resource, get_name(), components::ql::limit_t(3)));
+    auto plan = create_plan(d(collection)->view(), node, components::ql::limit_t::unlimit());
+    components::ql::storage_parameters parameters;
+    components::ql::add_parameter(parameters, core::parameter_id_t(1), 50);
+    components::pipeline::context_t pipeline_context(std::move(parameters));
+    plan->on_execute(&pipeline_context);
+    REQUIRE(plan->output()->size() == 3);
+    REQUIRE(document_view_t(plan->output()->documents().at(0)).get_long("count") == 100);
+    REQUIRE(document_view_t(plan->output()->documents().at(1)).get_long("count") == 99);
+    REQUIRE(document_view_t(plan->output()->documents().at(2)).get_long("count") == 98);
+}
+
+TEST_CASE("create_plan::match::composite_index") {
+    auto collection = create_collection();
+    auto* resource = actor_zeta::detail::pmr::get_default_resource();
+    components::index::keys_base_storage_t keys(collection->resource);
+    keys.emplace_back("group");
+    keys.emplace_back("count");
+    components::index::make_index<components::index::composite_field_index_t>(d(collection)->view()->index_engine(), "composite_group_count", keys);
+    std::pmr::vector<document_ptr> documents(collection->resource);
+    for (int i = 1; i <= 100; ++i) {
+        auto doc = document::impl::dict_t::new_dict();
+        doc->set("_id", gen_id(i));
+        doc->set("group", i % 4);
+        doc->set("count", i);
+        documents.emplace_back(make_document(doc));
+    }
+    services::collection::operators::operator_insert insert(d(collection)->view(), std::move(documents));
+    insert.on_execute(nullptr);
+
+    auto make_and = [&](compare_type group_type, compare_type count_type) {
+        auto expr = make_compare_union_expression(resource, compare_type::union_and);
+        expr->append_child(make_compare_expression(resource, count_type, key("count"), core::parameter_id_t(2)));
+        expr->append_child(make_compare_expression(resource, group_type, key("group"), core::parameter_id_t(1)));
+        return expr;
+    };
+    auto unlimit = components::ql::limit_t::unlimit();
+
+    REQUIRE(execute_match<composite_index_scan>(collection, make_and(compare_type::eq, compare_type::gt), unlimit, make_parameters(1, 50)) == 12);
+    REQUIRE(execute_match<composite_index_scan>(collection, make_and(compare_type::eq, compare_type::gte), unlimit, make_parameters(1, 50)) == 12);
+    REQUIRE(execute_match<composite_index_scan>(collection, make_and(compare_type::eq, compare_type::lt), unlimit, make_parameters(1, 50)) == 13);
+    REQUIRE(execute_match<composite_index_scan>(collection, make_and(compare_type::eq, compare_type::lte), unlimit, make_parameters(1, 50)) == 13);
+    REQUIRE(execute_match<composite_index_scan>(collection, make_and(compare_type::eq, compare_type::eq), unlimit, make_parameters(1, 50)) == 0);
+    REQUIRE(execute_match<operator_and_t>(collection, make_and(compare_type::eq, compare_type::ne), unlimit, make_parameters(1, 50)) == 25);
+    REQUIRE(execute_match<operator_and_t>(collection, make_and(compare_type::gt, compare_type::eq), unlimit, make_parameters(1, 50)) == 1);
+}
+
+TEST_CASE("create_plan::match::hash_index") {
+    auto collection = create_collection();
+    auto* resource = actor_zeta::detail::pmr::get_default_resource();
+    components::index::keys_base_storage_t keys(collection->resource);
+    keys.emplace_back("count");
+    components::index::make_index<components::index::hash_index_t>(d(collection)->view()->index_engine(), "hash_count", keys);
+    fill_collection(collection);
+
+    auto count = [&](compare_type type) {
+        return make_compare_expression(resource, type, key("count"), core::parameter_id_t(1));
+    };
+    auto unlimit = components::ql::limit_t::unlimit();
+
+    REQUIRE(execute_match<index_scan>(collection, count(compare_type::eq), unlimit, make_parameters(90)) == 1);
+    REQUIRE(execute_match<index_scan>(collection, count(compare_type::ne), unlimit, make_parameters(90)) == 99);
+    REQUIRE(execute_match<full_scan>(collection, count(compare_type::gt), unlimit, make_parameters(90)) == 10);
+    REQUIRE(execute_match<full_scan>(collection, count(compare_type::lte), unlimit, make_parameters(90)) == 90);
+}
+
+TEST_CASE("create_plan::match::primary_key") {
+    auto collection = init_collection();
+    auto* resource = actor_zeta::detail::pmr::get_default_resource();
+    auto make_in = [&](std::size_t size) {
+        auto expr = make_compare_union_expression(resource, compare_type::union_or);
+        for (std::size_t i = 0; i < size; ++i) {
+            expr->append_child(make_compare_expression(resource, compare_type::eq, key("_id"), core::parameter_id_t(uint16_t(i + 1))));
+        }
+        return expr;
+    };
+    auto eq = make_compare_expression(resource, compare_type::eq, key("_id"), core::parameter_id_t(1));
+
+    auto ids = [](auto... numbers) {
+        return make_parameters(gen_id(numbers)...);
+    };
+
+    REQUIRE(execute_match<primary_key_scan>(collection, eq, components::ql::limit_t::unlimit(), ids(10)) == 1);
+    REQUIRE(execute_match<primary_key_scan>(collection, eq, components::ql::limit_t::limit_one(), ids(101)) == 0);
+    REQUIRE(execute_match<primary_key_scan>(collection, eq, components::ql::limit_t::limit_one(), make_parameters(std::string("not an id"))) == 0);
+    REQUIRE(execute_match<primary_key_scan>(collection, make_in(4), components::ql::limit_t::unlimit(), ids(5, 7, 5, 200)) == 2);
+    REQUIRE(execute_match<primary_key_scan>(collection, make_in(4), components::ql::limit_t::limit_one(), ids(5, 7, 5, 200)) == 1);
+}
+
+TEST_CASE("create_plan::match::sparse_partial_index") {
+    auto collection = create_collection();
+    auto* resource = actor_zeta::detail::pmr::get_default_resource();
+    auto* view = d(collection)->view();
+    components::index::keys_base_storage_t flag_keys(collection->resource);
+    flag_keys.emplace_back("flag");
+    auto flag_id = components::index::make_index<components::index::single_field_index_t>(view->index_engine(), "sparse_flag", flag_keys);
+    components::index::search_index(view->index_engine(), flag_id)->set_sparse(true);
+    components::index::keys_base_storage_t count_keys(collection->resource);
+    count_keys.emplace_back("count");
+    auto count_id = components::index::make_index<components::index::single_field_index_t>(view->index_engine(), "partial_count", count_keys);
+    components::ql::storage_parameters filter_parameters;
+    components::ql::add_parameter(filter_parameters, core::parameter_id_t(1), 90);
+    components::index::search_index(view->index_engine(), count_id)->set_partial_filter(
+        make_compare_expression(resource, compare_type::gt, key("count"), core::parameter_id_t(1)),
+        std::move(filter_parameters),
+        [](const document_ptr& doc) {
+            return document_view_t(doc).get_long("count") > 90;
+        });
+    std::pmr::vector<document_ptr> documents(collection->resource);
+    for (int i = 1; i <= 100; ++i) {
+        auto doc = document::impl::dict_t::new_dict();
+        doc->set("_id", gen_id(i));
+        doc->set("count", i);
+        if (i % 10 == 0) {
+            doc->set("flag", i);
+        } else if (i % 10 == 5) {
+            doc->set("flag", nullptr);
+        }
+        documents.emplace_back(make_document(doc));
+    }
+    services::collection::operators::operator_insert insert(d(collection)->view(), std::move(documents));
+    insert.on_execute(nullptr);
+
+    auto compare = [&](compare_type type, const std::string& field) {
+        return make_compare_expression(resource, type, key(field), core::parameter_id_t(1));
+    };
+    auto unlimit = components::ql::limit_t::unlimit();
+
+    REQUIRE(execute_match<index_scan>(collection, compare(compare_type::eq, "flag"), unlimit, make_parameters(10)) == 1);
+    REQUIRE(execute_match<full_scan>(collection, compare(compare_type::eq, "flag"), unlimit, make_parameters(10), false) == 1);
+    REQUIRE(execute_match<full_scan>(collection, compare(compare_type::ne, "flag"), unlimit, make_parameters(10)) == 19);
+    REQUIRE(execute_match<index_scan>(collection, compare(compare_type::lte, "flag"), unlimit, make_parameters(50)) == 5);
+    REQUIRE(execute_match<index_scan>(collection, compare(compare_type::gt, "count"), unlimit, make_parameters(95)) == 5);
+    REQUIRE(execute_match<index_scan>(collection, compare(compare_type::eq, "count"), unlimit, make_parameters(93)) == 1);
+    REQUIRE(execute_match<full_scan>(collection, compare(compare_type::gt, "count"), unlimit, make_parameters(50)) == 50);
+    REQUIRE(execute_match<full_scan>(collection, compare(compare_type::lt, "count"), unlimit, make_parameters(95)) == 94);
+}
+
+TEST_CASE("create_plan::match::multikey_index") {
+    auto indexed = create_collection();
+    auto* resource = actor_zeta::detail::pmr::get_default_resource();
+    components::index::keys_base_storage_t keys(indexed->resource);
+    keys.emplace_back("countArray");
+    components::index::make_index<components::index::multikey_index_t>(d(indexed)->view()->index_engine(), "multikey_count_array", keys);
+    fill_collection(indexed);
+    auto single = create_collection();
+    components::index::make_index<components::index::single_field_index_t>(d(single)->view()->index_engine(), "single_count_array", keys);
+    fill_collection(single);
+    auto scanned = init_collection();
+
+    // countArray of the document i is [i, i + 4], an index and a full scan agree on every predicate
+    auto count_array = [&](compare_type type) {
+        return make_compare_expression(resource, type, key("countArray"), core::parameter_id_t(1));
+    };
+    auto unlimit = components::ql::limit_t::unlimit();
+
+    REQUIRE(execute_match<index_scan>(indexed, count_array(compare_type::any), unlimit, make_parameters(make_array({10, 11, 11}))) == 6);
+    REQUIRE(execute_match<full_scan>(scanned, count_array(compare_type::any), unlimit, make_parameters(make_array({10, 11, 11}))) == 6);
+    REQUIRE(execute_match<index_scan>(indexed, count_array(compare_type::any), unlimit, make_parameters(make_array({10, 50}))) == 10);
+    REQUIRE(execute_match<full_scan>(scanned, count_array(compare_type::any), unlimit, make_parameters(make_array({10, 50}))) == 10);
+    REQUIRE(execute_match<index_scan>(indexed, count_array(compare_type::all), unlimit, make_parameters(make_array({10, 12}))) == 3);
+    REQUIRE(execute_match<full_scan>(scanned, count_array(compare_type::all), unlimit, make_parameters(make_array({10, 12}))) == 3);
+    REQUIRE(execute_match<index_scan>(indexed, count_array(compare_type::all), unlimit, make_parameters(make_array({10, 20}))) == 0);
+    REQUIRE(execute_match<full_scan>(scanned, count_array(compare_type::all), unlimit, make_parameters(make_array({10, 20}))) == 0);
+    // a range compares whole values and an array sorts after every number
+    REQUIRE(execute_match<full_scan>(indexed, count_array(compare_type::gt), unlimit, make_parameters(100)) == 100);
+
+    // eq compares whole arrays whatever the indexes, the multikey index holding elements is left out
+    REQUIRE(execute_match<full_scan>(indexed, count_array(compare_type::eq), unlimit, make_parameters(10)) == 0);
+    REQUIRE(execute_match<index_scan>(single, count_array(compare_type::eq), unlimit, make_parameters(10)) == 0);
+    REQUIRE(execute_match<full_scan>(scanned, count_array(compare_type::eq), unlimit, make_parameters(10)) == 0);
+    REQUIRE(execute_match<index_scan>(single, count_array(compare_type::eq), unlimit, make_parameters(make_array({10, 11, 12, 13, 14}))) == 1);
+    REQUIRE(execute_match<full_scan>(scanned, count_array(compare_type::eq), unlimit, make_parameters(make_array({10, 11, 12, 13, 14}))) == 1);
+    REQUIRE(execute_match<full_scan>(indexed, count_array(compare_type::eq), unlimit, make_parameters(make_array({10, 11, 12, 13, 14}))) == 1);
+}
+
+TEST_CASE("create_plan::match::wildcard_index") {
+    auto collection = create_collection();
+    auto* resource = actor_zeta::detail::pmr::get_default_resource();
+    components::index::keys_base_storage_t keys(collection->resource);
+    keys.emplace_back(components::index::wildcard_index_t::key);
+    components::index::keys_base_storage_t include(collection->resource);
+    components::index::keys_base_storage_t exclude(collection->resource);
+    exclude.emplace_back("countStr");
+    components::index::make_index<components::index::wildcard_index_t>(d(collection)->view()->index_engine(), "wildcard", keys, include, exclude);
+    fill_collection(collection);
+
+    auto compare = [&](compare_type type, const std::string& field) {
+        return make_compare_expression(resource, type, key(field), core::parameter_id_t(1));
+    };
+    auto unlimit = components::ql::limit_t::unlimit();
+
+    REQUIRE(execute_match<wildcard_index_scan>(collection, compare(compare_type::eq, "count"), unlimit, make_parameters(10)) == 1);
+    REQUIRE(execute_match<wildcard_index_scan>(collection, compare(compare_type::ne, "count"), unlimit, make_parameters(10)) == 99);
+    REQUIRE(execute_match<wildcard_index_scan>(collection, compare(compare_type::gt, "count"), unlimit, make_parameters(90)) == 10);
+    REQUIRE(execute_match<wildcard_index_scan>(collection, compare(compare_type::gte, "count"), unlimit, make_parameters(90)) == 11);
+    REQUIRE(execute_match<wildcard_index_scan>(collection, compare(compare_type::lt, "count"), unlimit, make_parameters(10)) == 9);
+    REQUIRE(execute_match<wildcard_index_scan>(collection, compare(compare_type::lte, "count"), unlimit, make_parameters(10)) == 10);
+    REQUIRE(execute_match<full_scan>(collection, compare(compare_type::eq, "dictArray.0.number"), unlimit, make_parameters(10)) == 1);
+    // the index stores the elements of countArray under its path while a predicate compares whole values,
+    // so a path holding arrays is left to a full scan
+    REQUIRE(execute_match<full_scan>(collection, compare(compare_type::eq, "countArray"), unlimit, make_parameters(10)) == 0);
+    REQUIRE(execute_full_scan(collection, compare(compare_type::eq, "countArray"), make_parameters(10)) == 0);
+    REQUIRE(execute_match<full_scan>(collection, compare(compare_type::eq, "countArray"), unlimit, make_parameters(make_array({10, 11, 12, 13, 14}))) == 1);
+    // an array sorts after every number
+    REQUIRE(execute_match<full_scan>(collection, compare(compare_type::gt, "countArray"), unlimit, make_parameters(10)) == 100);
+    REQUIRE(execute_match<full_scan>(collection, compare(compare_type::eq, "countArray.0"), unlimit, make_parameters(10)) == 1);
+    // countStr is excluded from the index, and its strings never equal a number
+    REQUIRE(execute_match<full_scan>(collection, compare(compare_type::eq, "countStr"), unlimit, make_parameters(10)) == 0);
+}
@@ -1,14 +1,17 @@
 #include "agent_disk.hpp"
+#include <algorithm>
+#include <thread>
 #include "manager_disk.hpp"
 #include "route.hpp"
 #include "result.hpp"
 
 namespace services::disk {
 
-    agent_disk_t::agent_disk_t(base_manager_disk_t* manager, const path_t& path_db, const name_t& name, log_t& log)
+    agent_disk_t::agent_disk_t(base_manager_disk_t* manager, disk_ptr disk, const configuration::config_disk& config, const name_t& name, log_t& log)
         : actor_zeta::basic_async_actor(manager, name)
         , log_(log.clone())
-        , disk_(path_db) {
+        , disk_(std::move(disk))
+        , load_threads_(config.load_threads == 0 ? std::max(std::thread::hardware_concurrency(), 1u) : config.load_threads) {
         trace(log_, "agent_disk::create");
         add_handler(handler_id(route::load), &agent_disk_t::load);
         add_handler(handler_id(route::append_database), &agent_disk_t::append_database);
@@ -17,6 +20,7 @@ namespace services::disk {
         add_handler(handler_id(route::remove_collection), &agent_disk_t::remove_collection);
         add_handler(handler_id(route::write_documents), &agent_disk_t::write_documents);
         add_handler(handler_id(route::remove_documents), &agent_disk_t::remove_documents);
+        add_handler(handler_id(route::flush), &agent_disk_t::flush);
         add_handler(handler_id(route::fix_wal_id), &agent_disk_t::fix_wal_id);
     }
 
@@ -26,65 +30,55 @@ namespace services::disk {
 
     auto agent_disk_t::load(session_id_t& session, actor_zeta::address_t dispatcher) -> void {
         trace(log_, "agent_disk::load , session : {}", session.data());
-        result_load_t result(disk_.databases(), disk_.wal_id());
-        for (auto &database : *result) {
-            database.set_collection(disk_.collections(database.name));
-            for (auto &collection : database.collections) {
-                auto id_documents = disk_.load_list_documents(database.name, collection.name);
-                for (const auto &id : id_documents) {
-                    collection.documents.push_back(disk_.load_document(id));
-                }
-            }
-        }
+        auto result = disk_->load(load_threads_);
+        trace(log_, "agent_disk::load , collections : {} , threads : {}", result.count_collections(), load_threads_);
         actor_zeta::send(dispatcher, address(), handler_id(route::load_finish), session, result);
     }
 
     auto agent_disk_t::append_database(const command_t& command) -> void {
         auto& cmd = command.get<command_append_database_t>();
         trace(log_, "agent_disk::append_database , database : {}", cmd.database);
-        disk_.append_database(cmd.database);
+        disk_->append_database(cmd.database);
     }
 
     auto agent_disk_t::remove_database(const command_t& command) -> void {
         auto& cmd = command.get<command_remove_database_t>();
         trace(log_, "agent_disk::remove_database , database : {}", cmd.database);
-        disk_.remove_database(cmd.database);
+        disk_->remove_database(cmd.database);
     }
 
     auto agent_disk_t::append_collection(const command_t& command) -> void {
         auto& cmd = command.get<command_append_collection_t>();
         trace(log_, "agent_disk::append_collection , database : {} , collection : {}", cmd.database, cmd.collection);
-        disk_.append_collection(cmd.database, cmd.collection);
+        disk_->append_collection(cmd.database, cmd.collection);
     }
 
     auto agent_disk_t::remove_collection(const command_t& command) -> void {
         auto& cmd = command.get<command_remove_collection_t>();
         trace(log_, "agent_disk::remove_collection , database : {} , collection : {}", cmd.database, cmd.collection);
-        disk_.remove_collection(cmd.database, cmd.collection);
+        disk_->remove_collection(cmd.database, cmd.collection);
     }
 
     auto agent_disk_t::write_documents(const command_t& command) -> void {
         auto& write_command = command.get<command_write_documents_t>();
-        trace(log_, "agent_disk::write_documents , database : {} , collection : {} , {} documents", write_command.database, write_command.collection, write_command.documents.size());
-        for (const auto& document : write_command.documents) {
-            auto id = components::document::get_document_id(document);
-            if (!id.is_null()) {
-                disk_.save_document(write_command.database, write_command.collection, id, document);
-            }
-        }
+        trace(log_, "agent_disk::write_documents , database : {} , collection : {} , {} documents", write_command.database, write_command.collection, write_command.documents->size());
+        disk_->save_documents(write_command.database, write_command.collection, *write_command.documents, write_command.wal_id);
     }
 
     auto agent_disk_t::remove_documents(const command_t& command) -> void {
         auto& remove_command = command.get<command_remove_documents_t>();
         trace(log_, "agent_disk::remove_documents , database : {} , collection : {} , {} documents", remove_command.database, remove_command.collection, remove_command.documents.size());
-        for (const auto& id : remove_command.documents) {
-            disk_.remove_document(remove_command.database, remove_command.collection, id);
-        }
+        disk_->remove_documents(remove_command.database, remove_command.collection, remove_command.documents, remove_command.wal_id);
+    }
+
+    auto agent_disk_t::flush(std::uint64_t flush_id) -> void {
+        actor_zeta::send(current_message()->sender(), address(), handler_id(route::flush_finish), flush_id);
     }
 
     auto agent_disk_t::fix_wal_id(wal::id_t wal_id) -> void {
         trace(log_, "agent_disk::fix_wal_id : {}", wal_id);
-        disk_.fix_wal_id(wal_id);
+        disk_->fix_wal_id(wal_id);
+        actor_zeta::send(current_message()->sender(), address(), handler_id(route::fix_wal_id_finish), disk_->wal_id());
     }
 
 } //namespace services::disk
\ No newline at end of file
@@ -17,7 +17,7 @@ namespace services::disk {
 
     class agent_disk_t final : public actor_zeta::basic_async_actor {
     public:
-        agent_disk_t(base_manager_disk_t*, const path_t& path_db, const name_t& name, log_t& log);
+        agent_disk_t(base_manager_disk_t*, disk_ptr disk, const configuration::config_disk& config, const name_t& name, log_t& log);
         ~agent_disk_t();
 
         auto load(session_id_t& session, actor_zeta::address_t dispatcher) -> void;
@@ -31,11 +31,13 @@ namespace services::disk {
         auto write_documents(const command_t& command) -> void;
         auto remove_documents(const command_t& command) -> void;
 
+        auto flush(std::uint64_t flush_id) -> void;
         auto fix_wal_id(wal::id_t wal_id) -> void;
 
     private:
         log_t log_;
-        disk_t disk_;
+        disk_ptr disk_;
+        std::size_t load_threads_;
     };
 
     using agent_disk_ptr = std::unique_ptr<agent_disk_t>;
@@ -26,6 +26,20 @@ namespace services::disk {
         }, command_);
     }
 
+    command_t with_wal_id(const command_t &command, wal::id_t wal_id) {
+        if (command.name() == handler_id(route::write_documents)) {
+            auto write_command = command.get<command_write_documents_t>();
+            write_command.wal_id = wal_id;
+            return command_t(write_command);
+        }
+        if (command.name() == handler_id(route::remove_documents)) {
+            auto remove_command = command.get<command_remove_documents_t>();
+            remove_command.wal_id = wal_id;
+            return command_t(remove_command);
+        }
+        return command;
+    }
+
     void append_command(command_storage_t &storage, const components::session::session_id_t &session, const command_t &command) {
         auto it = storage.find(session);
         if (it != storage.end()) {
@@ -4,8 +4,10 @@
 #include <memory_resource>
 #include <actor-zeta.hpp>
 #include <components/document/document.hpp>
+#include <components/document/msgpack/packed_documents.hpp>
 #include <components/ql/ql_statement.hpp>
 #include <components/session/session.hpp>
+#include <services/wal/base.hpp>
 
 namespace services::disk {
 
@@ -30,13 +32,15 @@ namespace services::disk {
     struct command_write_documents_t {
         database_name_t database;
         collection_name_t collection;
-        std::pmr::vector<components::document::document_ptr> documents;
+        components::document::packed_documents_ptr documents;
+        wal::id_t wal_id {0};
     };
 
     struct command_remove_documents_t {
         database_name_t database;
         collection_name_t collection;
         std::pmr::vector<components::document::document_id_t> documents;
+        wal::id_t wal_id {0};
     };
 
     struct command_drop_index_t {
@@ -72,6 +76,9 @@ namespace services::disk {
 
     using command_storage_t = std::unordered_map<components::session::session_id_t, std::vector<command_t>>;
 
+    // the command with the id of the wal record it applies, for the commands that write documents
+    command_t with_wal_id(const command_t &command, wal::id_t wal_id);
+
     void append_command(command_storage_t &storage, const components::session::session_id_t &session, const command_t &command);
 
 } //namespace services::disk
\ No newline at end of file
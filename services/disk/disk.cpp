@@ -1,11 +1,18 @@
 #include "disk.hpp"
+#include <algorithm>
+#include <iterator>
+#include <atomic>
+#include <thread>
 #include <rocksdb/db.h>
+#include <rocksdb/metadata.h>
+#include <rocksdb/write_batch.h>
 #include <components/document/msgpack/msgpack_encoder.hpp>
 #include "metadata.hpp"
 
 namespace services::disk {
 
     constexpr static std::string_view key_separator = "::";
+    constexpr static std::size_t checkpoint_size = 64 << 20;
 
     std::string gen_key(const std::string &key, std::string_view sub_key) {
         std::string tmp ;
@@ -19,16 +26,22 @@ namespace services::disk {
         return gen_key(gen_key(database, collection), id.to_string());
     }
 
+    // the id of the last wal record applied to the documents of a collection, outside of every document prefix
+    std::string gen_wal_id_key(const database_name_t &database, const collection_name_t &collection) {
+        return gen_key("\x01" "wal_id", gen_key(database, collection));
+    }
+
     std::string_view to_string_view(const msgpack::sbuffer &buffer) {
         return std::string_view(buffer.data(), buffer.size());
     }
 
 
-    disk_t::disk_t(const path_t& file_name)
+    disk_t::disk_t(const path_t& file_name, bool rocksdb_wal)
         : path_(file_name)
         , db_(nullptr)
         , metadata_(nullptr)
-        , file_wal_id_(nullptr) {
+        , file_wal_id_(nullptr)
+        , rocksdb_wal_(rocksdb_wal) {
         rocksdb::Options options;
         //options.IncreaseParallelism();
         options.OptimizeLevelStyleCompaction();
@@ -39,17 +52,39 @@ namespace services::disk {
             db_.reset(db);
             metadata_ = metadata_t::open(file_name / "METADATA");
             file_wal_id_ = std::make_unique<core::file::file_t>(file_name / "WAL_ID");
+            wal_id_ = wal::id_from_string(file_wal_id_->readall());
         } else {
             throw std::runtime_error("db open failed");
         }
     }
 
-    disk_t::~disk_t() = default;
+    disk_t::~disk_t() {
+        if (pending_wal_id_ > wal_id_) {
+            db_->Flush(rocksdb::FlushOptions());
+            write_wal_id_(pending_wal_id_);
+        }
+    }
 
     void disk_t::save_document(const database_name_t &database, const collection_name_t &collection, const document_id_t& id, const document_ptr &document) {
+        rocksdb::WriteBatch batch;
         msgpack::sbuffer sbuf;
         msgpack::pack(sbuf, document);
-        db_->Put(rocksdb::WriteOptions(), gen_key(database, collection, id), to_string_view(sbuf));
+        batch.Put(gen_key(database, collection, id), to_string_view(sbuf));
+        write_(batch);
+    }
+
+    void disk_t::save_documents(const database_name_t &database, const collection_name_t &collection, const std::pmr::vector<document_ptr> &documents, wal::id_t wal_id) {
+        save_documents(database, collection, components::document::packed_documents_t(documents), wal_id);
+    }
+
+    void disk_t::save_documents(const database_name_t &database, const collection_name_t &collection, const components::document::packed_documents_t &documents, wal::id_t wal_id) {
+        rocksdb::WriteBatch batch;
+        for (std::size_t i = 0; i < documents.size(); ++i) {
+            if (!documents.id(i).is_null()) {
+                batch.Put(gen_key(database, collection, documents.id(i)), documents.document(i));
+            }
+        }
+        write_(batch, database, collection, wal_id);
     }
 
     document_ptr disk_t::load_document(const rocks_id& id_rocks) const {
@@ -69,7 +104,41 @@ namespace services::disk {
     }
 
     void disk_t::remove_document(const database_name_t &database, const collection_name_t &collection, const document_id_t &id) {
-        db_->Delete(rocksdb::WriteOptions(), gen_key(database, collection, id));
+        rocksdb::WriteBatch batch;
+        batch.Delete(gen_key(database, collection, id));
+        write_(batch);
+    }
+
+    void disk_t::remove_documents(const database_name_t &database, const collection_name_t &collection, const std::pmr::vector<document_id_t> &ids, wal::id_t wal_id) {
+        rocksdb::WriteBatch batch;
+        for (const auto &id : ids) {
+            batch.Delete(gen_key(database, collection, id));
+        }
+        write_(batch, database, collection, wal_id);
+    }
+
+    wal::id_t disk_t::collection_wal_id(const database_name_t &database, const collection_name_t &collection) const {
+        std::string value;
+        auto status = db_->Get(rocksdb::ReadOptions(), gen_wal_id_key(database, collection), &value);
+        return status.ok() ? wal::id_from_string(value) : 0;
+    }
+
+    void disk_t::write_(rocksdb::WriteBatch &batch) {
+        if (batch.Count() == 0) {
+            return;
+        }
+        rocksdb::WriteOptions options;
+        options.disableWAL = !rocksdb_wal_;
+        db_->Write(options, &batch);
+        unflushed_size_ += batch.GetDataSize();
+    }
+
+    void disk_t::write_(rocksdb::WriteBatch &batch, const database_name_t &database, const collection_name_t &collection, wal::id_t wal_id) {
+        // the wal id goes in the same batch as the documents, so whatever survives a crash knows which records it holds
+        if (batch.Count() > 0 && wal_id > 0) {
+            batch.Put(gen_wal_id_key(database, collection), std::to_string(wal_id));
+        }
+        write_(batch);
     }
 
     std::vector<rocks_id> disk_t::load_list_documents(const database_name_t &database, const collection_name_t &collection) const {
@@ -84,6 +153,116 @@ namespace services::disk {
         return id_documents;
     }
 
+    void disk_t::load_documents(const database_name_t &database, const collection_name_t &collection, std::pmr::vector<document_ptr> &documents) const {
+        auto find_key = gen_key(database, collection);
+        find_key.append(key_separator);
+        auto upper_key = find_key;
+        ++upper_key.back();
+        load_range_(find_key, upper_key, documents);
+    }
+
+    void disk_t::load_range_(const std::string &lower_key, const std::string &upper_key, std::pmr::vector<document_ptr> &documents) const {
+        rocksdb::Slice upper_bound(upper_key);
+        rocksdb::ReadOptions options;
+        options.iterate_upper_bound = &upper_bound;
+        options.fill_cache = false;
+        std::unique_ptr<rocksdb::Iterator> it(db_->NewIterator(options));
+        for (it->Seek(lower_key); it->Valid(); it->Next()) {
+            msgpack::unpacked msg;
+            msgpack::unpack(msg, it->value().data(), it->value().size());
+            documents.push_back(msg.get().as<document_ptr>());
+        }
+    }
+
+    std::vector<std::string> disk_t::split_keys_(const std::string &lower_key, const std::string &upper_key, std::size_t count) const {
+        // the bounds of the table files are a free sample of the keys on disk
+        std::vector<rocksdb::LiveFileMetaData> files;
+        db_->GetLiveFilesMetaData(&files);
+        std::vector<std::string> keys;
+        for (const auto &file : files) {
+            for (const auto *key : {&file.smallestkey, &file.largestkey}) {
+                if (*key > lower_key && *key < upper_key) {
+                    keys.push_back(*key);
+                }
+            }
+        }
+        std::sort(keys.begin(), keys.end());
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+        if (count == 0 || keys.size() < count) {
+            return keys;
+        }
+        std::vector<std::string> splits;
+        splits.reserve(count - 1);
+        for (std::size_t i = 1; i < count; ++i) {
+            splits.push_back(std::move(keys[i * keys.size() / count]));
+        }
+        return splits;
+    }
+
+    result_load_t disk_t::load(std::size_t count_threads) const {
+        result_load_t result(databases(), wal_id());
+        count_threads = std::max(count_threads, std::size_t(1));
+        struct range_t {
+            std::string lower_key;
+            std::string upper_key;
+            std::pmr::vector<document_ptr> documents;
+        };
+        // every collection is split into key ranges at sampled keys, so one large collection is read
+        // by several workers; a worker takes the next unread range
+        std::vector<std::pair<result_collection_t*, std::vector<range_t>>> loads;
+        std::vector<range_t*> tasks;
+        for (auto &database : *result) {
+            database.set_collection(collections(database.name));
+            for (auto &collection : database.collections) {
+                collection.wal_id = collection_wal_id(database.name, collection.name);
+                auto find_key = gen_key(database.name, collection.name);
+                find_key.append(key_separator);
+                auto upper_key = find_key;
+                ++upper_key.back();
+                std::vector<range_t> ranges;
+                auto lower_key = find_key;
+                for (auto &split_key : split_keys_(find_key, upper_key, count_threads)) {
+                    ranges.push_back({std::move(lower_key), split_key, std::pmr::vector<document_ptr>(collection.documents.get_allocator())});
+                    lower_key = std::move(split_key);
+                }
+                ranges.push_back({std::move(lower_key), std::move(upper_key), std::pmr::vector<document_ptr>(collection.documents.get_allocator())});
+                loads.emplace_back(&collection, std::move(ranges));
+            }
+        }
+        for (auto &load : loads) {
+            for (auto &range : load.second) {
+                tasks.push_back(&range);
+            }
+        }
+        std::atomic<std::size_t> next{0};
+        auto worker = [&]() {
+            for (auto i = next++; i < tasks.size(); i = next++) {
+                load_range_(tasks[i]->lower_key, tasks[i]->upper_key, tasks[i]->documents);
+            }
+        };
+        count_threads = std::min(count_threads, std::max(tasks.size(), std::size_t(1)));
+        std::vector<std::thread> threads;
+        threads.reserve(count_threads - 1);
+        for (std::size_t i = 1; i < count_threads; ++i) {
+            threads.emplace_back(worker);
+        }
+        worker();
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        for (auto &[collection, ranges] : loads) {
+            std::size_t size = 0;
+            for (const auto &range : ranges) {
+                size += range.documents.size();
+            }
+            collection->documents.reserve(size);
+            for (auto &range : ranges) {
+                std::move(range.documents.begin(), range.documents.end(), std::back_inserter(collection->documents));
+            }
+        }
+        return result;
+    }
+
     std::vector<database_name_t> disk_t::databases() const {
         return metadata_->databases();
     }
@@ -106,17 +285,35 @@ namespace services::disk {
 
     bool disk_t::remove_collection(const database_name_t &database, const collection_name_t &collection) {
         std::filesystem::remove_all(path_ / "indexes" / collection);
+        rocksdb::WriteBatch batch;
+        batch.Delete(gen_wal_id_key(database, collection));
+        write_(batch);
         //todo: removed all documents
         return metadata_->remove_collection(database, collection);
     }
 
     void disk_t::fix_wal_id(wal::id_t wal_id) {
-        auto id = std::to_string(wal_id);
-        file_wal_id_->rewrite(id);
+        if (!rocksdb_wal_) {
+            // without the rocksdb wal the documents are durable only after a memtable flush,
+            // so the checkpoint lags until there is enough unflushed data to make a flush worth it
+            pending_wal_id_ = wal_id;
+            if (unflushed_size_ < checkpoint_size) {
+                return;
+            }
+            db_->Flush(rocksdb::FlushOptions());
+        }
+        write_wal_id_(wal_id);
     }
 
     wal::id_t disk_t::wal_id() const {
-        return wal::id_from_string(file_wal_id_->readall());
+        return wal_id_;
+    }
+
+    void disk_t::write_wal_id_(wal::id_t wal_id) {
+        auto id = std::to_string(wal_id);
+        file_wal_id_->rewrite(id);
+        wal_id_ = wal_id;
+        unflushed_size_ = 0;
     }
 
 } //namespace services::disk
\ No newline at end of file
@@ -1,14 +1,18 @@
 #pragma once
 #include <components/document/document.hpp>
 #include <components/document/document_id.hpp>
+#include <components/document/msgpack/packed_documents.hpp>
 #include <components/ql/ql_statement.hpp>
 
 #include <core/file/file.hpp>
+#include <atomic>
 #include <filesystem>
 #include <wal/base.hpp>
+#include "result.hpp"
 
 namespace rocksdb {
     class DB;
+    class WriteBatch;
 }
 
 namespace services::disk {
@@ -25,16 +29,22 @@ namespace services::disk {
 
     class disk_t {
     public:
-        explicit disk_t(const path_t &file_name);
+        explicit disk_t(const path_t &file_name, bool rocksdb_wal = true);
         disk_t(const disk_t &) = delete;
         disk_t &operator=(disk_t const&) = delete;
         ~disk_t();
 
         void save_document(const database_name_t &database, const collection_name_t &collection, const document_id_t &id, const document_ptr &document);
+        void save_documents(const database_name_t &database, const collection_name_t &collection, const std::pmr::vector<document_ptr> &documents, wal::id_t wal_id = 0);
+        void save_documents(const database_name_t &database, const collection_name_t &collection, const components::document::packed_documents_t &documents, wal::id_t wal_id = 0);
         [[nodiscard]] document_ptr load_document(const rocks_id& id_rocks) const;
         [[nodiscard]] document_ptr load_document(const database_name_t &database, const collection_name_t &collection, const document_id_t& id) const;
         void remove_document(const database_name_t &database, const collection_name_t &collection, const document_id_t &id);
+        void remove_documents(const database_name_t &database, const collection_name_t &collection, const std::pmr::vector<document_id_t> &ids, wal::id_t wal_id = 0);
+        [[nodiscard]] wal::id_t collection_wal_id(const database_name_t &database, const collection_name_t &collection) const;
         [[nodiscard]] std::vector<rocks_id> load_list_documents(const database_name_t &database, const collection_name_t &collection) const;
+        void load_documents(const database_name_t &database, const collection_name_t &collection, std::pmr::vector<document_ptr> &documents) const;
+        [[nodiscard]] result_load_t load(std::size_t count_threads) const;
 
         [[nodiscard]] std::vector<database_name_t> databases() const;
         bool append_database(const database_name_t &database);
@@ -48,10 +58,22 @@ namespace services::disk {
         wal::id_t wal_id() const;
 
     private:
+        void write_(rocksdb::WriteBatch &batch);
+        void write_(rocksdb::WriteBatch &batch, const database_name_t &database, const collection_name_t &collection, wal::id_t wal_id);
+        void write_wal_id_(wal::id_t wal_id);
+        void load_range_(const std::string &lower_key, const std::string &upper_key, std::pmr::vector<document_ptr> &documents) const;
+        std::vector<std::string> split_keys_(const std::string &lower_key, const std::string &upper_key, std::size_t count) const;
+
         path_t path_;
         db_ptr db_;
         metadata_ptr metadata_;
         file_ptr file_wal_id_;
+        bool rocksdb_wal_;
+        wal::id_t wal_id_ {0};
+        wal::id_t pending_wal_id_ {0};
+        std::atomic<std::size_t> unflushed_size_ {0};
     };
 
+    using disk_ptr = std::shared_ptr<disk_t>;
+
 } //namespace services::disk
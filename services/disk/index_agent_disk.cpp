@@ -5,6 +5,8 @@
 
 namespace services::disk {
 
+    constexpr std::size_t find_chunk_size = 1024;
+
     index_agent_disk_t::index_agent_disk_t(base_manager_disk_t* manager,
                                            actor_zeta::detail::pmr::memory_resource* resource,
                                            const path_t& path_db,
@@ -18,8 +20,7 @@ namespace services::disk {
         , index_disk_(std::make_unique<index_disk_t>(path_db / "indexes" / collection_name / index_name, compare_type))
         , collection_name_(collection_name) {
         trace(log_, "index_agent_disk::create {}", index_name);
-        add_handler(handler_id(index::route::insert), &index_agent_disk_t::insert);
-        add_handler(handler_id(index::route::remove), &index_agent_disk_t::remove);
+        add_handler(handler_id(index::route::batch), &index_agent_disk_t::batch);
         add_handler(handler_id(index::route::find), &index_agent_disk_t::find);
         add_handler(handler_id(index::route::drop), &index_agent_disk_t::drop);
     }
@@ -43,49 +44,23 @@ namespace services::disk {
         return is_dropped_;
     }
 
-    void index_agent_disk_t::insert(session_id_t& session, const wrapper_value_t& key, const document_id_t& value) {
-        trace(log_, "index_agent_disk_t::insert {}, session: {}", value.to_string(), session.data());
-        index_disk_->insert(key, value);
-        actor_zeta::send(current_message()->sender(), address(), index::handler_id(index::route::success), session);
+    bool index_agent_disk_t::is_new() const {
+        return index_disk_->is_new();
     }
 
-    void index_agent_disk_t::remove(session_id_t& session, const wrapper_value_t& key, const document_id_t& value) {
-        trace(log_, "index_agent_disk_t::remove {}, session: {}", value.to_string(), session.data());
-        index_disk_->remove(key, value);
+    void index_agent_disk_t::batch(session_id_t& session, const batch_t& batch) {
+        trace(log_, "index_agent_disk_t::batch {}, session: {}", batch.size(), session.data());
+        index_disk_->apply(batch);
         actor_zeta::send(current_message()->sender(), address(), index::handler_id(index::route::success), session);
     }
 
-    void index_agent_disk_t::find(session_id_t& session, const wrapper_value_t& value, components::expressions::compare_type compare) {
-        using components::expressions::compare_type;
-
+    // ids go back in chunks as the scan reads them, the collection resumes the plan on the last one
+    void index_agent_disk_t::find(session_id_t& session, const key_t& value, components::expressions::compare_type compare, std::size_t limit) {
         trace(log_, "index_agent_disk_t::find, session: {}", session.data());
-        index_disk_t::result res{resource_};
-        switch (compare) {
-            case compare_type::eq:
-                index_disk_->find(value, res);
-                break;
-            case compare_type::ne:
-                index_disk_->lower_bound(value, res);
-                index_disk_->upper_bound(value, res);
-                break;
-            case compare_type::gt:
-                index_disk_->upper_bound(value, res);
-                break;
-            case compare_type::lt:
-                index_disk_->lower_bound(value, res);
-                break;
-            case compare_type::gte:
-                index_disk_->find(value, res);
-                index_disk_->upper_bound(value, res);
-                break;
-            case compare_type::lte:
-                index_disk_->lower_bound(value, res);
-                index_disk_->find(value, res);
-                break;
-            default:
-                break;
-        }
-        actor_zeta::send(current_message()->sender(), address(), index::handler_id(index::route::success_find), session, res);
+        auto sender = current_message()->sender();
+        index_disk_->find(value, compare, limit, find_chunk_size, [&](const index_disk_t::result& chunk, bool is_last) {
+            actor_zeta::send(sender, address(), index::handler_id(index::route::success_find), session, index_disk_t::result(chunk, resource_), is_last);
+        });
     }
 
 } //namespace services::disk
\ No newline at end of file
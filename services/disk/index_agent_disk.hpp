@@ -20,7 +20,8 @@ namespace services::disk {
         using path_t = std::filesystem::path;
         using session_id_t = ::components::session::session_id_t;
         using document_id_t = components::document::document_id_t;
-        using wrapper_value_t = document::wrapper_value_t;
+        using key_t = index_disk_t::key_t;
+        using batch_t = index_disk_t::batch_t;
 
     public:
         index_agent_disk_t(base_manager_disk_t*, actor_zeta::detail::pmr::memory_resource* resource,
@@ -31,10 +32,10 @@ namespace services::disk {
 
         void drop(session_id_t& session);
         bool is_dropped() const;
+        bool is_new() const;
 
-        void insert(session_id_t& session, const wrapper_value_t& key, const document_id_t& value);
-        void remove(session_id_t& session, const wrapper_value_t& key, const document_id_t& value);
-        void find(session_id_t& session, const wrapper_value_t& value, components::expressions::compare_type compare);
+        void batch(session_id_t& session, const batch_t& batch);
+        void find(session_id_t& session, const key_t& value, components::expressions::compare_type compare, std::size_t limit);
 
     private:
         actor_zeta::detail::pmr::memory_resource* resource_;
@@ -1,124 +1,18 @@
 #include "index_disk.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <set>
 #include <rocksdb/db.h>
+#include <rocksdb/write_batch.h>
+#include <components/document/core/array.hpp>
+#include <components/index/disk/key_encoding.hpp>
 
 namespace services::disk {
 
-    class base_comparator : public rocksdb::Comparator {
-    public:
-        virtual rocksdb::Slice slice(const document::wrapper_value_t& value) const = 0;
-    };
-
-    template<class T>
-    class comparator final : public base_comparator {
-    public:
-        comparator() = default;
-
-    private:
-        int Compare(const rocksdb::Slice& a, const rocksdb::Slice& b) const final {
-            return a.compare(b);
-        }
-
-        rocksdb::Slice slice(const T& value) const {
-            return rocksdb::Slice{reinterpret_cast<const char*>(&value), sizeof(T)};
-        }
-
-        rocksdb::Slice slice(const document::wrapper_value_t& value) const final {
-            return rocksdb::Slice{value->as_string()};
-        }
-
-        const char* Name() const final {
-            return "comparator";
-        }
-
-        void FindShortestSeparator(std::string*, const rocksdb::Slice&) const final {}
-
-        void FindShortSuccessor(std::string*) const final {}
-    };
-
-    template<>
-    rocksdb::Slice comparator<std::string>::slice(const document::wrapper_value_t& value) const {
-        return rocksdb::Slice{value->as_string()};
-    }
-
-    template<>
-    int comparator<std::string>::Compare(const rocksdb::Slice& a, const rocksdb::Slice& b) const {
-        if (a.empty() && b.empty()) return 0;
-        if (!a.data()) return -1;
-        if (!b.data()) return 1;
-        return a.compare(b);
-    }
-
-    template<>
-    int comparator<double>::Compare(const rocksdb::Slice& a, const rocksdb::Slice& b) const {
-        auto a_ = *reinterpret_cast<const double*>(a.data());
-        auto b_ = *reinterpret_cast<const double*>(b.data());
-        if (a_ < b_)
-            return -1;
-        if (a_ > b_)
-            return 1;
-        return 0;
-    }
-
-    template<>
-    int comparator<float>::Compare(const rocksdb::Slice& a, const rocksdb::Slice& b) const {
-        auto a_ = *reinterpret_cast<const float*>(a.data());
-        auto b_ = *reinterpret_cast<const float*>(b.data());
-        if (a_ < b_)
-            return -1;
-        if (a_ > b_)
-            return 1;
-        return 0;
-    }
-
-#define ADD_TYPE_SLICE(TYPE, FUNC)                                                         \
-    template<>                                                                             \
-    rocksdb::Slice comparator<TYPE>::slice(const document::wrapper_value_t& value) const { \
-        static TYPE v;                                                                     \
-        v = TYPE(value->FUNC());                                                           \
-        return slice(v);                                                                   \
-    }
-
-    ADD_TYPE_SLICE(int8_t, as_int)
-    ADD_TYPE_SLICE(int16_t, as_int)
-    ADD_TYPE_SLICE(int32_t, as_int)
-    ADD_TYPE_SLICE(int64_t, as_int)
-    ADD_TYPE_SLICE(uint8_t, as_unsigned)
-    ADD_TYPE_SLICE(uint16_t, as_unsigned)
-    ADD_TYPE_SLICE(uint32_t, as_unsigned)
-    ADD_TYPE_SLICE(uint64_t, as_unsigned)
-    ADD_TYPE_SLICE(float, as_float)
-    ADD_TYPE_SLICE(double, as_double)
-    ADD_TYPE_SLICE(bool, as_bool)
-
-    std::unique_ptr<base_comparator> make_comparator(components::ql::index_compare compare_type) {
-        switch (compare_type) {
-            case components::ql::index_compare::str:
-                return std::make_unique<comparator<std::string>>();
-            case components::ql::index_compare::int8:
-                return std::make_unique<comparator<int8_t>>();
-            case components::ql::index_compare::int16:
-                return std::make_unique<comparator<int16_t>>();
-            case components::ql::index_compare::int32:
-                return std::make_unique<comparator<int32_t>>();
-            case components::ql::index_compare::int64:
-                return std::make_unique<comparator<int64_t>>();
-            case components::ql::index_compare::uint8:
-                return std::make_unique<comparator<uint8_t>>();
-            case components::ql::index_compare::uint16:
-                return std::make_unique<comparator<uint16_t>>();
-            case components::ql::index_compare::uint32:
-                return std::make_unique<comparator<uint32_t>>();
-            case components::ql::index_compare::uint64:
-                return std::make_unique<comparator<uint64_t>>();
-            case components::ql::index_compare::float32:
-                return std::make_unique<comparator<float>>();
-            case components::ql::index_compare::float64:
-                return std::make_unique<comparator<double>>();
-            case components::ql::index_compare::bool8:
-                return std::make_unique<comparator<bool>>();
-        }
-        return std::make_unique<comparator<std::string>>();
-    }
+    using services::index::prefix_successor;
 
     rocksdb::Slice to_slice(const index_disk_t::result& values) {
         return rocksdb::Slice{reinterpret_cast<const char*>(values.data()), values.size() * components::document::document_id_t::size};
@@ -130,58 +24,117 @@ namespace services::disk {
         std::memcpy(docs.data() + size, slice.data(), slice.size());
     }
 
-    index_disk_t::index_disk_t(const path_t& path, components::ql::index_compare compare_type)
-        : path_(path)
-        , db_(nullptr)
-        , comparator_(make_comparator(compare_type)) {
+    // the keys below the least byte of an encoded key hold the metadata of the index
+    const std::string format_key{"\x01" "format"};
+    const std::string format_version{"1"};
+    const std::string first_value_key(1, services::index::least_key_byte);
+
+    rocksdb::Options make_options() {
         rocksdb::Options options;
         options.OptimizeLevelStyleCompaction();
         options.create_if_missing = true;
-        options.comparator = comparator_.get();
-        rocksdb::DB* db;
+        return options;
+    }
+
+    index_disk_t::index_disk_t(const path_t& path, components::ql::index_compare compare_type)
+        : path_(path)
+        , db_(nullptr)
+        , compare_type_(compare_type) {
         if (!std::filesystem::is_directory(path)) {
             std::filesystem::create_directories(path);
         }
-        auto status = rocksdb::DB::Open(options, path.string(), &db);
-        if (status.ok()) {
-            db_.reset(db);
-        } else {
+        auto status = open_();
+        if (status.IsInvalidArgument()) {
+            // a directory written with the former custom comparator can't be opened in the bytewise order
+            status = recreate_();
+        }
+        if (!status.ok()) {
             throw std::runtime_error("db open failed");
         }
+        std::string version;
+        if (!db_->Get(rocksdb::ReadOptions(), format_key, &version).ok() || version != format_version) {
+            // keys of an unknown layout can't be read, they are dropped and the collection fills the index again
+            std::unique_ptr<rocksdb::Iterator> it(db_->NewIterator(rocksdb::ReadOptions()));
+            it->SeekToFirst();
+            if (it->Valid()) {
+                it.reset();
+                if (!recreate_().ok()) {
+                    throw std::runtime_error("db open failed");
+                }
+            }
+            db_->Put(rocksdb::WriteOptions(), format_key, format_version);
+            is_new_ = true;
+        }
     }
 
     index_disk_t::~index_disk_t() = default;
 
+    std::string index_disk_t::encode(const wrapper_value_t& value) const {
+        return services::index::encode_key(value, compare_type_);
+    }
+
+    std::string index_disk_t::encode(const key_t& key) const {
+        return services::index::encode_key(key, compare_type_);
+    }
+
     void index_disk_t::insert(const wrapper_value_t& key, const document_id_t& value) {
-        auto values = find(key);
-        if (std::find(values.begin(), values.end(), value) == values.end()) {
-            values.push_back(value);
-            db_->Put(rocksdb::WriteOptions(), comparator_->slice(key), to_slice(values));
-        }
+        insert_(encode(key), value);
+    }
+
+    void index_disk_t::insert(const key_t& key, const document_id_t& value) {
+        insert_(encode(key), value);
     }
 
     void index_disk_t::remove(wrapper_value_t key) {
-        db_->Delete(rocksdb::WriteOptions(), comparator_->slice(key));
+        remove_(encode(key));
+    }
+
+    void index_disk_t::remove(const key_t& key) {
+        remove_(encode(key));
     }
 
     void index_disk_t::remove(const wrapper_value_t& key, const document_id_t& doc) {
-        auto values = find(key);
-        if (!values.empty()) {
-            values.erase(std::remove(values.begin(), values.end(), doc), values.end());
-            if (values.empty()) {
-                remove(key);
+        remove_(encode(key), doc);
+    }
+
+    void index_disk_t::remove(const key_t& key, const document_id_t& doc) {
+        remove_(encode(key), doc);
+    }
+
+    void index_disk_t::apply(const batch_t& batch) {
+        // every key the batch touches is read once and written back once
+        std::map<std::string, result> values;
+        for (const auto& delta : batch) {
+            auto it = values.find(delta.key);
+            if (it == values.end()) {
+                it = values.emplace(delta.key, get_(delta.key)).first;
+            }
+            auto& ids = it->second;
+            if (delta.type == services::index::delta_type::insert) {
+                if (std::find(ids.begin(), ids.end(), delta.id) == ids.end()) {
+                    ids.push_back(delta.id);
+                }
+            } else {
+                ids.erase(std::remove(ids.begin(), ids.end(), delta.id), ids.end());
+            }
+        }
+        rocksdb::WriteBatch write_batch;
+        for (const auto& [key, ids] : values) {
+            if (ids.empty()) {
+                write_batch.Delete(key);
             } else {
-                db_->Put(rocksdb::WriteOptions(), comparator_->slice(key), to_slice(values));
+                write_batch.Put(key, to_slice(ids));
             }
         }
+        db_->Write(rocksdb::WriteOptions(), &write_batch);
     }
 
     void index_disk_t::find(const wrapper_value_t& value, result &res) const {
-        rocksdb::PinnableSlice slice;
-        auto status = db_->Get(rocksdb::ReadOptions(), db_->DefaultColumnFamily(), comparator_->slice(value), &slice);
-        if (!status.IsNotFound()) {
-            from_slice(slice, res);
-        }
+        find_(encode(value), res);
+    }
+
+    void index_disk_t::find(const key_t& value, result &res) const {
+        find_(encode(value), res);
     }
 
     index_disk_t::result index_disk_t::find(const wrapper_value_t& value) const {
@@ -190,15 +143,18 @@ namespace services::disk {
         return res;
     }
 
+    index_disk_t::result index_disk_t::find(const key_t& value) const {
+        index_disk_t::result res;
+        find(value, res);
+        return res;
+    }
+
     void index_disk_t::lower_bound(const wrapper_value_t& value, result &res) const {
-        rocksdb::ReadOptions options;
-        auto upper_bound = comparator_->slice(value);
-        options.iterate_upper_bound = &upper_bound;
-        rocksdb::Iterator* it = db_->NewIterator(options);
-        for (it->SeekToFirst(); it->Valid(); it->Next()) {
-            from_slice(it->value(), res);
-        }
-        delete it;
+        lower_bound_(encode(value), res);
+    }
+
+    void index_disk_t::lower_bound(const key_t& value, result &res) const {
+        lower_bound_(encode(value), res);
     }
 
     index_disk_t::result index_disk_t::lower_bound(const wrapper_value_t& value) const {
@@ -207,19 +163,18 @@ namespace services::disk {
         return res;
     }
 
+    index_disk_t::result index_disk_t::lower_bound(const key_t& value) const {
+        index_disk_t::result res;
+        lower_bound(value, res);
+        return res;
+    }
+
     void index_disk_t::upper_bound(const wrapper_value_t& value, result &res) const {
-        rocksdb::ReadOptions options;
-        auto lower_bound = comparator_->slice(value);
-        options.iterate_lower_bound = &lower_bound;
-        rocksdb::Iterator* it = db_->NewIterator(options);
-        it->SeekToFirst();
-        if (it->key() == lower_bound) {
-            it->Next();
-        }
-        for (; it->Valid(); it->Next()) {
-            from_slice(it->value(), res);
-        }
-        delete it;
+        upper_bound_(encode(value), res);
+    }
+
+    void index_disk_t::upper_bound(const key_t& value, result &res) const {
+        upper_bound_(encode(value), res);
     }
 
     index_disk_t::result index_disk_t::upper_bound(const wrapper_value_t& value) const {
@@ -228,9 +183,208 @@ namespace services::disk {
         return res;
     }
 
+    index_disk_t::result index_disk_t::upper_bound(const key_t& value) const {
+        index_disk_t::result res;
+        upper_bound(value, res);
+        return res;
+    }
+
+    bool index_disk_t::is_new() const noexcept {
+        return is_new_;
+    }
+
     void index_disk_t::drop() {
         db_.release();
         std::filesystem::remove_all(path_);
     }
 
+    rocksdb::Status index_disk_t::open_() {
+        rocksdb::DB* db;
+        auto status = rocksdb::DB::Open(make_options(), path_.string(), &db);
+        if (status.ok()) {
+            db_.reset(db);
+        }
+        return status;
+    }
+
+    rocksdb::Status index_disk_t::recreate_() {
+        db_.reset();
+        auto status = rocksdb::DestroyDB(path_.string(), make_options());
+        if (!status.ok()) {
+            return status;
+        }
+        std::filesystem::create_directories(path_);
+        return open_();
+    }
+
+    void index_disk_t::insert_(const std::string& key, const document_id_t& value) {
+        auto values = get_(key);
+        if (std::find(values.begin(), values.end(), value) == values.end()) {
+            values.push_back(value);
+            db_->Put(rocksdb::WriteOptions(), key, to_slice(values));
+        }
+    }
+
+    void index_disk_t::remove_(const std::string& key) {
+        db_->Delete(rocksdb::WriteOptions(), key);
+    }
+
+    void index_disk_t::remove_(const std::string& key, const document_id_t& doc) {
+        index_disk_t::result values;
+        rocksdb::PinnableSlice slice;
+        auto status = db_->Get(rocksdb::ReadOptions(), db_->DefaultColumnFamily(), key, &slice);
+        if (status.IsNotFound()) {
+            return;
+        }
+        from_slice(slice, values);
+        values.erase(std::remove(values.begin(), values.end(), doc), values.end());
+        if (values.empty()) {
+            remove_(key);
+        } else {
+            db_->Put(rocksdb::WriteOptions(), key, to_slice(values));
+        }
+    }
+
+    index_disk_t::result index_disk_t::get_(const std::string& key) const {
+        index_disk_t::result values;
+        rocksdb::PinnableSlice slice;
+        auto status = db_->Get(rocksdb::ReadOptions(), db_->DefaultColumnFamily(), key, &slice);
+        if (!status.IsNotFound()) {
+            from_slice(slice, values);
+        }
+        return values;
+    }
+
+    // a key of fewer values than the index finds all the keys it prefixes
+    void index_disk_t::find_(const std::string& key, result &res) const {
+        auto limit = unlimited;
+        scan_(key, prefix_successor(key), limit, unlimited, res, nullptr);
+    }
+
+    void index_disk_t::lower_bound_(const std::string& key, result &res) const {
+        if (key.empty()) {
+            return;
+        }
+        auto limit = unlimited;
+        scan_({}, key, limit, unlimited, res, nullptr);
+    }
+
+    void index_disk_t::upper_bound_(const std::string& key, result &res) const {
+        auto lower_key = prefix_successor(key);
+        if (lower_key.empty()) {
+            return;
+        }
+        auto limit = unlimited;
+        scan_(lower_key, {}, limit, unlimited, res, nullptr);
+    }
+
+    void index_disk_t::find(const key_t& key, components::expressions::compare_type compare, std::size_t limit,
+                            std::size_t chunk_size, const chunk_handler_t& handler) const {
+        using components::expressions::compare_type;
+        assert(!key.empty() && chunk_size > 0);
+        auto prefix = encode(key_t(key.begin(), key.end() - 1));
+        auto value = encode(key);
+        // an empty successor means no key follows, an empty prefix leaves that side open
+        auto after_value = prefix_successor(value);
+        auto after_prefix = prefix.empty() ? std::string{} : prefix_successor(prefix);
+        result chunk{key.get_allocator().resource()};
+        switch (compare) {
+            case compare_type::eq:
+                scan_(value, after_value, limit, chunk_size, chunk, handler);
+                break;
+            case compare_type::ne:
+                scan_(prefix, value, limit, chunk_size, chunk, handler);
+                if (!after_value.empty()) {
+                    scan_(after_value, after_prefix, limit, chunk_size, chunk, handler);
+                }
+                break;
+            case compare_type::gt:
+                if (!after_value.empty()) {
+                    scan_(after_value, after_prefix, limit, chunk_size, chunk, handler);
+                }
+                break;
+            case compare_type::gte:
+                scan_(value, after_prefix, limit, chunk_size, chunk, handler);
+                break;
+            case compare_type::lt:
+                scan_(prefix, value, limit, chunk_size, chunk, handler);
+                break;
+            case compare_type::lte:
+                scan_(prefix, after_value, limit, chunk_size, chunk, handler);
+                break;
+            case compare_type::any:
+            case compare_type::all:
+                for (const auto& id : find_elements_(key.back(), compare)) {
+                    if (limit == 0) {
+                        break;
+                    }
+                    chunk.push_back(id);
+                    --limit;
+                    if (chunk.size() >= chunk_size) {
+                        handler(chunk, false);
+                        chunk.clear();
+                    }
+                }
+                break;
+            default:
+                break;
+        }
+        handler(chunk, true);
+    }
+
+    // ids of a multikey index stored under any or under all of the distinct elements of value, in id order
+    index_disk_t::result index_disk_t::find_elements_(const wrapper_value_t& value, components::expressions::compare_type compare) const {
+        using document::impl::value_type;
+        std::set<std::string> keys;
+        if (value && value->type() == value_type::array) {
+            for (auto it = value->as_array()->begin(); it; ++it) {
+                keys.insert(encode(wrapper_value_t(it.value())));
+            }
+        } else {
+            keys.insert(encode(value));
+        }
+        result ids;
+        bool is_first = true;
+        for (const auto& key : keys) {
+            result found;
+            find_(key, found);
+            std::sort(found.begin(), found.end());
+            result merged;
+            if (is_first) {
+                merged = std::move(found);
+                is_first = false;
+            } else if (compare == components::expressions::compare_type::any) {
+                std::set_union(ids.begin(), ids.end(), found.begin(), found.end(), std::back_inserter(merged));
+            } else {
+                std::set_intersection(ids.begin(), ids.end(), found.begin(), found.end(), std::back_inserter(merged));
+            }
+            ids = std::move(merged);
+        }
+        return ids;
+    }
+
+    void index_disk_t::scan_(const std::string& lower, const std::string& upper, std::size_t& limit,
+                             std::size_t chunk_size, result& chunk, const chunk_handler_t& handler) const {
+        if (limit == 0 || (!upper.empty() && upper <= lower)) {
+            return;
+        }
+        rocksdb::ReadOptions options;
+        rocksdb::Slice upper_bound{upper};
+        if (!upper.empty()) {
+            options.iterate_upper_bound = &upper_bound;
+        }
+        std::unique_ptr<rocksdb::Iterator> it(db_->NewIterator(options));
+        for (it->Seek(lower.empty() ? first_value_key : lower); it->Valid() && limit > 0; it->Next()) {
+            auto size = chunk.size();
+            from_slice(it->value(), chunk);
+            auto count = std::min(chunk.size() - size, limit);
+            chunk.resize(size + count);
+            limit -= count;
+            if (chunk.size() >= chunk_size) {
+                handler(chunk, false);
+                chunk.clear();
+            }
+        }
+    }
+
 } // namespace services::disk
@@ -1,20 +1,25 @@
 #pragma once
 
 #include <filesystem>
+#include <functional>
+#include <limits>
 #include <memory_resource>
 #include <components/document/document_id.hpp>
 #include <components/document/document.hpp>
 #include <components/document/wrapper_value.hpp>
+#include <components/index/disk/batch.hpp>
 #include <components/ql/index.hpp>
 
 namespace rocksdb {
     class DB;
+    class Status;
 } // namespace rocksdb
 
 namespace services::disk {
 
-    class base_comparator;
-
+    // keys are stored in the order-preserving encoding of key_encoding.hpp, so the bytewise
+    // order of rocksdb is the order of the values and a compound key is
+    // the concatenation of its encoded values
     class index_disk_t {
         using document_id_t = components::document::document_id_t;
         using wrapper_value_t = document::wrapper_value_t;
@@ -22,26 +27,71 @@ namespace services::disk {
 
     public:
         using result = std::pmr::vector<document_id_t>;
+        using key_t = std::pmr::vector<wrapper_value_t>;
+        using batch_t = services::index::batch_t;
+        using chunk_handler_t = std::function<void(const result& chunk, bool is_last)>;
+
+        static constexpr std::size_t unlimited = std::numeric_limits<std::size_t>::max();
 
         index_disk_t(const path_t& path, components::ql::index_compare compare_type);
         ~index_disk_t();
 
         void insert(const wrapper_value_t& key, const document_id_t& value);
+        void insert(const key_t& key, const document_id_t& value);
         void remove(wrapper_value_t key);
+        void remove(const key_t& key);
         void remove(const wrapper_value_t& key, const document_id_t& doc);
+        void remove(const key_t& key, const document_id_t& doc);
+        // applies the deltas, their keys encoded by the collection, in their order with a single write
+        void apply(const batch_t& batch);
         void find(const wrapper_value_t& value, result &res) const;
+        void find(const key_t& value, result &res) const;
         result find(const wrapper_value_t& value) const;
+        result find(const key_t& value) const;
         void lower_bound(const wrapper_value_t& value, result &res) const;
+        void lower_bound(const key_t& value, result &res) const;
         result lower_bound(const wrapper_value_t& value) const;
+        result lower_bound(const key_t& value) const;
         void upper_bound(const wrapper_value_t& value, result &res) const;
+        void upper_bound(const key_t& value, result &res) const;
         result upper_bound(const wrapper_value_t& value) const;
+        result upper_bound(const key_t& value) const;
+        // ids of the keys matching compare against key, in key order and at most limit of them;
+        // all the values of key but the last are an equality prefix that bounds the scan on both sides.
+        // $any and $all take an array as the last value and find the ids stored under any or all of its elements.
+        // handler gets them in chunks of chunk_size ids, the last chunk (maybe empty) with is_last set
+        void find(const key_t& key, components::expressions::compare_type compare, std::size_t limit,
+                  std::size_t chunk_size, const chunk_handler_t& handler) const;
+
+        // the index was opened empty: its directory is new or was written in a former format and dropped,
+        // so the collection has to fill it with its documents
+        bool is_new() const noexcept;
 
         void drop();
 
     private:
+        rocksdb::Status open_();
+        rocksdb::Status recreate_();
+
+        std::string encode(const wrapper_value_t& value) const;
+        std::string encode(const key_t& key) const;
+
+        void insert_(const std::string& key, const document_id_t& value);
+        void remove_(const std::string& key);
+        void remove_(const std::string& key, const document_id_t& doc);
+        result get_(const std::string& key) const;
+        void find_(const std::string& key, result &res) const;
+        void lower_bound_(const std::string& key, result &res) const;
+        void upper_bound_(const std::string& key, result &res) const;
+        result find_elements_(const wrapper_value_t& value, components::expressions::compare_type compare) const;
+        // keys in [lower, upper) of the encoded order, an empty bound is open
+        void scan_(const std::string& lower, const std::string& upper, std::size_t& limit,
+                   std::size_t chunk_size, result& chunk, const chunk_handler_t& handler) const;
+
         std::filesystem::path path_;
         std::unique_ptr<rocksdb::DB> db_;
-        std::unique_ptr<base_comparator> comparator_;
+        components::ql::index_compare compare_type_;
+        bool is_new_{false};
     };
 
 } // namespace services::disk
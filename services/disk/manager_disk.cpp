@@ -1,7 +1,9 @@
 #include "manager_disk.hpp"
+#include <algorithm>
 #include <core/system_command.hpp>
 #include <components/index/disk/route.hpp>
 #include <services/collection/route.hpp>
+#include <services/wal/route.hpp>
 #include "route.hpp"
 #include "result.hpp"
 
@@ -19,6 +21,7 @@ namespace services::disk {
     }
 
     auto base_manager_disk_t::enqueue_impl(actor_zeta::message_ptr msg, actor_zeta::execution_unit*) -> void {
+        std::unique_lock<spin_lock> _(lock_);
         set_current_message(std::move(msg));
         execute(this, current_message());
     }
@@ -42,6 +45,8 @@ namespace services::disk {
         add_handler(handler_id(route::write_documents), &manager_disk_t::write_documents);
         add_handler(handler_id(route::remove_documents), &manager_disk_t::remove_documents);
         add_handler(handler_id(route::flush), &manager_disk_t::flush);
+        add_handler(handler_id(route::flush_finish), &manager_disk_t::flush_finish);
+        add_handler(handler_id(route::fix_wal_id_finish), &manager_disk_t::fix_wal_id_finish);
         add_handler(handler_id(index::route::create), &manager_disk_t::create_index_agent);
         add_handler(handler_id(index::route::drop), &manager_disk_t::drop_index_agent);
         add_handler(handler_id(index::route::success), &manager_disk_t::drop_index_agent_success);
@@ -59,13 +64,19 @@ namespace services::disk {
     }
 
     void manager_disk_t::create_agent() {
-        auto name_agent = "agent_disk_" + std::to_string(agents_.size() + 1);
-        trace(log_, "manager_disk create_agent : {}", name_agent);
-        auto address = spawn_actor<agent_disk_t>(
-            [this](agent_disk_t* ptr) {
-                agents_.emplace_back(agent_disk_ptr(ptr));
-            },
-            config_.path, name_agent, log_);
+        if (!disk_) {
+            disk_ = std::make_shared<disk_t>(config_.path, config_.rocksdb_wal);
+        }
+        // the first agent also owns the metadata, the wal checkpoint and the load
+        for (auto count = std::max(config_.agents, std::size_t(1)); agents_.size() < count;) {
+            auto name_agent = "agent_disk_" + std::to_string(agents_.size() + 1);
+            trace(log_, "manager_disk create_agent : {}", name_agent);
+            auto address = spawn_actor<agent_disk_t>(
+                [this](agent_disk_t* ptr) {
+                    agents_.emplace_back(agent_disk_ptr(ptr));
+                },
+                disk_, config_, name_agent, log_);
+        }
     }
 
     auto manager_disk_t::load(session_id_t& session) -> void {
@@ -103,7 +114,7 @@ namespace services::disk {
         append_command(commands_, session, command_t(command));
     }
 
-    auto manager_disk_t::write_documents(session_id_t& session, const database_name_t& database, const collection_name_t& collection, const std::pmr::vector<document_ptr>& documents) -> void {
+    auto manager_disk_t::write_documents(session_id_t& session, const database_name_t& database, const collection_name_t& collection, const components::document::packed_documents_ptr& documents) -> void {
         trace(log_, "manager_disk_t::write_documents , session : {} , database : {} , collection : {}", session.data(), database, collection);
         command_write_documents_t command{database, collection, documents};
         append_command(commands_, session, command_t(command));
@@ -117,6 +128,8 @@ namespace services::disk {
 
     auto manager_disk_t::flush(session_id_t& session, wal::id_t wal_id) -> void {
         trace(log_, "manager_disk_t::flush , session : {} , wal_id : {}", session.data(), wal_id);
+        std::vector<bool> flushed_agents(agents_.size(), false);
+        std::vector<command_t> removes;
         auto it = commands_.find(session);
         if (it != commands_.end()) {
             for (const auto& command : commands_.at(session)) {
@@ -129,7 +142,7 @@ namespace services::disk {
                         }
                     }
                     if (indexes.empty()) {
-                        actor_zeta::send(agent(), address(), command.name(), command);
+                        removes.push_back(command);
                         actor_zeta::send(current_message()->sender(), address(), handler_id(route::remove_collection_finish), session, drop_collection.collection);
                     } else {
                         removed_indexes_.emplace(session, removed_index_t{indexes.size(), command, current_message()->sender()});
@@ -137,13 +150,70 @@ namespace services::disk {
                             actor_zeta::send(index->address(), address(), index::handler_id(index::route::drop), session);
                         }
                     }
+                } else if (command.name() == handler_id(route::remove_database)) {
+                    removes.push_back(command);
                 } else {
-                    actor_zeta::send(agent(), address(), command.name(), command);
+                    auto index = agent_index_(command);
+                    flushed_agents[index] = true;
+                    actor_zeta::send(agents_[index]->address(), address(), command.name(), with_wal_id(command, wal_id));
                 }
             }
             commands_.erase(session);
         }
-        actor_zeta::send(agent(), address(), handler_id(route::fix_wal_id), wal_id);
+        // the first agent applies fix_wal_id after its own commands anyway, the others confirm theirs
+        auto flush_id = first_pending_flush_ + pending_flushes_.size();
+        pending_flushes_.push_back({wal_id, 0, {}});
+        for (std::size_t index = 1; index < flushed_agents.size(); ++index) {
+            if (flushed_agents[index]) {
+                ++pending_flushes_.back().wait_agents;
+                actor_zeta::send(agents_[index]->address(), address(), handler_id(route::flush), flush_id);
+            }
+        }
+        for (auto& command : removes) {
+            remove_after_writes_(std::move(command));
+        }
+        fix_wal_id_();
+    }
+
+    auto manager_disk_t::flush_finish(std::uint64_t flush_id) -> void {
+        trace(log_, "manager_disk_t::flush_finish , flush : {}", flush_id);
+        --pending_flushes_.at(flush_id - first_pending_flush_).wait_agents;
+        fix_wal_id_();
+    }
+
+    void manager_disk_t::remove_after_writes_(command_t command) {
+        // the metadata lives on the first agent while the documents are spread over all of them,
+        // so a remove waits until every agent has confirmed the writes sent before it
+        if (pending_flushes_.empty()) {
+            actor_zeta::send(agent(), address(), command.name(), command);
+        } else {
+            pending_flushes_.back().removes.push_back(std::move(command));
+        }
+    }
+
+    void manager_disk_t::fix_wal_id_() {
+        // wal ids are fixed in flush order, so a checkpoint never covers commands still in flight
+        std::size_t count = 0;
+        wal::id_t wal_id = 0;
+        while (!pending_flushes_.empty() && pending_flushes_.front().wait_agents == 0) {
+            for (const auto& command : pending_flushes_.front().removes) {
+                actor_zeta::send(agent(), address(), command.name(), command);
+            }
+            wal_id = std::max(wal_id, pending_flushes_.front().wal_id);
+            pending_flushes_.pop_front();
+            ++first_pending_flush_;
+            ++count;
+        }
+        if (count > 0) {
+            actor_zeta::send(agent(), address(), handler_id(route::fix_wal_id), wal_id);
+        }
+    }
+
+    auto manager_disk_t::fix_wal_id_finish(wal::id_t wal_id) -> void {
+        trace(log_, "manager_disk_t::fix_wal_id_finish , wal_id : {}", wal_id);
+        if (manager_wal_) {
+            actor_zeta::send(manager_wal_, address(), wal::handler_id(wal::route::truncate), wal_id);
+        }
     }
 
     void manager_disk_t::create_index_agent(session_id_t& session, const components::ql::create_index_t &index) {
@@ -154,15 +224,17 @@ namespace services::disk {
         } else {
             trace(log_, "manager_disk: create_index_agent : {}", name);
             index_agents_.erase(name);
+            bool is_new = false;
             auto address_agent = spawn_actor<index_agent_disk_t>(
                 [&](index_agent_disk_t* ptr) {
+                    is_new = ptr->is_new();
                     index_agents_.insert_or_assign(name, index_agent_disk_ptr(ptr));
                 },
                 resource(), config_.path, index.collection_, name, index.index_compare_, log_);
             if (session.data() != load_session_.data()) {
                 write_index_(index);
             }
-            actor_zeta::send(current_message()->sender(), address(), index::handler_id(index::route::success_create), session, name, address_agent);
+            actor_zeta::send(current_message()->sender(), address(), index::handler_id(index::route::success_create), session, name, address_agent, is_new);
         }
     }
 
@@ -192,7 +264,7 @@ namespace services::disk {
             auto it_all_drop = removed_indexes_.find(session);
             if (it_all_drop != removed_indexes_.end()) {
                 if (--it_all_drop->second.size == 0) {
-                    actor_zeta::send(agent(), address(), it_all_drop->second.command.name(), it_all_drop->second.command);
+                    remove_after_writes_(it_all_drop->second.command);
                     const auto& drop_collection = it_all_drop->second.command.get<command_remove_collection_t>();
                     remove_all_indexes_from_collection_(drop_collection.collection);
                     actor_zeta::send(it_all_drop->second.sender, address(), handler_id(route::remove_collection_finish), session, drop_collection.collection);
@@ -205,6 +277,23 @@ namespace services::disk {
         return agents_[0]->address();
     }
 
+    auto manager_disk_t::agent_index_(const command_t& command) const -> std::size_t {
+        // documents of a collection always go to the same agent, which keeps their order
+        auto by_collection = [this](const database_name_t& database, const collection_name_t& collection) {
+            auto hash = std::hash<std::string>()(database) ^ (std::hash<std::string>()(collection) << 1);
+            return hash % agents_.size();
+        };
+        if (command.name() == handler_id(route::write_documents)) {
+            const auto& write_command = command.get<command_write_documents_t>();
+            return by_collection(write_command.database, write_command.collection);
+        }
+        if (command.name() == handler_id(route::remove_documents)) {
+            const auto& remove_command = command.get<command_remove_documents_t>();
+            return by_collection(remove_command.database, remove_command.collection);
+        }
+        return 0;
+    }
+
     void manager_disk_t::write_index_(const components::ql::create_index_t &index) {
         if (metafile_indexes_) {
             msgpack::sbuffer buf;
@@ -292,7 +381,7 @@ namespace services::disk {
         add_handler(handler_id(route::remove_database), &manager_disk_empty_t::nothing<session_id_t&, const database_name_t&>);
         add_handler(handler_id(route::append_collection), &manager_disk_empty_t::nothing<session_id_t&, const database_name_t&, const collection_name_t&>);
         add_handler(handler_id(route::remove_collection), &manager_disk_empty_t::nothing<session_id_t&, const database_name_t&, const collection_name_t&>);
-        add_handler(handler_id(route::write_documents), &manager_disk_empty_t::nothing<session_id_t&, const database_name_t&, const collection_name_t&, const std::vector<document_ptr>&>);
+        add_handler(handler_id(route::write_documents), &manager_disk_empty_t::nothing<session_id_t&, const database_name_t&, const collection_name_t&, const components::document::packed_documents_ptr&>);
         add_handler(handler_id(route::remove_documents), &manager_disk_empty_t::nothing<session_id_t&, const database_name_t&, const collection_name_t&, const std::vector<document_id_t>&>);
         add_handler(handler_id(route::flush), &manager_disk_empty_t::nothing<session_id_t&, wal::id_t>);
         add_handler(handler_id(index::route::create), &manager_disk_empty_t::create_index_agent);
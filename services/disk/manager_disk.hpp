@@ -1,7 +1,9 @@
 #pragma once
 
+#include <deque>
 #include <core/excutor.hpp>
 #include <core/file/file.hpp>
+#include <core/spinlock/spinlock.hpp>
 #include <configuration/configuration.hpp>
 #include <components/log/log.hpp>
 #include "agent_disk.hpp"
@@ -18,6 +20,7 @@ namespace services::disk {
 
     private:
         actor_zeta::scheduler_raw e_;
+        spin_lock lock_;
 
         auto scheduler_impl() noexcept -> actor_zeta::scheduler_abstract_t* final;
         auto enqueue_impl(actor_zeta::message_ptr msg, actor_zeta::execution_unit*) -> void final;
@@ -52,10 +55,12 @@ namespace services::disk {
         auto append_collection(session_id_t& session, const database_name_t& database, const collection_name_t& collection) -> void;
         auto remove_collection(session_id_t& session, const database_name_t& database, const collection_name_t& collection) -> void;
 
-        auto write_documents(session_id_t& session, const database_name_t& database, const collection_name_t& collection, const std::pmr::vector<document_ptr>& documents) -> void;
+        auto write_documents(session_id_t& session, const database_name_t& database, const collection_name_t& collection, const components::document::packed_documents_ptr& documents) -> void;
         auto remove_documents(session_id_t& session, const database_name_t& database, const collection_name_t& collection, const std::pmr::vector<document_id_t>& documents) -> void;
 
         auto flush(session_id_t& session, wal::id_t wal_id) -> void;
+        auto flush_finish(std::uint64_t flush_id) -> void;
+        auto fix_wal_id_finish(wal::id_t wal_id) -> void;
 
         void create_index_agent(session_id_t& session, const components::ql::create_index_t &index);
         void drop_index_agent(session_id_t& session, const index_name_t &index_name);
@@ -65,6 +70,7 @@ namespace services::disk {
         actor_zeta::address_t manager_wal_ = actor_zeta::address_t::empty_address();
         log_t log_;
         configuration::config_disk config_;
+        disk_ptr disk_;
         std::vector<agent_disk_ptr> agents_;
         index_agent_disk_storage_t index_agents_;
         command_storage_t commands_;
@@ -78,7 +84,18 @@ namespace services::disk {
         };
         std::pmr::unordered_map<session_id_t, removed_index_t> removed_indexes_;
 
+        struct pending_flush_t {
+            wal::id_t wal_id;
+            std::size_t wait_agents;
+            std::vector<command_t> removes;
+        };
+        std::deque<pending_flush_t> pending_flushes_;
+        std::uint64_t first_pending_flush_ {0};
+
         auto agent() -> actor_zeta::address_t;
+        auto agent_index_(const command_t& command) const -> std::size_t;
+        void remove_after_writes_(command_t command);
+        void fix_wal_id_();
         void write_index_(const components::ql::create_index_t &index);
         void load_indexes_(session_id_t& session, const actor_zeta::address_t& dispatcher);
         std::vector<components::ql::create_index_t> read_indexes_(const collection_name_t& collection_name) const;
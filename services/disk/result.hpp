@@ -12,6 +12,7 @@ namespace services::disk {
     struct result_collection_t {
         collection_name_t name;
         std::pmr::vector<components::document::document_ptr> documents;
+        wal::id_t wal_id {0}; // the last wal record applied to the documents
     };
 
     struct result_database_t {
@@ -21,7 +21,9 @@ namespace services::disk {
         remove_documents,
 
         flush,
-        fix_wal_id
+        flush_finish,
+        fix_wal_id,
+        fix_wal_id_finish
     };
 
     constexpr uint64_t handler_id(route type) {
@@ -66,4 +66,124 @@ TEST_CASE("sync documents from disk") {
             REQUIRE(doc != nullptr);
         }
     }
-}
\ No newline at end of file
+}
+TEST_CASE("sync batch of documents from disk") {
+    const std::string file_db_batch = "/tmp/documents_batch.rdb";
+
+    SECTION("save documents into disk without rocksdb wal") {
+        std::filesystem::remove_all(file_db_batch);
+        disk_t disk(file_db_batch, false);
+        std::pmr::vector<document_ptr> documents;
+        for (int num = 1; num <= 100; ++num) {
+            documents.push_back(gen_doc(num));
+        }
+        disk.save_documents(database_name, collection_name, documents);
+        disk.fix_wal_id(services::wal::id_t(10));
+        REQUIRE(disk.wal_id() == services::wal::id_t(0));
+    }
+
+    SECTION("load documents and checkpoint from disk") {
+        disk_t disk(file_db_batch, false);
+        REQUIRE(disk.wal_id() == services::wal::id_t(10));
+        REQUIRE(disk.load_list_documents(database_name, collection_name).size() == 100);
+        for (int num = 1; num <= 100; ++num) {
+            auto doc = disk.load_document(database_name, collection_name, document_id_t(gen_id(num)));
+            REQUIRE(doc != nullptr);
+            components::document::document_view_t doc_view(doc);
+            REQUIRE(doc_view.get_long("count") == num);
+        }
+    }
+
+    SECTION("delete documents from disk") {
+        disk_t disk(file_db_batch);
+        std::pmr::vector<document_id_t> ids;
+        for (int num = 1; num <= 100; num += 2) {
+            ids.emplace_back(gen_id(num));
+        }
+        disk.remove_documents(database_name, collection_name, ids);
+        REQUIRE(disk.load_list_documents(database_name, collection_name).size() == 50);
+        REQUIRE(disk.load_document(database_name, collection_name, document_id_t(gen_id(1))) == nullptr);
+        REQUIRE(disk.load_document(database_name, collection_name, document_id_t(gen_id(2))) != nullptr);
+    }
+}
+
+TEST_CASE("load collections from disk in parallel") {
+    const std::string file_db_load = "/tmp/documents_load.rdb";
+    std::filesystem::remove_all(file_db_load);
+    disk_t disk(file_db_load);
+    disk.append_database(database_name);
+    for (int n_collection = 1; n_collection <= 5; ++n_collection) {
+        auto collection = collection_name + std::to_string(n_collection);
+        disk.append_collection(database_name, collection);
+        std::pmr::vector<document_ptr> documents;
+        for (int num = 1; num <= 10 * n_collection; ++num) {
+            documents.push_back(gen_doc(num));
+        }
+        disk.save_documents(database_name, collection, documents);
+    }
+
+    auto result = disk.load(3);
+    REQUIRE((*result).size() == 1);
+    REQUIRE((*result).front().collections.size() == 5);
+    for (const auto &collection : (*result).front().collections) {
+        auto n_collection = std::stoi(collection.name.substr(collection_name.size()));
+        REQUIRE(collection.documents.size() == std::size_t(10 * n_collection));
+        REQUIRE(collection.documents.size() == disk.load_list_documents(database_name, collection.name).size());
+    }
+}
+
+TEST_CASE("load one collection from disk in key ranges") {
+    const std::string file_db_ranges = "/tmp/documents_load_ranges.rdb";
+    std::filesystem::remove_all(file_db_ranges);
+    // every reopen flushes the recovered writes into a table file of their own, the bounds of which split the load
+    for (int round = 0; round < 4; ++round) {
+        disk_t disk(file_db_ranges);
+        disk.append_database(database_name);
+        disk.append_collection(database_name, collection_name);
+        std::pmr::vector<document_ptr> documents;
+        for (int num = 1 + round; num <= 100; num += 4) {
+            documents.push_back(gen_doc(num));
+        }
+        disk.save_documents(database_name, collection_name, documents);
+    }
+
+    disk_t disk(file_db_ranges);
+    auto result = disk.load(4);
+    REQUIRE((*result).size() == 1);
+    REQUIRE((*result).front().collections.size() == 1);
+    const auto &documents = (*result).front().collections.front().documents;
+    auto keys = disk.load_list_documents(database_name, collection_name);
+    REQUIRE(documents.size() == 100);
+    REQUIRE(keys.size() == documents.size());
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        components::document::document_view_t doc_view(documents.at(i));
+        REQUIRE(keys.at(i).substr(keys.at(i).rfind(':') + 1) == doc_view.get_string("_id"));
+    }
+}
+
+TEST_CASE("wal id of a collection is written with its documents") {
+    const std::string file_db_wal_id = "/tmp/documents_wal_id.rdb";
+    std::filesystem::remove_all(file_db_wal_id);
+    {
+        disk_t disk(file_db_wal_id, false);
+        disk.append_database(database_name);
+        disk.append_collection(database_name, collection_name);
+        REQUIRE(disk.collection_wal_id(database_name, collection_name) == 0);
+        std::pmr::vector<document_ptr> documents;
+        for (int num = 1; num <= 10; ++num) {
+            documents.push_back(gen_doc(num));
+        }
+        disk.save_documents(database_name, collection_name, documents, 5);
+        REQUIRE(disk.collection_wal_id(database_name, collection_name) == 5);
+        std::pmr::vector<document_id_t> ids;
+        ids.emplace_back(gen_id(1));
+        disk.remove_documents(database_name, collection_name, ids, 7);
+        REQUIRE(disk.collection_wal_id(database_name, collection_name) == 7);
+        REQUIRE(disk.wal_id() == 0);
+    }
+
+    disk_t disk(file_db_wal_id, false);
+    auto result = disk.load(1);
+    REQUIRE((*result).front().collections.front().wal_id == 7);
+    REQUIRE((*result).front().collections.front().documents.size() == 9);
+}
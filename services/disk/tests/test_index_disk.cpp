@@ -1,4 +1,6 @@
 #include <catch2/catch.hpp>
+#include <rocksdb/comparator.h>
+#include <rocksdb/db.h>
 #include <components/tests/generaty.hpp>
 #include <services/disk/index_disk.hpp>
 
@@ -196,3 +198,235 @@ TEST_CASE("index_disk::multi_values::int32") {
     REQUIRE(index.lower_bound(value(10l)).size() == 70);
     REQUIRE(index.upper_bound(value(90l)).size() == 75);
 }
+
+TEST_CASE("index_disk::int64::negative") {
+    std::filesystem::path path{"/tmp/index_disk/int64_negative"};
+    std::filesystem::remove_all(path);
+    std::filesystem::create_directories(path);
+    auto index = index_disk_t(path, components::ql::index_compare::int64);
+
+    for (int i = -50; i <= 50; ++i) {
+        index.insert(value(int64_t(i)), document_id_t{gen_id(i + 100)});
+    }
+
+    REQUIRE(index.find(value(int64_t(-10))).size() == 1);
+    REQUIRE(index.find(value(int64_t(-10))).front() == document_id_t{gen_id(90)});
+    REQUIRE(index.lower_bound(value(int64_t(-10))).size() == 40);
+    REQUIRE(index.upper_bound(value(int64_t(-10))).size() == 60);
+    REQUIRE(index.upper_bound(value(int64_t(0))).size() == 50);
+}
+
+TEST_CASE("index_disk::composite") {
+    std::filesystem::path path{"/tmp/index_disk/composite"};
+    std::filesystem::remove_all(path);
+    std::filesystem::create_directories(path);
+    auto index = index_disk_t(path, components::ql::index_compare::str);
+
+    std::vector<document::retained_const_t<document::impl::value_t>> holder;
+    auto key = [&holder](std::string_view group, std::initializer_list<int64_t> values) {
+        index_disk_t::key_t result;
+        holder.emplace_back(document::impl::new_value(group));
+        result.emplace_back(holder.back().get());
+        for (auto n : values) {
+            holder.emplace_back(document::impl::new_value(n));
+            result.emplace_back(holder.back().get());
+        }
+        return result;
+    };
+
+    for (int i = 1; i <= 100; ++i) {
+        index.insert(key(i % 2 ? "odd" : "even", {i}), document_id_t{gen_id(i)});
+    }
+    index.insert(key("od", {1}), document_id_t{gen_id(1000)});
+
+    REQUIRE(index.find(key("odd", {1})).size() == 1);
+    REQUIRE(index.find(key("odd", {1})).front() == document_id_t{gen_id(1)});
+    REQUIRE(index.find(key("odd", {2})).empty());
+    REQUIRE(index.find(key("odd", {})).size() == 50);
+    REQUIRE(index.find(key("even", {})).size() == 50);
+    REQUIRE(index.find(key("od", {})).size() == 1);
+    REQUIRE(index.lower_bound(key("odd", {})).size() == 51);
+    REQUIRE(index.upper_bound(key("even", {})).size() == 51);
+    REQUIRE(index.upper_bound(key("odd", {51})).size() == 24);
+    REQUIRE(index.lower_bound(key("odd", {51})).size() == 76);
+
+    index.remove(key("odd", {51}), document_id_t{gen_id(51)});
+    REQUIRE(index.find(key("odd", {})).size() == 49);
+}
+
+TEST_CASE("index_disk::batch") {
+    std::filesystem::path path{"/tmp/index_disk/batch"};
+    std::filesystem::remove_all(path);
+    std::filesystem::create_directories(path);
+    auto index = index_disk_t(path, components::ql::index_compare::int64);
+
+    auto delta = [](services::index::delta_type type, int64_t n, int id) {
+        return services::index::make_delta(type, index_disk_t::key_t{value(n)}, document_id_t{gen_id(id)}, components::ql::index_compare::int64);
+    };
+
+    index_disk_t::batch_t batch;
+    for (int i = 1; i <= 100; ++i) {
+        batch.push_back(delta(services::index::delta_type::insert, i % 10, i));
+    }
+    index.apply(batch);
+    REQUIRE(index.find(value(int64_t(1))).size() == 10);
+    REQUIRE(index.lower_bound(value(int64_t(5))).size() == 50);
+
+    // deltas of one key in one batch are applied in their order, as an update removes and inserts again
+    batch.clear();
+    batch.push_back(delta(services::index::delta_type::remove, 1, 1));
+    batch.push_back(delta(services::index::delta_type::insert, 2, 1));
+    batch.push_back(delta(services::index::delta_type::remove, 2, 1));
+    batch.push_back(delta(services::index::delta_type::insert, 3, 1));
+    for (int i = 4; i <= 100; i += 10) {
+        batch.push_back(delta(services::index::delta_type::remove, 4, i));
+    }
+    index.apply(batch);
+    REQUIRE(index.find(value(int64_t(1))).size() == 9);
+    REQUIRE(index.find(value(int64_t(2))).size() == 10);
+    REQUIRE(index.find(value(int64_t(3))).size() == 11);
+    REQUIRE(index.find(value(int64_t(4))).empty());
+}
+
+TEST_CASE("index_disk::range") {
+    using components::expressions::compare_type;
+    std::filesystem::path path{"/tmp/index_disk/range"};
+    std::filesystem::remove_all(path);
+    std::filesystem::create_directories(path);
+    auto index = index_disk_t(path, components::ql::index_compare::str);
+
+    std::vector<document::retained_const_t<document::impl::value_t>> holder;
+    auto key = [&holder](std::string_view group, std::initializer_list<int64_t> values) {
+        index_disk_t::key_t result;
+        holder.emplace_back(document::impl::new_value(group));
+        result.emplace_back(holder.back().get());
+        for (auto n : values) {
+            holder.emplace_back(document::impl::new_value(n));
+            result.emplace_back(holder.back().get());
+        }
+        return result;
+    };
+    for (int i = 1; i <= 100; ++i) {
+        index.insert(key(i % 2 ? "odd" : "even", {i}), document_id_t{gen_id(i)});
+    }
+
+    struct chunks_t {
+        std::vector<std::size_t> sizes;
+        index_disk_t::result ids;
+        bool is_finished{false};
+    };
+    auto find = [&index](const index_disk_t::key_t& value, compare_type compare, std::size_t limit, std::size_t chunk_size) {
+        chunks_t chunks;
+        index.find(value, compare, limit, chunk_size, [&chunks](const index_disk_t::result& chunk, bool is_last) {
+            REQUIRE_FALSE(chunks.is_finished);
+            chunks.sizes.push_back(chunk.size());
+            chunks.ids.insert(chunks.ids.end(), chunk.begin(), chunk.end());
+            chunks.is_finished = is_last;
+        });
+        REQUIRE(chunks.is_finished);
+        return chunks;
+    };
+
+    // the group bounds the range on both sides
+    auto gt = find(key("odd", {51}), compare_type::gt, index_disk_t::unlimited, 10);
+    REQUIRE(gt.ids.size() == 24);
+    REQUIRE(gt.ids.front() == document_id_t{gen_id(53)});
+    REQUIRE(gt.sizes == std::vector<std::size_t>{10, 10, 4});
+    REQUIRE(find(key("odd", {51}), compare_type::gte, index_disk_t::unlimited, 10).ids.size() == 25);
+    REQUIRE(find(key("odd", {51}), compare_type::lt, index_disk_t::unlimited, 10).ids.size() == 25);
+    REQUIRE(find(key("odd", {51}), compare_type::lte, index_disk_t::unlimited, 10).ids.size() == 26);
+    REQUIRE(find(key("odd", {51}), compare_type::ne, index_disk_t::unlimited, 10).ids.size() == 49);
+    REQUIRE(find(key("odd", {51}), compare_type::eq, index_disk_t::unlimited, 10).ids.size() == 1);
+    REQUIRE(find(key("even", {}), compare_type::eq, index_disk_t::unlimited, 100).ids.size() == 50);
+
+    // the limit stops the scan, a result of a multiple of the chunk size ends with an empty chunk
+    auto limited = find(key("even", {10}), compare_type::gte, 20, 10);
+    REQUIRE(limited.ids.size() == 20);
+    REQUIRE(limited.ids.front() == document_id_t{gen_id(10)});
+    REQUIRE(limited.ids.back() == document_id_t{gen_id(48)});
+    REQUIRE(limited.sizes == std::vector<std::size_t>{10, 10, 0});
+    REQUIRE(find(key("even", {10}), compare_type::gte, 0, 10).ids.empty());
+}
+
+TEST_CASE("index_disk::elements") {
+    using components::expressions::compare_type;
+    std::filesystem::path path{"/tmp/index_disk/elements"};
+    std::filesystem::remove_all(path);
+    std::filesystem::create_directories(path);
+    auto index = index_disk_t(path, components::ql::index_compare::int64);
+
+    // as a multikey index, the document i is stored under each of its divisors up to 5
+    for (int i = 1; i <= 30; ++i) {
+        for (int d = 1; d <= 5; ++d) {
+            if (i % d == 0) {
+                index.insert(value(d), document_id_t{gen_id(i)});
+            }
+        }
+    }
+    auto find = [&index](compare_type compare, std::initializer_list<int> values, std::size_t limit) {
+        auto array = document::impl::array_t::new_array();
+        for (auto n : values) {
+            array->append(n);
+        }
+        index_disk_t::key_t key;
+        key.emplace_back(array->as_array());
+        index_disk_t::result ids;
+        index.find(key, compare, limit, 4, [&ids](const index_disk_t::result& chunk, bool) {
+            ids.insert(ids.end(), chunk.begin(), chunk.end());
+        });
+        return ids;
+    };
+
+    REQUIRE(find(compare_type::any, {2, 3}, index_disk_t::unlimited).size() == 20);
+    REQUIRE(find(compare_type::any, {2, 3, 3}, 5).size() == 5);
+    auto all = find(compare_type::all, {2, 3}, index_disk_t::unlimited);
+    REQUIRE(all.size() == 5);
+    REQUIRE(all.front() == document_id_t{gen_id(6)});
+    REQUIRE(find(compare_type::all, {4, 5}, index_disk_t::unlimited).size() == 1);
+    REQUIRE(find(compare_type::all, {4, 7}, index_disk_t::unlimited).empty());
+}
+
+TEST_CASE("index_disk::former_format") {
+    std::filesystem::path path{"/tmp/index_disk/former_format"};
+    std::filesystem::remove_all(path);
+    std::filesystem::create_directories(path);
+
+    // the former indexes were written with a comparator of their own
+    struct former_comparator_t final : rocksdb::Comparator {
+        int Compare(const rocksdb::Slice& a, const rocksdb::Slice& b) const final {
+            return -a.compare(b);
+        }
+        const char* Name() const final {
+            return "comparator";
+        }
+        void FindShortestSeparator(std::string*, const rocksdb::Slice&) const final {}
+        void FindShortSuccessor(std::string*) const final {}
+    };
+    {
+        former_comparator_t comparator;
+        rocksdb::Options options;
+        options.create_if_missing = true;
+        options.comparator = &comparator;
+        rocksdb::DB* db;
+        REQUIRE(rocksdb::DB::Open(options, path.string(), &db).ok());
+        REQUIRE(db->Put(rocksdb::WriteOptions(), "former key", "former value").ok());
+        delete db;
+    }
+
+    {
+        auto index = index_disk_t(path, components::ql::index_compare::int64);
+        REQUIRE(index.is_new());
+        REQUIRE(index.lower_bound(value(int64_t(100))).empty());
+        REQUIRE(index.upper_bound(value(int64_t(0))).empty());
+        for (int i = 1; i <= 10; ++i) {
+            index.insert(value(int64_t(i)), document_id_t{gen_id(i)});
+        }
+        REQUIRE(index.lower_bound(value(int64_t(100))).size() == 10);
+    }
+
+    // once rebuilt the directory is in the current format and is kept
+    auto index = index_disk_t(path, components::ql::index_compare::int64);
+    REQUIRE_FALSE(index.is_new());
+    REQUIRE(index.lower_bound(value(int64_t(100))).size() == 10);
+    REQUIRE(index.find(value(int64_t(5))).front() == document_id_t{gen_id(5)});
+}
@@ -62,6 +62,7 @@ namespace services::dispatcher {
         add_handler(database::handler_id(database::route::create_collections_finish), &dispatcher_t::load_create_collections_result);
         add_handler(collection::handler_id(collection::route::create_documents_finish), &dispatcher_t::load_create_documents_result);
         add_handler(wal::handler_id(wal::route::load_finish), &dispatcher_t::load_from_wal_result);
+        add_handler(wal::handler_id(wal::route::load_failed), &dispatcher_t::load_from_wal_failed);
         add_handler(database::handler_id(database::route::create_database), &dispatcher_t::create_database);
         add_handler(database::handler_id(database::route::create_database_finish), &dispatcher_t::create_database_finish);
         add_handler(database::handler_id(database::route::create_collection), &dispatcher_t::create_collection);
@@ -82,6 +83,8 @@ namespace services::dispatcher {
         add_handler(collection::handler_id(collection::route::update_finish), &dispatcher_t::update_finish);
         add_handler(collection::handler_id(collection::route::size), &dispatcher_t::size);
         add_handler(collection::handler_id(collection::route::size_finish), &dispatcher_t::size_finish);
+        add_handler(collection::handler_id(collection::route::memory_size), &dispatcher_t::memory_size);
+        add_handler(collection::handler_id(collection::route::memory_size_finish), &dispatcher_t::memory_size_finish);
         add_handler(collection::handler_id(collection::route::close_cursor), &dispatcher_t::close_cursor);
         add_handler(collection::handler_id(collection::route::create_index), &dispatcher_t::create_index);
         add_handler(collection::handler_id(collection::route::create_index_finish), &dispatcher_t::create_index_finish);
@@ -98,6 +101,10 @@ namespace services::dispatcher {
     void dispatcher_t::load(components::session::session_id_t &session, actor_zeta::address_t sender) {
         trace(log_, "dispatcher_t::load, session: {}", session.data());
         load_session_ = session;
+        load_count_answers_ = 0;
+        load_wal_window_ = 0;
+        load_wal_requested_ = false;
+        load_wal_finished_ = false;
         make_session(session_to_address_, session, session_t(std::move(sender)));
         actor_zeta::send(manager_disk_, dispatcher_t::address(), disk::handler_id(disk::route::load), session);
     }
@@ -111,6 +118,12 @@ namespace services::dispatcher {
         } else {
             load_count_answers_ = result.count_collections();
             load_result_ = result;
+            load_disk_wal_ids_.clear();
+            for (const auto& database : *result) {
+                for (const auto& collection : database.collections) {
+                    load_disk_wal_ids_.emplace(key_collection_t(database.name, collection.name), collection.wal_id);
+                }
+            }
             actor_zeta::send(manager_database_, address(), database::handler_id(database::route::create_databases), session, result.name_databases());
         }
     }
@@ -146,15 +159,22 @@ namespace services::dispatcher {
     }
 
     void dispatcher_t::load_from_wal_result(components::session::session_id_t& session, std::vector<services::wal::record_t> &records) {
-        load_count_answers_ = records.size();
-        trace(log_, "dispatcher_t::load_from_wal_result, session: {}, count commands: {}", session.data(), load_count_answers_);
-        if (load_count_answers_ == 0) {
-            actor_zeta::send(find_session(session_to_address_, session).address(), dispatcher_t::address(), core::handler_id(core::route::load_finish));
-            remove_session(session_to_address_, session);
+        trace(log_, "dispatcher_t::load_from_wal_result, session: {}, count commands: {}", session.data(), records.size());
+        load_wal_requested_ = false;
+        if (records.empty()) {
+            load_wal_finished_ = true;
+            load_from_wal_next();
             return;
         }
-        last_wal_id_ = records[load_count_answers_ - 1].id;
+        last_wal_id_ = records.back().id;
+        load_wal_window_ = records.size();
+        load_count_answers_ += records.size();
         for (const auto &record : records) {
+            if (is_on_disk_(record)) {
+                --load_wal_window_;
+                --load_count_answers_;
+                continue;
+            }
             switch (record.type) {
                 case statement_type::create_database: {
                     auto data = std::get<create_database_t>(record.data);
@@ -163,6 +183,8 @@ namespace services::dispatcher {
                     break;
                 }
                 case statement_type::drop_database: {
+                    --load_wal_window_;
+                    --load_count_answers_;
                     break;
                 }
                 case statement_type::create_collection: {
@@ -220,9 +242,50 @@ namespace services::dispatcher {
                     break;
                 }
                 default:
+                    --load_wal_window_;
+                    --load_count_answers_;
                     break;
             }
         }
+        load_from_wal_next();
+    }
+
+    void dispatcher_t::load_from_wal_failed(components::session::session_id_t& session) {
+        error(log_, "dispatcher_t::load_from_wal_failed, session: {}, wal is corrupt after id {}, later records are not applied",
+              session.data(), last_wal_id_);
+        load_wal_requested_ = false;
+        load_wal_finished_ = true;
+        load_from_wal_next();
+    }
+
+    void dispatcher_t::load_from_wal_next() {
+        if (load_wal_finished_) {
+            if (load_count_answers_ == 0) {
+                load_disk_wal_ids_.clear();
+                actor_zeta::send(find_session(session_to_address_, load_session_).address(), dispatcher_t::address(), core::handler_id(core::route::load_finish));
+                remove_session(session_to_address_, load_session_);
+            }
+        } else if (!load_wal_requested_ && load_count_answers_ <= load_wal_window_) {
+            // the previous chunks are applied, read the next one while the last is being applied
+            load_wal_requested_ = true;
+            actor_zeta::send(manager_wal_, dispatcher_t::address(), wal::handler_id(wal::route::load_next), load_session_);
+        }
+    }
+
+    bool dispatcher_t::is_on_disk_(const services::wal::record_t& record) const {
+        // the documents of a collection are written together with the id of the last record applied to them,
+        // so a record at or below it is on disk already, even when the checkpoint lags behind it
+        return std::visit([&](const auto& statement) {
+            using statement_t = std::decay_t<decltype(statement)>;
+            if constexpr (std::is_same_v<statement_t, insert_one_t> || std::is_same_v<statement_t, insert_many_t>
+                          || std::is_same_v<statement_t, delete_one_t> || std::is_same_v<statement_t, delete_many_t>
+                          || std::is_same_v<statement_t, update_one_t> || std::is_same_v<statement_t, update_many_t>) {
+                auto it = load_disk_wal_ids_.find(key_collection_t(statement.database_, statement.collection_));
+                return it != load_disk_wal_ids_.end() && record.id <= it->second;
+            } else {
+                return false;
+            }
+        }, record.data);
     }
 
     void dispatcher_t::create_database(components::session::session_id_t& session, components::ql::ql_statement_t* statement, actor_zeta::address_t address) {
@@ -341,11 +404,19 @@ namespace services::dispatcher {
         auto& s = find_session(session_to_address_, session);
         if (s.address().get() == manager_wal_.get()) {
             wal_success(session, last_wal_id_);
-        } else {
+        } else if (result.packed_documents() && !result.packed_documents()->empty()) {
+            // the collection keeps the inserted documents and updates them in place,
+            // so the wal gets them as the collection encoded them and never reads the documents
             if (s.type() == statement_type::insert_one) {
-                actor_zeta::send(manager_wal_, dispatcher_t::address(), wal::handler_id(wal::route::insert_one), session, s.get<insert_one_t>());
+                const auto& statement = s.get<insert_one_t>();
+                insert_one_t insert(statement.database_, statement.collection_, nullptr);
+                insert.packed_documents_ = result.packed_documents();
+                actor_zeta::send(manager_wal_, dispatcher_t::address(), wal::handler_id(wal::route::insert_one), session, std::move(insert));
             } else {
-                actor_zeta::send(manager_wal_, dispatcher_t::address(), wal::handler_id(wal::route::insert_many), session, s.get<insert_many_t>());
+                const auto& statement = s.get<insert_many_t>();
+                insert_many_t insert(statement.database_, statement.collection_, std::pmr::vector<components::document::document_ptr>{resource_});
+                insert.packed_documents_ = result.packed_documents();
+                actor_zeta::send(manager_wal_, dispatcher_t::address(), wal::handler_id(wal::route::insert_many), session, std::move(insert));
             }
         }
         if (!check_load_from_wal(session)) {
@@ -489,6 +560,24 @@ namespace services::dispatcher {
         remove_session(session_to_address_, session);
     }
 
+    void dispatcher_t::memory_size(components::session::session_id_t& session, std::string& database_name, std::string& collection, actor_zeta::address_t address) {
+        trace(log_, "dispatcher_t::memory_size: session:{}, database: {}, collection: {}", session.data(), database_name, collection);
+        key_collection_t key(database_name, collection);
+        auto it_collection = collection_address_book_.find(key);
+        if (it_collection != collection_address_book_.end()) {
+            make_session(session_to_address_, session, session_t(std::move(address)));
+            actor_zeta::send(it_collection->second, dispatcher_t::address(), collection::handler_id(collection::route::memory_size), session);
+        } else {
+            actor_zeta::send(address, dispatcher_t::address(), collection::handler_id(collection::route::memory_size_finish), session, result_memory_size());
+        }
+    }
+
+    void dispatcher_t::memory_size_finish(components::session::session_id_t& session, result_memory_size& result) {
+        trace(log_, "dispatcher_t::memory_size_finish session: {}", session.data());
+        actor_zeta::send(find_session(session_to_address_, session).address(), dispatcher_t::address(), collection::handler_id(collection::route::memory_size_finish), session, result);
+        remove_session(session_to_address_, session);
+    }
+
     void dispatcher_t::create_index(components::session::session_id_t &session, components::ql::create_index_t index, actor_zeta::address_t address) {
         debug(log_, "dispatcher_t::create_index: session:{}, index: {}", session.data(), index.name());
         key_collection_t key(index.database_, index.collection_);
@@ -559,10 +648,8 @@ namespace services::dispatcher {
 
     bool dispatcher_t::check_load_from_wal(components::session::session_id_t& session) {
         if (find_session(session_to_address_, session).address().get() == manager_wal_.get()) {
-            if (--load_count_answers_ == 0) {
-                actor_zeta::send(find_session(session_to_address_, load_session_).address(), dispatcher_t::address(), core::handler_id(core::route::load_finish));
-                remove_session(session_to_address_, load_session_);
-            }
+            --load_count_answers_;
+            load_from_wal_next();
             return true;
         }
         return false;
@@ -599,6 +686,7 @@ namespace services::dispatcher {
         add_handler(collection::handler_id(collection::route::delete_documents), &manager_dispatcher_t::delete_documents);
         add_handler(collection::handler_id(collection::route::update_documents), &manager_dispatcher_t::update_documents);
         add_handler(collection::handler_id(collection::route::size), &manager_dispatcher_t::size);
+        add_handler(collection::handler_id(collection::route::memory_size), &manager_dispatcher_t::memory_size);
         add_handler(collection::handler_id(collection::route::close_cursor), &manager_dispatcher_t::close_cursor);
         add_handler(collection::handler_id(collection::route::create_index), &manager_dispatcher_t::create_index);
         add_handler(collection::handler_id(collection::route::drop_index), &manager_dispatcher_t::drop_index);
@@ -682,6 +770,11 @@ namespace services::dispatcher {
         actor_zeta::send(dispatcher(), address(), collection::handler_id(collection::route::size), session, std::move(database_name), std::move(collection), current_message()->sender());
     }
 
+    void manager_dispatcher_t::memory_size(components::session::session_id_t& session, std::string& database_name, std::string& collection) {
+        trace(log_, "manager_dispatcher_t::memory_size session: {} , database: {}, collection name: {} ", session.data(), database_name, collection);
+        actor_zeta::send(dispatcher(), address(), collection::handler_id(collection::route::memory_size), session, std::move(database_name), std::move(collection), current_message()->sender());
+    }
+
     void manager_dispatcher_t::close_cursor(components::session::session_id_t&) {
     }
 
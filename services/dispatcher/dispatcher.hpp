@@ -60,6 +60,7 @@ namespace services::dispatcher {
         void load_create_collections_result(components::session::session_id_t &session, const database_name_t &database_name, const std::vector<actor_zeta::address_t> &result);
         void load_create_documents_result(components::session::session_id_t &session);
         void load_from_wal_result(components::session::session_id_t &session, std::vector<services::wal::record_t> &records);
+        void load_from_wal_failed(components::session::session_id_t &session);
         void create_database(components::session::session_id_t& session, components::ql::ql_statement_t* statement, actor_zeta::address_t address);
         void create_database_finish(components::session::session_id_t& session, const database::database_create_result& result);
         void create_collection(components::session::session_id_t& session, components::ql::ql_statement_t* statement, const actor_zeta::address_t& address);
@@ -80,6 +81,8 @@ namespace services::dispatcher {
         void update_finish(components::session::session_id_t& session, result_update& result);
         void size(components::session::session_id_t& session, std::string& database_name, std::string& collection, actor_zeta::address_t address);
         void size_finish(components::session::session_id_t&, result_size& result);
+        void memory_size(components::session::session_id_t& session, std::string& database_name, std::string& collection, actor_zeta::address_t address);
+        void memory_size_finish(components::session::session_id_t&, result_memory_size& result);
         void create_index(components::session::session_id_t &session, components::ql::create_index_t index, actor_zeta::address_t address);
         void create_index_finish(components::session::session_id_t &session, const std::string& name, result_create_index& result);
         void drop_index(components::session::session_id_t &session, components::ql::drop_index_t drop_index, actor_zeta::address_t address);
@@ -100,9 +103,16 @@ namespace services::dispatcher {
         std::unordered_map<key_collection_t, actor_zeta::address_t, key_collection_t::hash> collection_address_book_;
         std::unordered_map<std::string, actor_zeta::address_t> database_address_book_;
         disk::result_load_t load_result_;
+        std::unordered_map<key_collection_t, services::wal::id_t, key_collection_t::hash> load_disk_wal_ids_;
         components::session::session_id_t load_session_;
         services::wal::id_t last_wal_id_ {0};
         std::size_t load_count_answers_ {0};
+        std::size_t load_wal_window_ {0};
+        bool load_wal_requested_ {false};
+        bool load_wal_finished_ {false};
+
+        void load_from_wal_next();
+        bool is_on_disk_(const services::wal::record_t& record) const;
 
         std::pair<components::logical_plan::node_ptr, components::ql::storage_parameters> create_logic_plan(
                 components::ql::ql_statement_t* statement);
@@ -155,6 +165,7 @@ namespace services::dispatcher {
         void delete_documents(components::session::session_id_t& session, components::ql::ql_statement_t* statement);
         void update_documents(components::session::session_id_t& session, components::ql::ql_statement_t* statement);
         void size(components::session::session_id_t& session, std::string& database_name, std::string& collection);
+        void memory_size(components::session::session_id_t& session, std::string& database_name, std::string& collection);
         void close_cursor(components::session::session_id_t& session);
         void create_index(components::session::session_id_t& session, components::ql::create_index_t index);
         void drop_index(components::session::session_id_t& session, components::ql::drop_index_t drop_index);
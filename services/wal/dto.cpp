@@ -4,6 +4,7 @@
 #include <chrono>
 #include <crc32c/crc32c.h>
 #include <msgpack.hpp>
+#include <components/document/support/varint.hpp>
 
 namespace services::wal {
 
@@ -15,21 +16,26 @@ namespace services::wal {
     }
 
     void append_size(buffer_t& storage, size_tt size) {
-        storage.push_back((buffer_element_t((size >> 8 & 0xff))));
-        storage.push_back(buffer_element_t(size & 0xff));
+        char buffer[document::max_varint_len32];
+        auto length = document::put_uvar_int(buffer, size);
+        storage.insert(storage.end(), buffer, buffer + length);
     }
 
-    void append_payload(buffer_t& storage, char* ptr, size_t size) {
+    void append_payload(buffer_t& storage, const char* ptr, size_t size) {
         storage.reserve(storage.size() + size);
         std::copy(ptr, ptr + size, std::back_inserter(storage));
     }
 
     crc32_t read_crc32(buffer_t& input, int index_start) {
+        return read_crc32(input.data() + index_start);
+    }
+
+    crc32_t read_crc32(const char* input) {
         crc32_t crc32_tmp = 0;
-        crc32_tmp = 0xff000000 & (uint32_t(input[size_t(index_start)]) << 24);
-        crc32_tmp |= 0x00ff0000 & (uint32_t(input[size_t(index_start) + 1]) << 16);
-        crc32_tmp |= 0x0000ff00 & (uint32_t(input[size_t(index_start) + 2]) << 8);
-        crc32_tmp |= 0x000000ff & (uint32_t(input[size_t(index_start) + 3]));
+        crc32_tmp = 0xff000000 & (uint32_t(input[0]) << 24);
+        crc32_tmp |= 0x00ff0000 & (uint32_t(input[1]) << 16);
+        crc32_tmp |= 0x0000ff00 & (uint32_t(input[2]) << 8);
+        crc32_tmp |= 0x000000ff & (uint32_t(input[3]));
         return crc32_tmp;
     }
 
@@ -38,11 +44,47 @@ namespace services::wal {
         return buffer;
     }
 
-    size_tt read_size_impl(char* input, int index_start) {
-        size_tt size_tmp = 0;
-        size_tmp = 0xff00 & (size_tt(input[index_start] << 8));
-        size_tmp |= 0x00ff & (size_tt(input[index_start + 1]));
-        return size_tmp;
+    size_tt read_size_impl(buffer_t& input, int index_start) {
+        size_tt size = 0;
+        auto start = std::min(input.size(), size_t(index_start));
+        if (document::get_uvar_int32(std::string_view(input.data() + start, input.size() - start), &size) == 0) {
+            return 0;
+        }
+        return size;
+    }
+
+    std::size_t size_length(size_tt size) {
+        return document::size_of_var_int(size);
+    }
+
+    void append_header(buffer_t& storage) {
+        storage.insert(storage.end(), wal_magic.begin(), wal_magic.end());
+        append_crc32(storage, wal_format_version);
+    }
+
+    bool read_header(buffer_t& input, version_t& version) {
+        if (input.size() < wal_header_size || std::string_view(input.data(), wal_magic.size()) != wal_magic) {
+            return false;
+        }
+        version = read_crc32(input, int(wal_magic.size()));
+        return true;
+    }
+
+    buffer_t upgrade_legacy_format(const std::string& input) {
+        buffer_t output;
+        append_header(output);
+        std::size_t index = 0;
+        while (index + legacy_size_length <= input.size()) {
+            auto size = size_tt((std::uint8_t(input[index]) << 8) | std::uint8_t(input[index + 1]));
+            auto finish = index + legacy_size_length + size + sizeof(crc32_t);
+            if (size == 0 || finish > input.size()) {
+                break;
+            }
+            append_size(output, size);
+            append_payload(output, input.data() + index + legacy_size_length, size + sizeof(crc32_t));
+            index = finish;
+        }
+        return output;
     }
 
     crc32_t pack(buffer_t& storage, char* input, size_t data_size) {
@@ -53,6 +95,44 @@ namespace services::wal {
         return last_crc32_;
     }
 
+    void pack_record_header(msgpack::packer<msgpack::sbuffer>& packer, crc32_t last_crc32, id_t id, statement_type type) {
+        packer.pack_array(4);
+        packer.pack_fix_uint32(last_crc32);
+        packer.pack_fix_uint64(id);
+        packer.pack_char(static_cast<char>(type));
+    }
+
+    crc32_t pack(buffer_t& storage, crc32_t last_crc32, id_t id, components::ql::insert_one_t& data) {
+        if (!data.packed_documents_ || data.packed_documents_->size() != 1) {
+            return pack<components::ql::insert_one_t>(storage, last_crc32, id, data);
+        }
+        msgpack::sbuffer buffer;
+        msgpack::packer<msgpack::sbuffer> packer(buffer);
+        pack_record_header(packer, last_crc32, id, data.type());
+        packer.pack_array(3);
+        packer.pack(data.database_);
+        packer.pack(data.collection_);
+        auto document = data.packed_documents_->document(0);
+        buffer.write(document.data(), document.size());
+        return pack(storage, buffer.data(), buffer.size());
+    }
+
+    crc32_t pack(buffer_t& storage, crc32_t last_crc32, id_t id, components::ql::insert_many_t& data) {
+        if (!data.packed_documents_) {
+            return pack<components::ql::insert_many_t>(storage, last_crc32, id, data);
+        }
+        msgpack::sbuffer buffer;
+        msgpack::packer<msgpack::sbuffer> packer(buffer);
+        pack_record_header(packer, last_crc32, id, data.type());
+        packer.pack_array(3);
+        packer.pack(data.database_);
+        packer.pack(data.collection_);
+        packer.pack_array(uint32_t(data.packed_documents_->size()));
+        auto documents = data.packed_documents_->documents();
+        buffer.write(documents.data(), documents.size());
+        return pack(storage, buffer.data(), buffer.size());
+    }
+
     id_t unpack_wal_id(buffer_t& storage) {
         msgpack::unpacked msg;
         msgpack::unpack(msg, storage.data(), storage.size());
@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include <msgpack.hpp>
+#include <string_view>
 #include <vector>
 #include "components/ql/statements.hpp"
 #include "base.hpp"
@@ -12,8 +13,14 @@ namespace services::wal {
     using buffer_t = std::vector<buffer_element_t>;
     using components::ql::statement_type;
 
-    using size_tt = std::uint16_t;
+    using size_tt = std::uint32_t;
     using crc32_t = std::uint32_t;
+    using version_t = std::uint32_t;
+
+    constexpr std::string_view wal_magic = "OWAL";
+    constexpr version_t wal_format_version = 2;
+    constexpr std::size_t wal_header_size = wal_magic.size() + sizeof(version_t);
+    constexpr std::size_t legacy_size_length = sizeof(std::uint16_t);
 
     template<class T>
     struct wal_entry_t final {
@@ -29,22 +36,32 @@ namespace services::wal {
     crc32_t pack(buffer_t& storage, char* data, size_t size);
     buffer_t read_payload(buffer_t& input, int index_start, int index_stop);
     crc32_t read_crc32(buffer_t& input, int index_start);
+    crc32_t read_crc32(const char* input);
     size_tt read_size_impl(buffer_t& input, int index_start);
+    std::size_t size_length(size_tt size);
+
+    void append_header(buffer_t& storage);
+    bool read_header(buffer_t& input, version_t& version);
+    buffer_t upgrade_legacy_format(const std::string& input);
+
+    void pack_record_header(msgpack::packer<msgpack::sbuffer>& packer, crc32_t last_crc32, id_t id, statement_type type);
 
     template<class T>
     crc32_t pack(buffer_t& storage, crc32_t last_crc32, id_t id, T& data) {
         msgpack::sbuffer buffer;
         msgpack::packer<msgpack::sbuffer> packer(buffer);
 
-        packer.pack_array(4);
-        packer.pack_fix_uint32(last_crc32);
-        packer.pack_fix_uint64(id);
-        packer.pack_char(static_cast<char>(data.type()));
+        pack_record_header(packer, last_crc32, id, data.type());
         packer.pack(data);
 
         return pack(storage, buffer.data(), buffer.size());
     }
 
+    // an insert the collection already encoded: its bytes are copied into the record the way
+    // the statement would have been packed, so the record reads back as the statement
+    crc32_t pack(buffer_t& storage, crc32_t last_crc32, id_t id, components::ql::insert_one_t& data);
+    crc32_t pack(buffer_t& storage, crc32_t last_crc32, id_t id, components::ql::insert_many_t& data);
+
     template<class T>
     void unpack(buffer_t& storage, wal_entry_t<T>& entry) {
         msgpack::unpacked msg;
@@ -30,6 +30,7 @@ namespace services::wal {
         trace(log_, "manager_wal_replicate_t");
         add_handler(handler_id(route::create), &manager_wal_replicate_t::create_wal_worker);
         add_handler(handler_id(route::load), &manager_wal_replicate_t::load);
+        add_handler(handler_id(route::load_next), &manager_wal_replicate_t::load_next);
         add_handler(handler_id(route::create_database), &manager_wal_replicate_t::create_database);
         add_handler(handler_id(route::drop_database), &manager_wal_replicate_t::drop_database);
         add_handler(handler_id(route::create_collection), &manager_wal_replicate_t::create_collection);
@@ -42,6 +43,7 @@ namespace services::wal {
         add_handler(handler_id(route::update_many), &manager_wal_replicate_t::update_many);
         add_handler(core::handler_id(core::route::sync), &manager_wal_replicate_t::sync);
         add_handler(handler_id(route::create_index), &manager_wal_replicate_t::create_index);
+        add_handler(handler_id(route::truncate), &manager_wal_replicate_t::truncate);
         trace(log_, "manager_wal_replicate_t start thread pool");
     }
 
@@ -68,6 +70,10 @@ namespace services::wal {
         actor_zeta::send(dispatchers_[0]->address(), address(), handler_id(route::load), session, current_message()->sender(), wal_id);
     }
 
+    void manager_wal_replicate_t::load_next(session_id_t& session) {
+        actor_zeta::send(dispatchers_[0]->address(), address(), handler_id(route::load_next), session);
+    }
+
     void manager_wal_replicate_t::create_database(session_id_t& session, components::ql::create_database_t& data) {
         trace(log_, "manager_wal_replicate_t::create_database {}", data.database_);
         actor_zeta::send(dispatchers_[0]->address(), address(), handler_id(route::create_database), session, current_message()->sender(), std::move(data));
@@ -123,6 +129,11 @@ namespace services::wal {
         actor_zeta::send(dispatchers_[0]->address(), address(), handler_id(route::create_index), session, current_message()->sender(), std::move(data));
     }
 
+    void manager_wal_replicate_t::truncate(services::wal::id_t wal_id) {
+        trace(log_, "manager_wal_replicate_t::truncate, id: {}", wal_id);
+        actor_zeta::send(dispatchers_[0]->address(), address(), handler_id(route::truncate), wal_id);
+    }
+
 
     manager_wal_replicate_empty_t::manager_wal_replicate_empty_t(actor_zeta::detail::pmr::memory_resource* mr, actor_zeta::scheduler_raw scheduler, log_t& log)
         : base_manager_wal_replicate_t(mr, scheduler) {
@@ -130,6 +141,7 @@ namespace services::wal {
         using namespace components;
         add_handler(handler_id(route::create), &manager_wal_replicate_empty_t::nothing<>);
         add_handler(handler_id(route::load), &manager_wal_replicate_empty_t::nothing<session_id_t&, services::wal::id_t>);
+        add_handler(handler_id(route::load_next), &manager_wal_replicate_empty_t::nothing<session_id_t&>);
         add_handler(handler_id(route::create_database), &manager_wal_replicate_empty_t::nothing<session_id_t&, ql::create_database_t&>);
         add_handler(handler_id(route::drop_database), &manager_wal_replicate_empty_t::nothing<session_id_t&, ql::drop_database_t&>);
         add_handler(handler_id(route::create_collection), &manager_wal_replicate_empty_t::nothing<session_id_t&, ql::create_collection_t&>);
@@ -142,6 +154,7 @@ namespace services::wal {
         add_handler(handler_id(route::update_many), &manager_wal_replicate_empty_t::nothing<session_id_t&, ql::update_many_t&>);
         add_handler(core::handler_id(core::route::sync), &manager_wal_replicate_empty_t::nothing<address_pack&>);
         add_handler(handler_id(route::create_index), &manager_wal_replicate_empty_t::nothing<session_id_t&, ql::create_index_t&>);
+        add_handler(handler_id(route::truncate), &manager_wal_replicate_empty_t::nothing<services::wal::id_t>);
     }
 
 } //namespace services::wal
@@ -51,6 +51,7 @@ namespace services::wal {
         ~manager_wal_replicate_t() final;
         void create_wal_worker();
         void load(session_id_t& session, services::wal::id_t wal_id);
+        void load_next(session_id_t& session);
         void create_database(session_id_t& session, components::ql::create_database_t& data);
         void drop_database(session_id_t& session, components::ql::drop_database_t& data);
         void create_collection(session_id_t& session, components::ql::create_collection_t& data);
@@ -62,6 +63,7 @@ namespace services::wal {
         void update_one(session_id_t& session, components::ql::update_one_t& data);
         void update_many(session_id_t& session, components::ql::update_many_t& data);
         void create_index(session_id_t& session, components::ql::create_index_t& data);
+        void truncate(services::wal::id_t wal_id);
 
     private:
         actor_zeta::address_t manager_disk_ = actor_zeta::address_t::empty_address();
@@ -8,6 +8,8 @@ namespace services::wal {
 
         load,
         load_finish,
+        load_next,
+        load_failed,
 
         create_database,
         drop_database,
@@ -22,6 +24,8 @@ namespace services::wal {
         update_many,
         create_index,
 
+        commit,
+        truncate,
         success,
     };
 
@@ -26,8 +26,8 @@ TEST_CASE("pack and unpack") {
     wal_entry_t<insert_many_t> entry;
     entry.size_= read_size_impl(buffer, 0);
 
-    auto start = sizeof(size_tt);
-    auto finish = sizeof(size_tt) + entry.size_ + sizeof(crc32_t);
+    auto start = size_length(entry.size_);
+    auto finish = start + entry.size_ + sizeof(crc32_t);
     auto storage = read_payload(buffer, int(start), int(finish));
 
     unpack<insert_many_t>(storage,entry);
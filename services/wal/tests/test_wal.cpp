@@ -3,6 +3,8 @@
 #include <crc32c/crc32c.h>
 #include <actor-zeta.hpp>
 #include <log/log.hpp>
+#include <fstream>
+#include <limits>
 #include <string>
 
 #include <core/non_thread_scheduler/scheduler_test.hpp>
@@ -37,7 +39,7 @@ struct test_wal {
 };
 
 
-test_wal create_test_wal(const std::filesystem::path &path) {
+test_wal create_test_wal(const std::filesystem::path &path, configuration::config_wal config = {}) {
     test_wal result;
     static auto log = initialization_logger("python", "/tmp/docker_logs/");
     log.set_level(log_t::level::trace);
@@ -45,7 +47,6 @@ test_wal create_test_wal(const std::filesystem::path &path) {
     actor_zeta::detail::pmr::memory_resource *resource = actor_zeta::detail::pmr::get_default_resource();
     std::filesystem::remove_all(path);
     std::filesystem::create_directories(path);
-    configuration::config_wal config;
     config.path = path;
     auto manager = actor_zeta::spawn_supervisor<manager_wal_replicate_t>(resource, result.scheduler, config, log);
     auto allocate_byte = sizeof(wal_replicate_t);
@@ -60,14 +61,14 @@ TEST_CASE("insert one test") {
     auto test_wal = create_test_wal("/tmp/wal/insert_one");
     test_insert_one(test_wal.wal);
 
-    std::size_t read_index = 0;
+    std::size_t read_index = wal_header_size;
     for (int num = 1; num <= 5; ++num) {
         wal_entry_t<insert_one_t> entry;
 
         entry.size_ = test_wal.wal->test_read_size(read_index);
 
-        auto start = read_index + sizeof(size_tt);
-        auto finish = read_index + sizeof(size_tt) + entry.size_ + sizeof(crc32_t);
+        auto start = read_index + size_length(entry.size_);
+        auto finish = start + entry.size_ + sizeof(crc32_t);
         auto output = test_wal.wal->test_read(start, finish);
 
         auto crc32_index = entry.size_;
@@ -100,10 +101,10 @@ TEST_CASE("insert many empty test") {
 
     wal_entry_t<insert_many_t> entry;
 
-    entry.size_ = test_wal.wal->test_read_size(0);
+    entry.size_ = test_wal.wal->test_read_size(wal_header_size);
 
-    auto start = sizeof(size_tt);
-    auto finish = sizeof(size_tt) + entry.size_ + sizeof(crc32_t);
+    auto start = wal_header_size + size_length(entry.size_);
+    auto finish = start + entry.size_ + sizeof(crc32_t);
     auto output = test_wal.wal->test_read(start, finish);
 
     auto crc32_index = entry.size_;
@@ -129,14 +130,14 @@ TEST_CASE("insert many test") {
         test_wal.wal->insert_many(session, address, data);
     }
 
-    std::size_t read_index = 0;
+    std::size_t read_index = wal_header_size;
     for (int i = 0; i <= 3; ++i) {
         wal_entry_t<insert_many_t> entry;
 
         entry.size_ = test_wal.wal->test_read_size(read_index);
 
-        auto start = read_index + sizeof(size_tt);
-        auto finish = read_index + sizeof(size_tt) + entry.size_ + sizeof(crc32_t);
+        auto start = read_index + size_length(entry.size_);
+        auto finish = start + entry.size_ + sizeof(crc32_t);
         auto output = test_wal.wal->test_read(start, finish);
 
         auto crc32_index = entry.size_;
@@ -162,6 +163,44 @@ TEST_CASE("insert many test") {
     }
 }
 
+// the documents the collection encoded are copied into the record, which reads back as the statement
+TEST_CASE("insert packed documents test") {
+    auto test_wal = create_test_wal("/tmp/wal/insert_packed");
+    auto session = components::session::session_id_t();
+    auto address = actor_zeta::base::address_t::address_t::empty_address();
+
+    std::pmr::vector<components::document::document_ptr> documents;
+    for (int num = 1; num <= 5; ++num) {
+        documents.push_back(gen_doc(num));
+    }
+    insert_many_t many(database_name, collection_name, {});
+    many.packed_documents_ = components::document::pack_documents(documents);
+    test_wal.wal->insert_many(session, address, many);
+    insert_one_t one(database_name, collection_name, nullptr);
+    one.packed_documents_ = components::document::pack_documents({documents.front()});
+    test_wal.wal->insert_one(session, address, one);
+    test_wal.scheduler->run();
+
+    auto chunks = test_wal.wal->test_replay(services::wal::id_t(0));
+    REQUIRE(chunks.size() == 1);
+    const auto& records = chunks.front();
+    REQUIRE(records.size() == 2);
+    REQUIRE(records[0].type == statement_type::insert_many);
+    const auto& inserted = std::get<insert_many_t>(records[0].data);
+    REQUIRE(inserted.database_ == database_name);
+    REQUIRE(inserted.collection_ == collection_name);
+    REQUIRE(inserted.documents_.size() == 5);
+    for (int num = 1; num <= 5; ++num) {
+        document_view_t view(inserted.documents_.at(std::size_t(num - 1)));
+        REQUIRE(view.get_string("_id") == gen_id(num));
+        REQUIRE(view.get_long("count") == num);
+    }
+    REQUIRE(records[1].type == statement_type::insert_one);
+    document_view_t view(std::get<insert_one_t>(records[1].data).document_);
+    REQUIRE(view.get_string("_id") == gen_id(1));
+    REQUIRE(view.get_string("countStr") == "1");
+}
+
 TEST_CASE("delete one test") {
     auto test_wal = create_test_wal("/tmp/wal/delete_one");
 
@@ -175,7 +214,7 @@ TEST_CASE("delete one test") {
         test_wal.wal->delete_one(session, address, data);
     }
 
-    std::size_t index = 0;
+    std::size_t index = wal_header_size;
     for (int num = 1; num <= 5; ++num) {
         auto record = test_wal.wal->test_read_record(index);
         REQUIRE(record.type == statement_type::delete_one);
@@ -206,7 +245,7 @@ TEST_CASE("delete many test") {
         test_wal.wal->delete_many(session, address, data);
     }
 
-    std::size_t index = 0;
+    std::size_t index = wal_header_size;
     for (int num = 1; num <= 5; ++num) {
         auto record = test_wal.wal->test_read_record(index);
         REQUIRE(record.type == statement_type::delete_many);
@@ -238,7 +277,7 @@ TEST_CASE("update one test") {
         test_wal.wal->update_one(session, address, data);
     }
 
-    std::size_t index = 0;
+    std::size_t index = wal_header_size;
     for (int num = 1; num <= 5; ++num) {
         auto record = test_wal.wal->test_read_record(index);
         REQUIRE(record.type == statement_type::update_one);
@@ -273,7 +312,7 @@ TEST_CASE("update many test") {
         test_wal.wal->update_many(session, address, data);
     }
 
-    std::size_t index = 0;
+    std::size_t index = wal_header_size;
     for (int num = 1; num <= 5; ++num) {
         auto record = test_wal.wal->test_read_record(index);
         REQUIRE(record.type == statement_type::update_many);
@@ -309,7 +348,7 @@ TEST_CASE("test read id") {
     auto test_wal = create_test_wal("/tmp/wal/read_id");
     test_insert_one(test_wal.wal);
 
-    std::size_t index = 0;
+    std::size_t index = wal_header_size;
     for (int num = 1; num <= 5; ++num) {
         REQUIRE(test_wal.wal->test_read_id(index) == services::wal::id_t(num));
         index = test_wal.wal->test_next_record(index);
@@ -321,7 +360,7 @@ TEST_CASE("test read record") {
     auto test_wal = create_test_wal("/tmp/wal/read_record");
     test_insert_one(test_wal.wal);
 
-    std::size_t index = 0;
+    std::size_t index = wal_header_size;
     for (int num = 1; num <= 5; ++num) {
         auto record = test_wal.wal->test_read_record(index);
         REQUIRE(record.type == statement_type::insert_one);
@@ -335,3 +374,294 @@ TEST_CASE("test read record") {
     }
     REQUIRE(test_wal.wal->test_read_record(index).type == statement_type::unused);
 }
+
+TEST_CASE("group commit test") {
+    configuration::config_wal config;
+    config.group_commit = true;
+    auto test_wal = create_test_wal("/tmp/wal/group_commit", config);
+    test_insert_one(test_wal.wal);
+
+    REQUIRE(test_wal.wal->test_read_id(wal_header_size) == services::wal::id_t(0));
+    test_wal.scheduler->run();
+
+    std::size_t index = wal_header_size;
+    for (int num = 1; num <= 5; ++num) {
+        auto record = test_wal.wal->test_read_record(index);
+        REQUIRE(record.type == statement_type::insert_one);
+        REQUIRE(record.id == services::wal::id_t(num));
+        document_view_t view(std::get<insert_one_t>(record.data).document_);
+        REQUIRE(view.get_long("count") == num);
+        index = test_wal.wal->test_next_record(index);
+    }
+    REQUIRE(test_wal.wal->test_read_record(index).type == statement_type::unused);
+}
+
+TEST_CASE("group commit window test") {
+    configuration::config_wal config;
+    config.group_commit = true;
+    config.group_commit_window = std::chrono::hours(1);
+    auto test_wal = create_test_wal("/tmp/wal/group_commit_window", config);
+    test_insert_one(test_wal.wal);
+
+    REQUIRE(test_wal.wal->test_read_id(wal_header_size) == services::wal::id_t(0));
+    // nothing else arrives, so the group is committed once the mailbox drains rather than after the window
+    test_wal.scheduler->run();
+
+    std::size_t index = wal_header_size;
+    for (int num = 1; num <= 5; ++num) {
+        REQUIRE(test_wal.wal->test_read_id(index) == services::wal::id_t(num));
+        index = test_wal.wal->test_next_record(index);
+    }
+}
+
+TEST_CASE("group commit max bytes test") {
+    configuration::config_wal config;
+    config.group_commit = true;
+    config.group_commit_max_bytes = 1;
+    auto test_wal = create_test_wal("/tmp/wal/group_commit_max_bytes", config);
+    test_insert_one(test_wal.wal);
+
+    std::size_t index = wal_header_size;
+    for (int num = 1; num <= 5; ++num) {
+        REQUIRE(test_wal.wal->test_read_id(index) == services::wal::id_t(num));
+        index = test_wal.wal->test_next_record(index);
+    }
+    test_wal.scheduler->run();
+}
+
+TEST_CASE("segment rotation and truncation test") {
+    configuration::config_wal config;
+    config.max_segment_size = 1;
+    auto test_wal = create_test_wal("/tmp/wal/segments", config);
+    test_insert_one(test_wal.wal);
+    test_wal.scheduler->run();
+
+    REQUIRE(test_wal.wal->test_count_segments() == 6);
+    REQUIRE(std::filesystem::exists("/tmp/wal/segments/000001.seg"));
+    REQUIRE(std::filesystem::exists("/tmp/wal/segments/MANIFEST"));
+
+    test_wal.wal->truncate(services::wal::id_t(3));
+    REQUIRE(test_wal.wal->test_count_segments() == 3);
+    REQUIRE_FALSE(std::filesystem::exists("/tmp/wal/segments/000003.seg"));
+    REQUIRE(std::filesystem::exists("/tmp/wal/segments/000004.seg"));
+
+    test_wal.wal->truncate(services::wal::id_t(5));
+    REQUIRE(test_wal.wal->test_count_segments() == 1);
+    REQUIRE(std::filesystem::exists("/tmp/wal/segments/000006.seg"));
+}
+
+TEST_CASE("sparse index test") {
+    configuration::config_wal config;
+    config.index_interval = 2;
+    auto test_wal = create_test_wal("/tmp/wal/sparse_index", config);
+    test_insert_one(test_wal.wal);
+    test_wal.scheduler->run();
+
+    REQUIRE(std::filesystem::file_size("/tmp/wal/sparse_index/000001.idx") == 3 * 2 * sizeof(std::uint64_t));
+    std::size_t index = wal_header_size;
+    for (int num = 1; num <= 5; ++num) {
+        std::size_t start_index;
+        REQUIRE(test_wal.wal->test_find_start_record(services::wal::id_t(num), start_index));
+        REQUIRE(start_index == index);
+        index = test_wal.wal->test_next_record(index);
+    }
+    std::size_t start_index;
+    REQUIRE_FALSE(test_wal.wal->test_find_start_record(services::wal::id_t(6), start_index));
+}
+
+TEST_CASE("streaming replay test") {
+    auto test_wal = create_test_wal("/tmp/wal/replay");
+    test_insert_one(test_wal.wal);
+    test_wal.scheduler->run();
+
+    auto chunks = test_wal.wal->test_replay(services::wal::id_t(0));
+    REQUIRE(chunks.size() == 1);
+    REQUIRE(chunks.front().size() == 5);
+
+    configuration::config_wal config;
+    config.max_segment_size = 1;
+    config.replay_chunk_bytes = 1;
+    auto test_wal_segments = create_test_wal("/tmp/wal/replay_segments", config);
+    test_insert_one(test_wal_segments.wal);
+    test_wal_segments.scheduler->run();
+
+    chunks = test_wal_segments.wal->test_replay(services::wal::id_t(0));
+    REQUIRE(chunks.size() == 5);
+    for (int num = 1; num <= 5; ++num) {
+        const auto& chunk = chunks.at(std::size_t(num - 1));
+        REQUIRE(chunk.size() == 1);
+        REQUIRE(chunk.front().id == services::wal::id_t(num));
+        document_view_t view(std::get<insert_one_t>(chunk.front().data).document_);
+        REQUIRE(view.get_long("count") == num);
+    }
+
+    chunks = test_wal_segments.wal->test_replay(services::wal::id_t(2));
+    REQUIRE(chunks.size() == 3);
+    REQUIRE(chunks.front().front().id == services::wal::id_t(3));
+    REQUIRE(chunks.back().front().id == services::wal::id_t(5));
+}
+
+void flip_byte(const std::filesystem::path& path, std::size_t offset) {
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekg(std::streamoff(offset));
+    auto byte = char(file.get() ^ 0xff);
+    file.seekp(std::streamoff(offset));
+    file.put(byte);
+}
+
+TEST_CASE("corrupt replay test") {
+    bool corrupt = false;
+
+    auto test_wal = create_test_wal("/tmp/wal/replay_torn_tail");
+    test_insert_one(test_wal.wal);
+    test_wal.scheduler->run();
+    flip_byte("/tmp/wal/replay_torn_tail/000001.seg", std::filesystem::file_size("/tmp/wal/replay_torn_tail/000001.seg") - 1);
+    auto chunks = test_wal.wal->test_replay(services::wal::id_t(0), &corrupt);
+    REQUIRE_FALSE(corrupt);
+    REQUIRE(chunks.size() == 1);
+    REQUIRE(chunks.front().size() == 4);
+    REQUIRE(chunks.front().back().id == services::wal::id_t(4));
+
+    auto test_wal_middle = create_test_wal("/tmp/wal/replay_corrupt");
+    test_insert_one(test_wal_middle.wal);
+    test_wal_middle.scheduler->run();
+    auto second = test_wal_middle.wal->test_next_record(wal_header_size);
+    flip_byte("/tmp/wal/replay_corrupt/000001.seg", test_wal_middle.wal->test_next_record(second) - 1);
+    chunks = test_wal_middle.wal->test_replay(services::wal::id_t(0), &corrupt);
+    REQUIRE(corrupt);
+    REQUIRE(chunks.size() == 1);
+    REQUIRE(chunks.front().size() == 1);
+    REQUIRE(chunks.front().front().id == services::wal::id_t(1));
+
+    configuration::config_wal config;
+    config.max_segment_size = 1;
+    auto test_wal_segments = create_test_wal("/tmp/wal/replay_corrupt_segments", config);
+    test_insert_one(test_wal_segments.wal);
+    test_wal_segments.scheduler->run();
+    flip_byte("/tmp/wal/replay_corrupt_segments/000002.seg", std::filesystem::file_size("/tmp/wal/replay_corrupt_segments/000002.seg") - 1);
+    chunks = test_wal_segments.wal->test_replay(services::wal::id_t(0), &corrupt);
+    REQUIRE(corrupt);
+    REQUIRE(chunks.size() == 1);
+    REQUIRE(chunks.front().size() == 1);
+    REQUIRE(chunks.front().front().id == services::wal::id_t(1));
+}
+
+wal_replicate_t* reopen_test_wal(const std::filesystem::path& path) {
+    static auto log = initialization_logger("python", "/tmp/docker_logs/");
+    auto* scheduler = new core::non_thread_scheduler::scheduler_test_t(1, 1);
+    configuration::config_wal config;
+    config.path = path;
+    auto manager = actor_zeta::spawn_supervisor<manager_wal_replicate_t>(get_default_resource(), scheduler, config, log);
+    void* buffer = manager->resource()->allocate(sizeof(wal_replicate_t), alignof(wal_replicate_t));
+    return new (buffer) wal_replicate_t(manager.get(), log, config);
+}
+
+TEST_CASE("torn tail recovery test") {
+    const std::filesystem::path path = "/tmp/wal/torn_tail_recovery";
+    const auto segment = path / "000001.seg";
+    auto test_wal = create_test_wal(path);
+    test_insert_one(test_wal.wal);
+    test_wal.scheduler->run();
+    auto fifth = wal_header_size;
+    for (int num = 1; num < 5; ++num) {
+        fifth = test_wal.wal->test_next_record(fifth);
+    }
+
+    // a crash in the middle of the fifth record
+    std::filesystem::resize_file(segment, fifth + 3);
+    auto* wal = reopen_test_wal(path);
+    REQUIRE(std::filesystem::file_size(segment) == fifth);
+    test_insert_one(wal);
+    auto chunks = wal->test_replay(services::wal::id_t(0));
+    REQUIRE(chunks.size() == 1);
+    REQUIRE(chunks.front().size() == 9);
+    for (std::size_t i = 0; i < chunks.front().size(); ++i) {
+        REQUIRE(chunks.front().at(i).id == services::wal::id_t(i + 1));
+    }
+    REQUIRE(chunks.front().at(4).last_crc32 == chunks.front().at(3).crc32);
+
+    // the records appended after the restart survive the next one
+    wal = reopen_test_wal(path);
+    bool corrupt = true;
+    chunks = wal->test_replay(services::wal::id_t(0), &corrupt);
+    REQUIRE_FALSE(corrupt);
+    REQUIRE(chunks.size() == 1);
+    REQUIRE(chunks.front().size() == 9);
+    REQUIRE(chunks.front().back().id == services::wal::id_t(9));
+    document_view_t view(std::get<insert_one_t>(chunks.front().back().data).document_);
+    REQUIRE(view.get_long("count") == 5);
+
+    // a record failing its crc32 with records behind it is cut off as well, the segment is kept aside
+    auto second = wal->test_next_record(wal_header_size);
+    flip_byte(segment, wal->test_next_record(second) - 1);
+    wal = reopen_test_wal(path);
+    REQUIRE(std::filesystem::exists(path / "000001.seg.corrupt"));
+    REQUIRE(std::filesystem::file_size(segment) == wal->test_next_record(wal_header_size));
+    test_insert_one(wal);
+    chunks = wal->test_replay(services::wal::id_t(0), &corrupt);
+    REQUIRE_FALSE(corrupt);
+    REQUIRE(chunks.front().size() == 6);
+    REQUIRE(chunks.front().back().id == services::wal::id_t(6));
+}
+
+TEST_CASE("large record test") {
+    auto test_wal = create_test_wal("/tmp/wal/large_record");
+
+    constexpr int count = 2000;
+    std::pmr::vector<components::document::document_ptr> documents;
+    for (int num = 1; num <= count; ++num) {
+        documents.push_back(gen_doc(num));
+    }
+    insert_many_t data(database_name, collection_name, std::move(documents));
+    auto session = components::session::session_id_t();
+    auto address = actor_zeta::base::address_t::address_t::empty_address();
+    test_wal.wal->insert_many(session, address, data);
+
+    REQUIRE(test_wal.wal->test_read_size(wal_header_size) > std::numeric_limits<std::uint16_t>::max());
+    auto record = test_wal.wal->test_read_record(wal_header_size);
+    REQUIRE(record.type == statement_type::insert_many);
+    REQUIRE(std::get<insert_many_t>(record.data).documents_.size() == count);
+    document_view_t view(std::get<insert_many_t>(record.data).documents_.back());
+    REQUIRE(view.get_long("count") == count);
+}
+
+TEST_CASE("legacy format test") {
+    const std::filesystem::path path = "/tmp/wal/legacy_format";
+    std::filesystem::remove_all(path);
+    std::filesystem::create_directories(path);
+    {
+        core::file::file_t legacy(path / ".wal");
+        crc32_t last_crc32 = 0;
+        for (int num = 1; num <= 5; ++num) {
+            insert_one_t data(database_name, collection_name, gen_doc(num));
+            buffer_t buffer;
+            last_crc32 = pack(buffer, last_crc32, services::wal::id_t(num), data);
+            auto size = read_size_impl(buffer, 0);
+            char size_legacy[] = {char(size >> 8 & 0xff), char(size & 0xff)};
+            legacy.append(size_legacy, sizeof(size_legacy));
+            legacy.append(buffer.data() + size_length(size), size + sizeof(crc32_t));
+        }
+    }
+
+    static auto log = initialization_logger("python", "/tmp/docker_logs/");
+    auto* scheduler = new core::non_thread_scheduler::scheduler_test_t(1, 1);
+    configuration::config_wal config;
+    config.path = path;
+    auto manager = actor_zeta::spawn_supervisor<manager_wal_replicate_t>(get_default_resource(), scheduler, config, log);
+    void* buffer = manager->resource()->allocate(sizeof(wal_replicate_t), alignof(wal_replicate_t));
+    auto* wal = new (buffer) wal_replicate_t(manager.get(), log, config);
+
+    REQUIRE_FALSE(std::filesystem::exists(path / ".wal"));
+    std::size_t index = wal_header_size;
+    for (int num = 1; num <= 5; ++num) {
+        auto record = wal->test_read_record(index);
+        REQUIRE(record.type == statement_type::insert_one);
+        REQUIRE(record.id == services::wal::id_t(num));
+        document_view_t view(std::get<insert_one_t>(record.data).document_);
+        REQUIRE(view.get_long("count") == num);
+        index = wal->test_next_record(index);
+    }
+
+    test_insert_one(wal);
+    REQUIRE(wal->test_read_id(index) == services::wal::id_t(6));
+}
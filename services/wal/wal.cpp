@@ -1,8 +1,13 @@
 #include "wal.hpp"
 #include <unistd.h>
+#include <algorithm>
+#include <cstring>
+#include <sstream>
 #include <utility>
 #include <crc32c/crc32c.h>
 
+#include <components/document/support/varint.hpp>
+
 #include "dto.hpp"
 #include "route.hpp"
 #include "manager_wal_replicate.hpp"
@@ -10,6 +15,11 @@
 namespace services::wal {
 
     constexpr static auto wal_name = ".wal";
+    constexpr static auto manifest_name = "MANIFEST";
+    constexpr static auto archive_name = "archive";
+    constexpr static auto segment_extension = ".seg";
+    constexpr static auto index_extension = ".idx";
+    constexpr static std::size_t segment_name_width = 6;
 
     bool file_exist_(const std::filesystem::path &path) {
         std::filesystem::file_status s = std::filesystem::file_status{};
@@ -19,7 +29,41 @@ namespace services::wal {
     }
 
     std::size_t next_index(std::size_t index, size_tt size) {
-        return index + size + sizeof(size_tt) + sizeof(crc32_t);
+        return index + size_length(size) + size + sizeof(crc32_t);
+    }
+
+    // the bytes from offset to the end of a segment are a write torn by a crash: one record cut short or
+    // ending exactly at the end, or the zeros a crash can leave behind the last write
+    bool is_torn_tail(const core::file::mapped_file_t& map, std::size_t offset) {
+        std::string_view tail(map.data() + offset, map.size() - offset);
+        size_tt size = 0;
+        if (document::get_uvar_int32(tail, &size) == 0) {
+            return true;
+        }
+        if (size == 0) {
+            return std::all_of(tail.begin(), tail.end(), [](char c) { return c == '\0'; });
+        }
+        return next_index(offset, size) >= map.size();
+    }
+
+    void unpack_record(const char* data, record_t& record) {
+        record.crc32 = read_crc32(data + record.size);
+        if (record.crc32 == crc32c::Crc32c(data, record.size)) {
+            msgpack::unpacked msg;
+            msgpack::unpack(msg, data, record.size);
+            const auto& o = msg.get();
+            record.last_crc32 = o.via.array.ptr[0].as<crc32_t>();
+            record.id = o.via.array.ptr[1].as<services::wal::id_t>();
+            record.type = static_cast<components::ql::statement_type>(o.via.array.ptr[2].as<char>());
+            record.set_data(o.via.array.ptr[3]);
+        } else {
+            record.type = components::ql::statement_type::unused;
+        }
+    }
+
+    // the record was read whole and passes its crc32
+    bool is_complete(const record_t& record) {
+        return record.is_valid() && record.type != components::ql::statement_type::unused;
     }
 
 
@@ -28,6 +72,7 @@ namespace services::wal {
         , log_(log.clone())
         , config_(std::move(config)) {
         add_handler(handler_id(route::load), &wal_replicate_t::load);
+        add_handler(handler_id(route::load_next), &wal_replicate_t::load_next);
         add_handler(handler_id(route::create_database), &wal_replicate_t::create_database);
         add_handler(handler_id(route::drop_database), &wal_replicate_t::drop_database);
         add_handler(handler_id(route::create_collection), &wal_replicate_t::create_collection);
@@ -39,77 +84,388 @@ namespace services::wal {
         add_handler(handler_id(route::update_one), &wal_replicate_t::update_one);
         add_handler(handler_id(route::update_many), &wal_replicate_t::update_many);
         add_handler(handler_id(route::create_index), &wal_replicate_t::create_index);
+        add_handler(handler_id(route::commit), &wal_replicate_t::commit);
+        add_handler(handler_id(route::truncate), &wal_replicate_t::truncate);
         if (config_.sync_to_disk) {
             if (!file_exist_(config_.path)) {
                 std::filesystem::create_directory(config_.path);
             }
-            file_ = std::make_unique<core::file::file_t>(config_.path / wal_name);
-            file_->seek_eof();
+            open_segments_();
             init_id();
         }
     }
 
+    std::filesystem::path wal_replicate_t::segment_path_(std::size_t number) const {
+        auto name = std::to_string(number);
+        if (name.size() < segment_name_width) {
+            name.insert(0, segment_name_width - name.size(), '0');
+        }
+        return config_.path / (name + segment_extension);
+    }
+
+    std::filesystem::path wal_replicate_t::index_path_(std::size_t number) const {
+        return segment_path_(number).replace_extension(index_extension);
+    }
+
+    // an entry is kept only if it points to a record passing its crc32: the entry of a record is written
+    // before the record, so a crash can leave one pointing past the end of the segment
+    wal_replicate_t::sparse_index_t wal_replicate_t::read_index_(std::size_t number) const {
+        sparse_index_t index;
+        core::file::mapped_file_t map(segment_path_(number));
+        core::file::file_t index_file(index_path_(number));
+        auto data = index_file.readall();
+        index.resize(data.size() / sizeof(index_entry_t));
+        std::memcpy(index.data(), data.data(), index.size() * sizeof(index_entry_t));
+        auto size = index.size();
+        while (!index.empty()) {
+            auto record = read_record(map, index.back().offset);
+            if (is_complete(record) && record.id == index.back().id) {
+                break;
+            }
+            index.pop_back();
+        }
+        if (index.size() != size) {
+            index_file.clear();
+            index_file.append(index.data(), index.size() * sizeof(index_entry_t));
+        }
+        if (index.empty()) {
+            std::size_t start_index = wal_header_size;
+            std::size_t count = 0;
+            for (auto record = read_record(map, start_index); is_complete(record); record = read_record(map, start_index)) {
+                if (count++ % config_.index_interval == 0) {
+                    index.push_back({record.id, start_index});
+                }
+                start_index = next_index(start_index, record.size);
+            }
+            index_file.append(index.data(), index.size() * sizeof(index_entry_t));
+        }
+        return index;
+    }
+
+    void wal_replicate_t::append_index_(services::wal::id_t id, std::uint64_t offset) {
+        if (index_file_ && (id - segments_.back().first_id) % config_.index_interval == 0) {
+            index_.push_back({id, offset});
+            index_file_->append(&index_.back(), sizeof(index_entry_t));
+        }
+    }
+
+    void wal_replicate_t::open_segments_() {
+        manifest_ = std::make_unique<core::file::file_t>(config_.path / manifest_name);
+        std::istringstream manifest(manifest_->readall());
+        segment_t segment{0, 0};
+        while (manifest >> segment.number >> segment.first_id) {
+            segments_.push_back(segment);
+        }
+        if (segments_.empty()) {
+            segments_.push_back({1, 1});
+            auto old_wal = config_.path / wal_name;
+            if (file_exist_(old_wal)) {
+                std::filesystem::rename(old_wal, segment_path_(segments_.back().number));
+                upgrade_segment_(segments_.back().number);
+                core::file::file_t file(segment_path_(segments_.back().number));
+                auto first_id = read_id(file, wal_header_size);
+                if (first_id > 0) {
+                    segments_.back().first_id = first_id;
+                }
+            }
+            write_manifest_();
+        }
+        for (const auto& segment : segments_) {
+            upgrade_segment_(segment.number);
+        }
+        file_ = std::make_unique<core::file::file_t>(segment_path_(segments_.back().number));
+        file_->seek_eof();
+        if (file_->offset() == 0) {
+            buffer_t header;
+            append_header(header);
+            file_->append(header.data(), header.size());
+        }
+        index_ = read_index_(segments_.back().number);
+        index_file_ = std::make_unique<core::file::file_t>(index_path_(segments_.back().number));
+        index_file_->seek_eof();
+    }
+
+    void wal_replicate_t::upgrade_segment_(std::size_t number) {
+        auto path = segment_path_(number);
+        core::file::file_t file(path);
+        buffer_t header;
+        file.read(header, wal_header_size, 0);
+        version_t version;
+        if (read_header(header, version)) {
+            if (version != wal_format_version) {
+                error(log_, "wal_replicate_t: unsupported format version {} of {}", version, path.string());
+            }
+            return;
+        }
+        auto legacy = file.readall();
+        if (legacy.empty()) {
+            return;
+        }
+        trace(log_, "wal_replicate_t::upgrade_segment, segment: {}", number);
+        auto output = upgrade_legacy_format(legacy);
+        auto tmp_path = path;
+        tmp_path += ".tmp";
+        {
+            core::file::file_t tmp(tmp_path);
+            tmp.clear();
+            tmp.append(output.data(), output.size());
+            if (!tmp.sync()) {
+                error(log_, "wal_replicate_t::upgrade_segment, sync of {} failed: {}, the legacy segment is kept", tmp_path.string(), std::strerror(errno));
+                std::filesystem::remove(tmp_path);
+                return;
+            }
+        }
+        std::filesystem::rename(tmp_path, path);
+        std::filesystem::remove(index_path_(number));
+    }
+
+    void wal_replicate_t::write_manifest_() const {
+        std::string manifest;
+        for (const auto& segment : segments_) {
+            manifest.append(std::to_string(segment.number)).append(" ").append(std::to_string(segment.first_id)).append("\n");
+        }
+        manifest_->rewrite(manifest);
+    }
+
+    void wal_replicate_t::rotate_segment_() {
+        if (!file_ || std::size_t(file_->offset()) < config_.max_segment_size) {
+            return;
+        }
+        segments_.push_back({segments_.back().number + 1, services::wal::id_t(id_) + 1});
+        trace(log_, "wal_replicate_t::rotate_segment, segment: {}, first id: {}", segments_.back().number, segments_.back().first_id);
+        if (!file_->sync()) {
+            sync_failed_ = true;
+            error(log_, "wal_replicate_t::rotate_segment, sync of segment {} failed: {}", segments_.back().number - 1, std::strerror(errno));
+        }
+        file_ = std::make_unique<core::file::file_t>(segment_path_(segments_.back().number));
+        buffer_t header;
+        append_header(header);
+        file_->append(header.data(), header.size());
+        index_file_ = std::make_unique<core::file::file_t>(index_path_(segments_.back().number));
+        index_.clear();
+        write_manifest_();
+    }
+
+    void wal_replicate_t::truncate(services::wal::id_t wal_id) {
+        // a segment is obsolete when every id in it (i.e. below the next segment's first id) is on disk
+        std::size_t count = 0;
+        while (count + 1 < segments_.size() && segments_[count + 1].first_id <= wal_id + 1) {
+            ++count;
+        }
+        if (count == 0) {
+            return;
+        }
+        trace(log_, "wal_replicate_t::truncate, id: {}, segments: {}", wal_id, count);
+        if (config_.archive_segments) {
+            std::filesystem::create_directories(config_.path / archive_name);
+        }
+        for (std::size_t i = 0; i < count; ++i) {
+            for (const auto& path : {segment_path_(segments_[i].number), index_path_(segments_[i].number)}) {
+                if (config_.archive_segments) {
+                    std::filesystem::rename(path, config_.path / archive_name / path.filename());
+                } else {
+                    std::filesystem::remove(path);
+                }
+            }
+        }
+        segments_.erase(segments_.begin(), segments_.begin() + std::ptrdiff_t(count));
+        write_manifest_();
+    }
+
     void wal_replicate_t::send_success(session_id_t& session, address_t& sender) {
+        if (config_.group_commit) {
+            if (pending_commits_.empty()) {
+                commit_start_ = commit_clock_t::now();
+                commit_queued_size_ = 1;
+                actor_zeta::send(address(), address(), handler_id(route::commit));
+            }
+            pending_commits_.push_back({session, sender, services::wal::id_t(id_)});
+            if (commit_buffer_.size() >= config_.group_commit_max_bytes) {
+                commit_();
+            }
+            return;
+        }
         if (sender) {
             actor_zeta::send(sender, address(), handler_id(route::success), session, services::wal::id_t(id_));
         }
     }
 
-    void wal_replicate_t::write_buffer(buffer_t& buffer) {
-        file_->append(buffer.data(), buffer.size());
+    void wal_replicate_t::commit() {
+        if (pending_commits_.empty()) {
+            return;
+        }
+        // requeue behind the messages that arrived meanwhile, so they join this commit;
+        // when none did the mailbox has drained and waiting out the window would only spin
+        if (pending_commits_.size() > commit_queued_size_ &&
+            commit_clock_t::now() - commit_start_ < config_.group_commit_window) {
+            commit_queued_size_ = pending_commits_.size();
+            actor_zeta::send(address(), address(), handler_id(route::commit));
+            return;
+        }
+        commit_();
     }
 
-    void wal_replicate_t::read_buffer(buffer_t& buffer, size_t start_index, size_t size) const {
-        file_->read(buffer, size, off64_t(start_index));
+    void wal_replicate_t::commit_() {
+        trace(log_, "wal_replicate_t::commit, records: {}, bytes: {}", pending_commits_.size(), commit_buffer_.size());
+        write_buffer(commit_buffer_);
+        commit_buffer_.clear();
+        if (file_ && !sync_failed_ && !file_->sync()) {
+            sync_failed_ = true;
+            error(log_, "wal_replicate_t::commit, sync failed: {}", std::strerror(errno));
+        }
+        if (sync_failed_) {
+            // the records are not durable: they are never acknowledged, so the disk flush and checkpoint do not claim them
+            error(log_, "wal_replicate_t::commit, {} records are not acknowledged", pending_commits_.size());
+            pending_commits_.clear();
+            return;
+        }
+        rotate_segment_();
+        acknowledge_pending_();
     }
 
-    wal_replicate_t::~wal_replicate_t() {
-        trace(log_, "delete wal_replicate_t");
+    void wal_replicate_t::acknowledge_pending_() {
+        for (auto& pending : pending_commits_) {
+            if (pending.sender) {
+                actor_zeta::send(pending.sender, address(), handler_id(route::success), pending.session, pending.id);
+            }
+        }
+        pending_commits_.clear();
     }
 
-    size_tt read_size_impl(buffer_t& input, int index_start) {
-        size_tt size_tmp = 0;
-        size_tmp = size_tt(0xff00 & input[size_t(index_start)] << 8);
-        size_tmp |= size_tt(0x00ff & input[size_t(index_start) + 1]);
-        return size_tmp;
+    void wal_replicate_t::write_buffer(buffer_t& buffer) {
+        file_->append(buffer.data(), buffer.size());
     }
 
-    static size_tt read_size_impl(const char* input, int index_start) {
-        size_tt size_tmp = 0;
-        size_tmp = size_tt(0xff00 & (input[index_start] << 8));
-        size_tmp |= size_tt(0x00ff & (input[index_start + 1]));
-        return size_tmp;
+    void wal_replicate_t::read_buffer(const core::file::file_t& file, buffer_t& buffer, size_t start_index, size_t size) const {
+        file.read(buffer, size, off64_t(start_index));
     }
 
-    size_tt wal_replicate_t::read_size(size_t start_index) const {
-        auto size_read = sizeof(size_tt);
+    wal_replicate_t::~wal_replicate_t() {
+        trace(log_, "delete wal_replicate_t");
+        // the records of an open group are made durable and acknowledged, not dropped with the actor
+        if (file_ && !commit_buffer_.empty()) {
+            file_->append(commit_buffer_.data(), commit_buffer_.size());
+            if (!sync_failed_ && !file_->sync()) {
+                sync_failed_ = true;
+                error(log_, "delete wal_replicate_t, sync failed: {}", std::strerror(errno));
+            }
+        }
+        commit_buffer_.clear();
+        if (sync_failed_) {
+            pending_commits_.clear();
+            return;
+        }
+        acknowledge_pending_();
+    }
+
+    size_tt wal_replicate_t::read_size(const core::file::file_t& file, size_t start_index) const {
+        auto size_read = document::max_varint_len32;
         buffer_t buffer;
-        read_buffer(buffer, start_index, size_read);
-        auto size_blob = read_size_impl(buffer.data(), 0);
+        read_buffer(file, buffer, start_index, size_read);
+        auto size_blob = read_size_impl(buffer, 0);
         return size_blob;
     }
 
-    buffer_t wal_replicate_t::read(size_t start_index, size_t finish_index) const {
+    buffer_t wal_replicate_t::read(const core::file::file_t& file, size_t start_index, size_t finish_index) const {
         auto size_read = finish_index - start_index;
         buffer_t buffer;
-        read_buffer(buffer, start_index, size_read);
+        read_buffer(file, buffer, start_index, size_read);
         return buffer;
     }
 
     void wal_replicate_t::load(session_id_t& session, address_t& sender, services::wal::id_t wal_id) {
         trace(log_, "wal_replicate_t::load, id: {}", wal_id);
-        std::size_t start_index = 0;
+        start_replay_(session, sender, wal_id);
+        send_replay_chunk_();
+    }
+
+    void wal_replicate_t::load_next(session_id_t& session) {
+        trace(log_, "wal_replicate_t::load_next, session: {}", session.data());
+        if (replay_) {
+            send_replay_chunk_();
+        }
+    }
+
+    void wal_replicate_t::start_replay_(session_id_t& session, address_t& sender, services::wal::id_t wal_id) {
         next_id(wal_id);
+        replay_ = std::make_unique<replay_t>(replay_t{session, sender, 0, 0, nullptr});
+        auto it = std::find_if(segments_.rbegin(), segments_.rend(), [wal_id](const segment_t& segment) {
+            return segment.first_id <= wal_id;
+        });
+        auto first = it == segments_.rend() ? segments_.begin() : it.base() - 1;
+        if (first != segments_.end()) {
+            core::file::file_t file(segment_path_(first->number));
+            std::size_t start_index = 0;
+            if (find_start_record(file, read_index_(first->number), wal_id, start_index)) {
+                open_replay_segment_(first->number, start_index);
+            }
+        }
+    }
+
+    void wal_replicate_t::open_replay_segment_(std::size_t number, std::size_t offset) {
+        replay_->number = number;
+        replay_->offset = offset;
+        replay_->map = std::make_unique<core::file::mapped_file_t>(segment_path_(number));
+    }
+
+    std::vector<record_t> wal_replicate_t::read_replay_chunk_() {
         std::vector<record_t> records;
-        if (find_start_record(wal_id, start_index)) {
-            std::size_t size = 0;
-            do {
-                records.emplace_back(read_record(start_index));
-                start_index = next_index(start_index, records[size].size);
-            } while (records[size++].is_valid());
-            records.erase(records.end() - 1);
+        std::size_t size = 0;
+        while (replay_->map && size < config_.replay_chunk_bytes) {
+            auto record = read_record(*replay_->map, replay_->offset);
+            if (is_complete(record)) {
+                replay_->offset = next_index(replay_->offset, record.size);
+                size += record.size;
+                records.emplace_back(std::move(record));
+                continue;
+            }
+            if (replay_->offset < replay_->map->size()) {
+                // a torn write at the very end of the last segment ends the log; anywhere else
+                // the records after it cannot be applied without the ones lost
+                auto is_last_segment = replay_->number == segments_.back().number;
+                if (is_last_segment && is_torn_tail(*replay_->map, replay_->offset)) {
+                    warn(log_, "wal_replicate_t::load, torn record at the end of segment {} at {}", replay_->number, replay_->offset);
+                } else {
+                    error(log_, "wal_replicate_t::load, corrupt record in segment {} at {}, replay stopped", replay_->number, replay_->offset);
+                    replay_->corrupt = true;
+                }
+                replay_->map.reset();
+                break;
+            }
+            // segments may have been truncated meanwhile, so look up the successor by number
+            auto number = replay_->number;
+            auto next = std::find_if(segments_.begin(), segments_.end(), [number](const segment_t& segment) {
+                return segment.number > number;
+            });
+            if (next != segments_.end()) {
+                open_replay_segment_(next->number, wal_header_size);
+            } else {
+                replay_->map.reset();
+            }
+        }
+        if (replay_->map) {
+            replay_->map->release(replay_->offset);
+        }
+        return records;
+    }
+
+    void wal_replicate_t::send_replay_chunk_() {
+        auto records = read_replay_chunk_();
+        trace(log_, "wal_replicate_t::load, segment: {}, records: {}", replay_->number, records.size());
+        auto finished = records.empty();
+        if (replay_->corrupt) {
+            // the records before the corrupt one are applied, the caller learns the log is not whole
+            if (!finished) {
+                actor_zeta::send(replay_->sender, address(), handler_id(route::load_finish), replay_->session, std::move(records));
+            }
+            actor_zeta::send(replay_->sender, address(), handler_id(route::load_failed), replay_->session);
+            replay_.reset();
+            return;
+        }
+        actor_zeta::send(replay_->sender, address(), handler_id(route::load_finish), replay_->session, std::move(records));
+        if (finished) {
+            replay_.reset();
         }
-        actor_zeta::send(sender, address(), handler_id(route::load_finish), session, std::move(records));
     }
 
     void wal_replicate_t::create_database(session_id_t& session, address_t& sender, components::ql::create_database_t& data) {
@@ -181,98 +537,158 @@ namespace services::wal {
     template<class T>
     void wal_replicate_t::write_data_(T &data) {
         next_id(id_);
+        if (config_.group_commit) {
+            if (file_) {
+                append_index_(id_, std::uint64_t(file_->offset()) + commit_buffer_.size());
+            }
+            last_crc32_ = pack(commit_buffer_, last_crc32_, id_, data);
+            return;
+        }
+        if (file_) {
+            append_index_(id_, std::uint64_t(file_->offset()));
+        }
         buffer_t buffer;
         last_crc32_ = pack(buffer, last_crc32_, id_, data);
         write_buffer(buffer);
+        rotate_segment_();
     }
 
+    // the last segment ends with its last record passing its crc32, whatever follows is cut off before
+    // anything is appended: records written behind it would never be replayed
     void wal_replicate_t::init_id() {
-        std::size_t start_index = 0;
-        auto id = read_id(start_index);
-        while (id > 0) {
-            id_ = id;
-            start_index = next_index(start_index, read_size(start_index));
-            id = read_id(start_index);
+        id_ = segments_.back().first_id - 1;
+        auto path = segment_path_(segments_.back().number);
+        core::file::mapped_file_t map(path);
+        std::size_t offset = index_.empty() ? wal_header_size : index_.back().offset;
+        for (auto record = read_record(map, offset); is_complete(record); record = read_record(map, offset)) {
+            id_ = record.id;
+            last_crc32_ = record.crc32;
+            offset = next_index(offset, record.size);
+        }
+        if (offset < map.size()) {
+            if (is_torn_tail(map, offset)) {
+                warn(log_, "wal_replicate_t: torn record at the end of segment {} at {} cut off", segments_.back().number, offset);
+            } else {
+                auto copy = path;
+                copy += ".corrupt";
+                error(log_, "wal_replicate_t: corrupt record in segment {} at {}, the rest is cut off and kept in {}",
+                      segments_.back().number, offset, copy.string());
+                std::filesystem::copy_file(path, copy, std::filesystem::copy_options::overwrite_existing);
+            }
+            file_->truncate(__off64_t(offset));
+            if (!file_->sync()) {
+                error(log_, "wal_replicate_t: sync after cutting segment {} at {} failed: {}", segments_.back().number, offset, std::strerror(errno));
+            }
         }
     }
 
-    bool wal_replicate_t::find_start_record(services::wal::id_t wal_id, std::size_t &start_index) const {
-        start_index = 0;
-        auto first_id = read_id(start_index);
+    bool wal_replicate_t::find_start_record(const core::file::file_t& file, const sparse_index_t& index, services::wal::id_t wal_id, std::size_t &start_index) const {
+        start_index = wal_header_size;
+        auto it = std::upper_bound(index.begin(), index.end(), wal_id, [](services::wal::id_t id, const index_entry_t& entry) {
+            return id < entry.id;
+        });
+        if (it != index.begin()) {
+            start_index = std::prev(it)->offset;
+        }
+        auto first_id = read_id(file, start_index);
         if (first_id > 0) {
             for (auto n = first_id; n < wal_id; ++n) {
-                auto size = read_size(start_index);
+                auto size = read_size(file, start_index);
                 if (size > 0) {
                     start_index = next_index(start_index, size);
                 } else {
                     return false;
                 }
             }
-            return wal_id == read_id(start_index);
+            return wal_id == read_id(file, start_index);
         }
         return false;
     }
 
-    services::wal::id_t wal_replicate_t::read_id(std::size_t start_index) const {
-        auto size = read_size(start_index);
+    services::wal::id_t wal_replicate_t::read_id(const core::file::file_t& file, std::size_t start_index) const {
+        auto size = read_size(file, start_index);
         if (size > 0) {
-            auto start = start_index + sizeof(size_tt);
+            auto start = start_index + size_length(size);
             auto finish = start + size;
-            auto output = read(start, finish);
+            auto output = read(file, start, finish);
             return unpack_wal_id(output);
         }
         return 0;
     }
 
-    record_t wal_replicate_t::read_record(std::size_t start_index) const {
+    record_t wal_replicate_t::read_record(const core::file::file_t& file, std::size_t start_index) const {
         record_t record;
-        record.size = read_size(start_index);
+        record.size = read_size(file, start_index);
         if (record.size > 0) {
-            auto start = start_index + sizeof(size_tt);
+            auto start = start_index + size_length(record.size);
             auto finish = start + record.size + sizeof(crc32_t);
-            auto output = read(start, finish);
-            record.crc32 = read_crc32(output, record.size);
-            if (record.crc32 == crc32c::Crc32c(output.data(), record.size)) {
-                msgpack::unpacked msg;
-                msgpack::unpack(msg, output.data(), record.size);
-                const auto& o = msg.get();
-                record.last_crc32 = o.via.array.ptr[0].as<crc32_t>();
-                record.id = o.via.array.ptr[1].as<services::wal::id_t>();
-                record.type = static_cast<components::ql::statement_type>(o.via.array.ptr[2].as<char>());
-                record.set_data(o.via.array.ptr[3]);
-            } else {
-                record.type = components::ql::statement_type::unused;
-                //todo: error wal content
-            }
+            auto output = read(file, start, finish);
+            unpack_record(output.data(), record);
         } else {
             record.type = components::ql::statement_type::unused;
         }
         return record;
     }
 
+    record_t wal_replicate_t::read_record(const core::file::mapped_file_t& map, std::size_t start_index) const {
+        record_t record;
+        record.size = 0;
+        record.type = components::ql::statement_type::unused;
+        if (start_index < map.size()) {
+            size_tt size = 0;
+            std::string_view tail(map.data() + start_index, map.size() - start_index);
+            if (document::get_uvar_int32(tail, &size) > 0 && size > 0 && next_index(start_index, size) <= map.size()) {
+                record.size = size;
+                unpack_record(map.data() + start_index + size_length(size), record);
+            }
+        }
+        return record;
+    }
+
 #ifdef DEV_MODE
     bool wal_replicate_t::test_find_start_record(services::wal::id_t wal_id, std::size_t &start_index) const {
-        return find_start_record(wal_id, start_index);
+        return find_start_record(*file_, index_, wal_id, start_index);
     }
 
     services::wal::id_t wal_replicate_t::test_read_id(std::size_t start_index) const {
-        return read_id(start_index);
+        return read_id(*file_, start_index);
     }
 
     std::size_t wal_replicate_t::test_next_record(std::size_t start_index) const {
-        return next_index(start_index, read_size(start_index));
+        return next_index(start_index, read_size(*file_, start_index));
     }
 
     record_t wal_replicate_t::test_read_record(std::size_t start_index) const {
-        return read_record(start_index);
+        return read_record(*file_, start_index);
     }
 
     size_tt wal_replicate_t::test_read_size(size_t start_index) const {
-        return read_size(start_index);
+        return read_size(*file_, start_index);
     }
 
     buffer_t wal_replicate_t::test_read(size_t start_index, size_t finish_index) const {
-        return read(start_index, finish_index);
+        return read(*file_, start_index, finish_index);
+    }
+
+    std::size_t wal_replicate_t::test_count_segments() const {
+        return segments_.size();
+    }
+
+    std::vector<std::vector<record_t>> wal_replicate_t::test_replay(services::wal::id_t wal_id, bool* corrupt) {
+        std::vector<std::vector<record_t>> chunks;
+        session_id_t session;
+        auto sender = actor_zeta::address_t::empty_address();
+        start_replay_(session, sender, wal_id);
+        auto records = read_replay_chunk_();
+        while (!records.empty()) {
+            chunks.emplace_back(std::move(records));
+            records = read_replay_chunk_();
+        }
+        if (corrupt) {
+            *corrupt = replay_->corrupt;
+        }
+        replay_.reset();
+        return chunks;
     }
 #endif
 
@@ -290,7 +706,7 @@ namespace services::wal {
     void wal_replicate_without_disk_t::write_buffer(buffer_t&) {
     }
 
-    void wal_replicate_without_disk_t::read_buffer(buffer_t& buffer, size_t, size_t size) const {
+    void wal_replicate_without_disk_t::read_buffer(const core::file::file_t&, buffer_t& buffer, size_t, size_t size) const {
         buffer.resize(size);
         std::fill(buffer.begin(), buffer.end(), '\0');
     }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <chrono>
+
 #include <actor-zeta.hpp>
 
 #include <boost/filesystem.hpp>
@@ -25,6 +27,7 @@ namespace services::wal {
     public:
         wal_replicate_t(base_manager_wal_replicate_t* manager, log_t& log, configuration::config_wal config);
         virtual void load(session_id_t& session, address_t& sender, services::wal::id_t wal_id);
+        void load_next(session_id_t& session);
         void create_database(session_id_t& session, address_t& sender, components::ql::create_database_t& data);
         void drop_database(session_id_t& session, address_t& sender, components::ql::drop_database_t& data);
         void create_collection(session_id_t& session, address_t& sender, components::ql::create_collection_t& data);
@@ -36,29 +39,89 @@ namespace services::wal {
         void update_one(session_id_t& session, address_t& sender, components::ql::update_one_t& data);
         void update_many(session_id_t& session, address_t& sender, components::ql::update_many_t& data);
         void create_index(session_id_t& session, address_t& sender, components::ql::create_index_t& data);
+        void commit();
+        void truncate(services::wal::id_t wal_id);
         ~wal_replicate_t() override;
 
     private:
+        using commit_clock_t = std::chrono::steady_clock;
+
+        struct pending_commit_t {
+            session_id_t session;
+            address_t sender;
+            services::wal::id_t id;
+        };
+
+        struct segment_t {
+            std::size_t number;
+            services::wal::id_t first_id;
+        };
+
+        struct index_entry_t {
+            services::wal::id_t id;
+            std::uint64_t offset;
+        };
+
+        using sparse_index_t = std::vector<index_entry_t>;
+
+        struct replay_t {
+            session_id_t session;
+            address_t sender;
+            std::size_t number;
+            std::size_t offset;
+            std::unique_ptr<core::file::mapped_file_t> map;
+            bool corrupt{false};
+        };
+
         void send_success(session_id_t& session, address_t& sender);
+        void commit_();
+        void acknowledge_pending_();
 
         virtual void write_buffer(buffer_t& buffer);
-        virtual void read_buffer(buffer_t& buffer, size_t start_index, size_t size) const;
+        virtual void read_buffer(const core::file::file_t& file, buffer_t& buffer, size_t start_index, size_t size) const;
 
         template <class T>
         void write_data_(T &data);
 
+        void open_segments_();
+        void upgrade_segment_(std::size_t number);
+        void rotate_segment_();
+        void write_manifest_() const;
+        std::filesystem::path segment_path_(std::size_t number) const;
+        std::filesystem::path index_path_(std::size_t number) const;
+        sparse_index_t read_index_(std::size_t number) const;
+        void append_index_(services::wal::id_t id, std::uint64_t offset);
+
+        void start_replay_(session_id_t& session, address_t& sender, services::wal::id_t wal_id);
+        void open_replay_segment_(std::size_t number, std::size_t offset);
+        std::vector<record_t> read_replay_chunk_();
+        void send_replay_chunk_();
+
         void init_id();
-        bool find_start_record(services::wal::id_t wal_id, std::size_t &start_index) const;
-        services::wal::id_t read_id(std::size_t start_index) const;
-        record_t read_record(std::size_t start_index) const;
-        size_tt read_size(size_t start_index) const;
-        buffer_t read(size_t start_index, size_t finish_index) const;
+        bool find_start_record(const core::file::file_t& file, const sparse_index_t& index, services::wal::id_t wal_id, std::size_t &start_index) const;
+        services::wal::id_t read_id(const core::file::file_t& file, std::size_t start_index) const;
+        record_t read_record(const core::file::file_t& file, std::size_t start_index) const;
+        record_t read_record(const core::file::mapped_file_t& map, std::size_t start_index) const;
+        size_tt read_size(const core::file::file_t& file, size_t start_index) const;
+        buffer_t read(const core::file::file_t& file, size_t start_index, size_t finish_index) const;
 
         log_t log_;
         configuration::config_wal config_;
         atomic_id_t id_{0};
         crc32_t last_crc32_{0};
         file_ptr file_;
+        file_ptr manifest_;
+        file_ptr index_file_;
+        std::vector<segment_t> segments_;
+        sparse_index_t index_;
+        buffer_t commit_buffer_;
+        std::vector<pending_commit_t> pending_commits_;
+        // size of the group when its commit message was last queued
+        std::size_t commit_queued_size_{0};
+        commit_clock_t::time_point commit_start_;
+        // set once fdatasync fails, the page cache may have dropped records that a later sync would not report
+        bool sync_failed_{false};
+        std::unique_ptr<replay_t> replay_;
 
 #ifdef DEV_MODE
     public:
@@ -68,6 +131,8 @@ namespace services::wal {
         record_t test_read_record(std::size_t start_index) const;
         size_tt test_read_size(size_t start_index) const;
         buffer_t test_read(size_t start_index, size_t finish_index) const;
+        std::size_t test_count_segments() const;
+        std::vector<std::vector<record_t>> test_replay(services::wal::id_t wal_id, bool* corrupt = nullptr);
 #endif
     };
 
@@ -81,7 +146,7 @@ namespace services::wal {
         void load(session_id_t& session, address_t& sender, services::wal::id_t wal_id) final;
     private:
         void write_buffer(buffer_t&) final;
-        void read_buffer(buffer_t& buffer, size_t start_index, size_t size) const final;
+        void read_buffer(const core::file::file_t& file, buffer_t& buffer, size_t start_index, size_t size) const final;
     };
 
 